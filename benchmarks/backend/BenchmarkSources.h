@@ -0,0 +1,60 @@
+#ifndef BENCHMARK_SOURCES_H
+#define BENCHMARK_SOURCES_H
+
+#include <cstddef>
+#include <string>
+
+namespace ArgonLang::Benchmarks {
+// Synthetic Argon program of roughly target_bytes: a repeated function mixing comments, indentation,
+// identifiers, keywords, number and string literals (with and without escapes) and control flow.
+inline std::string generate_source(std::size_t target_bytes) {
+	std::string source;
+	source.reserve(target_bytes + 1024);
+	for (std::size_t index = 0; source.size() < target_bytes; ++index) {
+		std::string name = "checksum_" + std::to_string(index);
+		source += "// Accumulates a checksum over a range of values\n"
+		          "func " + name + "(limit: i32, seed: i32) i32 {\n"
+		          "\t/* Running state for the\n"
+		          "\t   accumulation loop */\n"
+		          "\tdef total: i32 = seed;\n"
+		          "\tdef index: i32 = 0;\n"
+		          "\twhile (index < limit) {\n"
+		          "\t\tif (index % 3 == 0) {\n"
+		          "\t\t\ttotal = total + index * 7;\n"
+		          "\t\t} else {\n"
+		          "\t\t\ttotal = total - index;\n"
+		          "\t\t}\n"
+		          "\t\tindex = index + 1;\n"
+		          "\t}\n"
+		          "\tdef message = \"checksum computed for the current range of values\";\n"
+		          "\tdef escaped = \"line one\\nline two\\t\\\"quoted\\\"\";\n"
+		          "\tdef letter = 'x';\n"
+		          "\treturn total;\n"
+		          "}\n\n";
+	}
+	source += "func main() {\n\tdef result = checksum_0(100, 7);\n}\n";
+	return source;
+}
+
+// Synthetic Argon program of roughly target_bytes made of long operator chains across every precedence level,
+// so that parsing time is dominated by expressions rather than declarations.
+inline std::string generate_expression_source(std::size_t target_bytes) {
+	std::string source;
+	source.reserve(target_bytes + 1024);
+	for (std::size_t index = 0; source.size() < target_bytes; ++index) {
+		std::string name = "mix_" + std::to_string(index);
+		source += "func " + name + "(a: i32, b: i32, c: i32) i32 {\n"
+		          "\tdef x: i32 = a + b * c - a % b + (c - a) * (b + 1) / 2;\n"
+		          "\tdef y: bool = a < b || b <= c && a == c || !(a != b) && -a > b - c;\n"
+		          "\tdef z: i32 = a *| b *& c *^ a *< 1 *> 2 + x;\n"
+		          "\tdef w: i32 = y ?? x * 2 + a : z - b * c;\n"
+		          "\tx += w * z - (a + b) * (c - a);\n"
+		          "\treturn x + y + z + w;\n"
+		          "}\n\n";
+	}
+	source += "func main() {\n\tdef result = mix_0(1, 2, 3);\n}\n";
+	return source;
+}
+} // namespace ArgonLang::Benchmarks
+
+#endif // BENCHMARK_SOURCES_H
@@ -0,0 +1,79 @@
+#include <benchmark/benchmark.h>
+#include "backend/Parser.h"
+#include "backend/TokenStream.h"
+#include "backend/Tokenizer.h"
+
+#include "BenchmarkSources.h"
+
+#include <string>
+
+using namespace ArgonLang;
+
+namespace {
+const std::string& source() {
+	static const std::string text = Benchmarks::generate_source(1 << 20);
+	return text;
+}
+
+// Reports bytes/s of the timed loop; allocation counts come from the driver's --stats, since the benchmarks keep
+// the default allocator
+template<typename Body>
+void run_parse(benchmark::State& state, Body&& body) {
+	for (auto _ : state) {
+		body();
+	}
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(source().size()));
+}
+} // namespace
+
+// Parsing alone, over a 1 MiB program tokenized up front
+static void BM_ParseTokens(benchmark::State& state) {
+	auto tokenizeResult = tokenize(source());
+	run_parse(state, [&] {
+		Parser parser(tokenizeResult.tokens);
+		auto program = parser.parse();
+		benchmark::DoNotOptimize(program);
+	});
+}
+BENCHMARK(BM_ParseTokens)->Unit(benchmark::kMillisecond);
+
+// Tokenizing and parsing in lockstep, as the compiler driver does
+static void BM_ParseStreaming(benchmark::State& state) {
+	run_parse(state, [&] {
+		TokenStream tokens(source());
+		Parser parser(tokens);
+		auto program = parser.parse();
+		benchmark::DoNotOptimize(program);
+	});
+}
+BENCHMARK(BM_ParseStreaming)->Unit(benchmark::kMillisecond);
+
+// Parsing a program dominated by operator expressions, where every operand used to walk the whole precedence chain
+static void BM_ParseExpressions(benchmark::State& state) {
+	static const std::string text = Benchmarks::generate_expression_source(1 << 20);
+	auto tokenizeResult = tokenize(text);
+	for (auto _ : state) {
+		Parser parser(tokenizeResult.tokens);
+		auto program = parser.parse();
+		benchmark::DoNotOptimize(program);
+	}
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(text.size()));
+}
+BENCHMARK(BM_ParseExpressions)->Unit(benchmark::kMillisecond);
+
+// One expression nested state.range(0) parentheses deep; lambda detection must not rescan the nested tokens
+static void BM_ParseNestedParentheses(benchmark::State& state) {
+	std::string expression = "1";
+	for (int64_t depth = 0; depth < state.range(0); ++depth) {
+		expression = "(" + expression + " + a)";
+	}
+	std::string text = "func main() {\n\tdef x = " + expression + ";\n}\n";
+	auto tokenizeResult = tokenize(text);
+	for (auto _ : state) {
+		Parser parser(tokenizeResult.tokens);
+		auto program = parser.parse();
+		benchmark::DoNotOptimize(program);
+	}
+	state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_ParseNestedParentheses)->RangeMultiplier(4)->Range(16, 256)->Complexity();
@@ -0,0 +1,119 @@
+#include <benchmark/benchmark.h>
+#include "backend/Scanner.h"
+#include "backend/Tokenizer.h"
+
+#include "BenchmarkSources.h"
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+using namespace ArgonLang;
+
+namespace {
+const std::string& source() {
+	static const std::string text = Benchmarks::generate_source(1 << 20);
+	return text;
+}
+
+// Runs tokenize() over a 1 MiB program with the given scanner kernels; bytes/s is the throughput
+void tokenize_with(benchmark::State& state, Scanner::InstructionSet set) {
+	if (static_cast<int>(set) > static_cast<int>(Scanner::best_instruction_set())) {
+		state.SkipWithError("instruction set not supported by this CPU");
+		return;
+	}
+	Scanner::set_instruction_set(set);
+	for (auto _ : state) {
+		auto result = tokenize(source());
+		benchmark::DoNotOptimize(result.tokens.data());
+	}
+	Scanner::set_instruction_set(Scanner::best_instruction_set());
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(source().size()));
+}
+} // namespace
+
+static void BM_TokenizeScalar(benchmark::State& state) {
+	tokenize_with(state, Scanner::InstructionSet::Scalar);
+}
+BENCHMARK(BM_TokenizeScalar);
+
+static void BM_TokenizeSSE2(benchmark::State& state) {
+	tokenize_with(state, Scanner::InstructionSet::SSE2);
+}
+BENCHMARK(BM_TokenizeSSE2);
+
+static void BM_TokenizeAVX2(benchmark::State& state) {
+	tokenize_with(state, Scanner::InstructionSet::AVX2);
+}
+BENCHMARK(BM_TokenizeAVX2);
+
+// Raw kernel throughput on a single long run: the identifier scan over 1 MiB of identifier characters
+static void BM_ScanIdentifier(benchmark::State& state) {
+	auto set = static_cast<Scanner::InstructionSet>(state.range(0));
+	if (static_cast<int>(set) > static_cast<int>(Scanner::best_instruction_set())) {
+		state.SkipWithError("instruction set not supported by this CPU");
+		return;
+	}
+	std::string text(1 << 20, 'a');
+	text.back() = ' ';
+	Scanner::set_instruction_set(set);
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(Scanner::find_identifier_end(text, 0));
+	}
+	Scanner::set_instruction_set(Scanner::best_instruction_set());
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(text.size()));
+}
+BENCHMARK(BM_ScanIdentifier)->Arg(0)->Arg(1)->Arg(2);
+
+namespace {
+// Spellings the keyword lookup sees in a keyword-dense source: keywords, primitive types and near misses
+const std::vector<std::string_view>& keyword_dense_words() {
+	static const std::vector<std::string_view> words = {
+	    "def", "func", "i32", "return", "while", "if", "else", "struct", "pub", "u64", "total", "index",
+	    "constructor", "impl", "str", "match", "value", "par", "f64", "for", "to", "where", "counter", "bool"};
+	return words;
+}
+} // namespace
+
+static void BM_KeywordLookupPerfectHash(benchmark::State& state) {
+	for (auto _ : state) {
+		for (std::string_view word : keyword_dense_words()) {
+			benchmark::DoNotOptimize(keyword_type(word));
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(keyword_dense_words().size()));
+}
+BENCHMARK(BM_KeywordLookupPerfectHash);
+
+// The hash map the tokenizer used before the perfect hash, for comparison
+static void BM_KeywordLookupHashMap(benchmark::State& state) {
+	std::unordered_map<std::string_view, Token::Type> keywords;
+	for (std::string_view word : keyword_dense_words()) {
+		if (keyword_type(word) != Token::Identifier) {
+			keywords.emplace(word, keyword_type(word));
+		}
+	}
+	for (auto _ : state) {
+		for (std::string_view word : keyword_dense_words()) {
+			auto it = keywords.find(word);
+			benchmark::DoNotOptimize(it == keywords.end() ? Token::Identifier : it->second);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(keyword_dense_words().size()));
+}
+BENCHMARK(BM_KeywordLookupHashMap);
+
+static void BM_TokenizeKeywordDense(benchmark::State& state) {
+	std::string text;
+	while (text.size() < (1 << 20)) {
+		text += "pub struct Point { pub def x: i32; pub def y: f64; }\n"
+		        "func step(mut count: u64, flag: bool) str { if (flag) { return \"a\"; } else { return \"b\"; } }\n";
+	}
+	for (auto _ : state) {
+		auto result = tokenize(text);
+		benchmark::DoNotOptimize(result.tokens.data());
+	}
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(text.size()));
+}
+BENCHMARK(BM_TokenizeKeywordDense);
@@ -0,0 +1,92 @@
+#include <benchmark/benchmark.h>
+#include "backend/Parser.h"
+#include "backend/Tokenizer.h"
+#include "frontend/CodeGenerationVisitor.h"
+
+#include "../backend/BenchmarkSources.h"
+
+#include <memory>
+#include <string>
+
+using namespace ArgonLang;
+
+namespace {
+struct ParsedProgram {
+	TokenizeResult tokens;
+	std::unique_ptr<ProgramNode> program;
+	std::size_t node_count = 0;
+};
+
+// Parses text once, counting the nodes of the resulting tree
+ParsedProgram parse_program(const std::string& text) {
+	ParsedProgram parsed{tokenize(text)};
+	ASTNodeTracker tracker;
+	tracker.install();
+	Parser parser(parsed.tokens.tokens);
+	auto program = parser.parse();
+	tracker.uninstall();
+	if (program.has_value()) {
+		parsed.program = std::move(program.value());
+		for (const auto& [type, count] : tracker.count_by_type()) {
+			parsed.node_count += count;
+		}
+	}
+	return parsed;
+}
+
+// Generates the whole program per iteration; reports the time per 100k AST nodes, which is dominated by the
+// per-node visitor dispatch
+void run_code_generation(benchmark::State& state, const ParsedProgram& parsed, bool parallel = false) {
+	if (!parsed.program) {
+		state.SkipWithError("benchmark source failed to parse");
+		return;
+	}
+	for (auto _ : state) {
+		CodeGenerationVisitor generator;
+		CodeSink code;
+		if (!generator.generate(*parsed.program, code, parallel).has_value()) {
+			state.SkipWithError("code generation failed");
+			break;
+		}
+		benchmark::DoNotOptimize(code.take());
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(parsed.node_count));
+	state.counters["time_per_100k_nodes"] =
+	    benchmark::Counter(static_cast<double>(parsed.node_count) / 100000.0,
+	                       benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+}
+} // namespace
+
+// Code generation for the statement-heavy 1 MiB program the parser benchmarks use
+static void BM_CodeGeneration(benchmark::State& state) {
+	static const ParsedProgram parsed = parse_program(Benchmarks::generate_source(1 << 20));
+	run_code_generation(state, parsed);
+}
+BENCHMARK(BM_CodeGeneration)->Unit(benchmark::kMillisecond);
+
+// The same program with top-level declarations generated on the runtime scheduler
+static void BM_CodeGenerationParallel(benchmark::State& state) {
+	static const ParsedProgram parsed = parse_program(Benchmarks::generate_source(1 << 20));
+	run_code_generation(state, parsed, true);
+}
+BENCHMARK(BM_CodeGenerationParallel)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// Code generation for long operator chains, where nearly every node is a small expression
+static void BM_CodeGenerationExpressions(benchmark::State& state) {
+	static const ParsedProgram parsed = parse_program(Benchmarks::generate_expression_source(1 << 20));
+	run_code_generation(state, parsed);
+}
+BENCHMARK(BM_CodeGenerationExpressions)->Unit(benchmark::kMillisecond);
+
+// Blocks nested state.range(0) deep, each with a statement of its own; every level's code used to be copied into
+// its parent's, making this quadratic in the depth
+static void BM_CodeGenerationNestedBlocks(benchmark::State& state) {
+	std::string body = "x = x + 1;";
+	for (int64_t depth = 0; depth < state.range(0); ++depth) {
+		body = "x = x + 1; if (x > " + std::to_string(depth) + ") { " + body + " }";
+	}
+	ParsedProgram parsed = parse_program("func main() i32 { def x: i32 = 0; " + body + " return x; }\n");
+	run_code_generation(state, parsed);
+	state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_CodeGenerationNestedBlocks)->RangeMultiplier(4)->Range(16, 256)->Complexity();
@@ -0,0 +1,96 @@
+#include <benchmark/benchmark.h>
+#include "runtime/ArgonRuntime.h"
+
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+using namespace ArgonLang::Runtime;
+
+namespace {
+// Sizes below, around and well above the default parallel threshold
+void sizes_and_policies(benchmark::internal::Benchmark* bench) {
+	for (int64_t size : {1 << 10, 1 << 15, 1 << 20}) {
+		bench->Args({size, static_cast<int64_t>(ExecutionPolicy::Sequential)});
+		bench->Args({size, static_cast<int64_t>(ExecutionPolicy::Parallel)});
+	}
+	bench->ArgNames({"size", "parallel"})->UseRealTime();
+}
+
+template<typename T>
+std::vector<T> make_values(benchmark::State& state) {
+	std::vector<T> values(static_cast<std::size_t>(state.range(0)));
+	std::iota(values.begin(), values.end(), T{1});
+	return values;
+}
+
+ExecutionPolicy policy_of(benchmark::State& state) {
+	return static_cast<ExecutionPolicy>(state.range(1));
+}
+} // namespace
+
+template<typename T>
+static void BM_Filter(benchmark::State& state) {
+	auto values = make_values<T>(state);
+	for (auto _ : state) {
+		auto result = filter(policy_of(state), values, [](T x) { return static_cast<int64_t>(x) % 3 == 0; });
+		benchmark::DoNotOptimize(result.data());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_Filter, int)->Apply(sizes_and_policies);
+BENCHMARK_TEMPLATE(BM_Filter, double)->Apply(sizes_and_policies);
+
+template<typename T>
+static void BM_Map(benchmark::State& state) {
+	auto values = make_values<T>(state);
+	for (auto _ : state) {
+		auto result = map(policy_of(state), values, [](T x) { return x * 3 + 1; });
+		benchmark::DoNotOptimize(result.data());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_Map, int)->Apply(sizes_and_policies);
+BENCHMARK_TEMPLATE(BM_Map, double)->Apply(sizes_and_policies);
+
+template<typename T>
+static void BM_Reduce(benchmark::State& state) {
+	auto values = make_values<T>(state);
+	auto sum = [](T a, T b) { return a + b; };
+	for (auto _ : state) {
+		// With sum as the combine too, since only a reduce with a separate combine can run in parallel
+		T result = reduce(policy_of(state), values, T{}, sum, sum);
+		benchmark::DoNotOptimize(result);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_Reduce, int)->Apply(sizes_and_policies);
+BENCHMARK_TEMPLATE(BM_Reduce, double)->Apply(sizes_and_policies);
+
+template<typename T>
+static void BM_MapPipe(benchmark::State& state) {
+	auto values = make_values<T>(state);
+	for (auto _ : state) {
+		map_pipe(policy_of(state), values, [](T x) { return x ^ 1; });
+		benchmark::DoNotOptimize(values.data());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_MapPipe, int)->Apply(sizes_and_policies);
+
+// values | pred & transform ? reducer, as lowered by the code generator
+template<typename T>
+static void BM_FusedPipeline(benchmark::State& state) {
+	auto values = make_values<T>(state);
+	for (auto _ : state) {
+		auto pipeline = lazy_map(policy_of(state),
+		                         lazy_filter(policy_of(state), values,
+		                                     [](T x) { return static_cast<int64_t>(x) % 3 == 0; }),
+		                         [](T x) { return x * 3 + 1; });
+		T result = reduce(policy_of(state), pipeline, [](T a, T b) { return a + b; });
+		benchmark::DoNotOptimize(result);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_FusedPipeline, int)->Apply(sizes_and_policies);
+BENCHMARK_TEMPLATE(BM_FusedPipeline, double)->Apply(sizes_and_policies);
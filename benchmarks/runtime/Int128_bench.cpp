@@ -0,0 +1,110 @@
+#include <benchmark/benchmark.h>
+#include "runtime/ArgonRuntime.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace ArgonLang::Runtime;
+
+namespace {
+constexpr std::size_t OPERANDS = 1024;
+
+std::vector<U128> random_u128(bool wide) {
+	std::mt19937_64 random(128);
+	std::vector<U128> values(OPERANDS);
+	for (auto& value : values) {
+		value = U128(wide ? random() : 0, random() | 1);
+	}
+	return values;
+}
+} // namespace
+
+static void BM_U128Add(benchmark::State& state) {
+	auto values = random_u128(true);
+	for (auto _ : state) {
+		U128 sum;
+		for (const auto& value : values) {
+			sum += value;
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * OPERANDS);
+}
+BENCHMARK(BM_U128Add);
+
+static void BM_U128Multiply(benchmark::State& state) {
+	auto values = random_u128(true);
+	for (auto _ : state) {
+		U128 product(1u);
+		for (const auto& value : values) {
+			product *= value;
+		}
+		benchmark::DoNotOptimize(product);
+	}
+	state.SetItemsProcessed(state.iterations() * OPERANDS);
+}
+BENCHMARK(BM_U128Multiply);
+
+// range(0) selects a 64-bit (0) or a full 128-bit (1) divisor
+static void BM_U128Divide(benchmark::State& state) {
+	auto dividends = random_u128(true);
+	auto divisors = random_u128(state.range(0) != 0);
+	for (auto _ : state) {
+		for (std::size_t i = 0; i < OPERANDS; ++i) {
+			benchmark::DoNotOptimize(dividends[i] / divisors[i]);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * OPERANDS);
+}
+BENCHMARK(BM_U128Divide)->Arg(0)->Arg(1)->ArgName("wide");
+
+static void BM_U64DivisorDivide(benchmark::State& state) {
+	auto dividends = random_u128(true);
+	U64Divisor divisor(10000000000000000000ULL);
+	for (auto _ : state) {
+		for (const auto& dividend : dividends) {
+			U64 remainder;
+			benchmark::DoNotOptimize(divisor.divide(dividend, remainder));
+			benchmark::DoNotOptimize(remainder);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * OPERANDS);
+}
+BENCHMARK(BM_U64DivisorDivide);
+
+static void BM_U128ToString(benchmark::State& state) {
+	auto values = random_u128(true);
+	for (auto _ : state) {
+		for (const auto& value : values) {
+			benchmark::DoNotOptimize(value.to_string());
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * OPERANDS);
+}
+BENCHMARK(BM_U128ToString);
+
+static void BM_I128ToString(benchmark::State& state) {
+	auto values = random_u128(true);
+	for (auto _ : state) {
+		for (const auto& value : values) {
+			benchmark::DoNotOptimize(I128::from_bits(value).to_string());
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * OPERANDS);
+}
+BENCHMARK(BM_I128ToString);
+
+static void BM_U128Parse(benchmark::State& state) {
+	std::vector<std::string> texts;
+	for (const auto& value : random_u128(true)) {
+		texts.push_back(value.to_string());
+	}
+	for (auto _ : state) {
+		for (const auto& text : texts) {
+			benchmark::DoNotOptimize(U128(text));
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * OPERANDS);
+}
+BENCHMARK(BM_U128Parse);
@@ -0,0 +1,76 @@
+#include <benchmark/benchmark.h>
+#include "runtime/ArgonRuntime.h"
+
+#include <numeric>
+#include <utility>
+#include <vector>
+
+using namespace ArgonLang::Runtime;
+
+namespace {
+std::vector<int> make_values(std::size_t count) {
+	std::vector<int> values(count);
+	std::iota(values.begin(), values.end(), 0);
+	return values;
+}
+} // namespace
+
+static void BM_MatchRangeInt(benchmark::State& state) {
+	auto values = make_values(1024);
+	for (auto _ : state) {
+		int matches = 0;
+		for (int value : values) {
+			matches += match_range_int(value, 100, 900, true);
+		}
+		benchmark::DoNotOptimize(matches);
+	}
+	state.SetItemsProcessed(state.iterations() * 1024);
+}
+BENCHMARK(BM_MatchRangeInt);
+
+static void BM_MatchValueInt(benchmark::State& state) {
+	auto values = make_values(1024);
+	const int pattern = 512;
+	for (auto _ : state) {
+		int matches = 0;
+		for (const int& value : values) {
+			matches += match_value(value, pattern);
+		}
+		benchmark::DoNotOptimize(matches);
+	}
+	state.SetItemsProcessed(state.iterations() * 1024);
+}
+BENCHMARK(BM_MatchValueInt);
+
+// [a, b, c] = values
+static void BM_DestructureArrayElements(benchmark::State& state) {
+	const auto values = make_values(16);
+	for (auto _ : state) {
+		int a = destructure_array_element(values, 0);
+		int b = destructure_array_element(values, 1);
+		int c = destructure_array_element(values, 2);
+		benchmark::DoNotOptimize(a + b + c);
+	}
+}
+BENCHMARK(BM_DestructureArrayElements);
+
+// [first, ...rest] = values
+static void BM_DestructureArrayRest(benchmark::State& state) {
+	const auto values = make_values(static_cast<std::size_t>(state.range(0)));
+	for (auto _ : state) {
+		int first = destructure_array_element(values, 0);
+		auto rest = destructure_array_rest(values, 1);
+		benchmark::DoNotOptimize(first);
+		benchmark::DoNotOptimize(rest.data());
+	}
+}
+BENCHMARK(BM_DestructureArrayRest)->Range(8, 4096);
+
+static void BM_CompoundDestructure(benchmark::State& state) {
+	auto values = make_values(64);
+	for (auto _ : state) {
+		auto destructure = compound_destructure(values);
+		benchmark::DoNotOptimize(&destructure.source);
+	}
+}
+BENCHMARK(BM_CompoundDestructure);
@@ -0,0 +1,61 @@
+#include <benchmark/benchmark.h>
+#include "runtime/ArgonRuntime.h"
+
+#include <vector>
+
+using namespace ArgonLang::Runtime;
+
+// Round trip of a single par/await: allocation, submit, and the awaiting thread picking the task back up
+static void BM_ParAwaitLatency(benchmark::State& state) {
+	int value = 0;
+	for (auto _ : state) {
+		value = await(par([value] { return value + 1; }));
+	}
+	benchmark::DoNotOptimize(value);
+}
+BENCHMARK(BM_ParAwaitLatency);
+
+// Spawns a batch of small tasks and awaits them in order
+static void BM_ParThroughput(benchmark::State& state) {
+	const auto tasks = static_cast<std::size_t>(state.range(0));
+	std::vector<ArgonFuture<std::size_t>> futures;
+	futures.reserve(tasks);
+	for (auto _ : state) {
+		for (std::size_t i = 0; i < tasks; ++i) {
+			futures.push_back(par([i] {
+				std::size_t sum = 0;
+				for (std::size_t j = 0; j < 64; ++j) {
+					sum += i ^ j;
+				}
+				return sum;
+			}));
+		}
+		std::size_t total = 0;
+		for (auto& future : futures) {
+			total += await(std::move(future));
+		}
+		futures.clear();
+		benchmark::DoNotOptimize(total);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ParThroughput)->RangeMultiplier(8)->Range(8, 4096)->UseRealTime();
+
+// Cost of the scope emitted for a block that contains par, without any task attached
+static void BM_ScopePerBlock(benchmark::State& state) {
+	for (auto _ : state) {
+		ARGON_SCOPE_BEGIN();
+		benchmark::ClobberMemory();
+	}
+}
+BENCHMARK(BM_ScopePerBlock);
+
+// A block with one fire-and-forget par, joined when the scope ends
+static void BM_ScopeWithPar(benchmark::State& state) {
+	int sink = 0;
+	for (auto _ : state) {
+		ARGON_SCOPE_BEGIN();
+		par([&sink] { benchmark::DoNotOptimize(sink); });
+	}
+}
+BENCHMARK(BM_ScopeWithPar)->UseRealTime();
@@ -28,6 +28,9 @@ enum class ErrorSeverity {
 
 // Specific error types for different phases
 enum class ErrorType {
+    // Input errors
+    SourceNotReadable,
+
     // Lexical errors
     UnexpectedCharacter,
     UnterminatedString,
@@ -430,7 +433,7 @@ inline Error create_unexpected_token_error(const Token& token, const std::string
     return Error(ErrorType::UnexpectedToken, 
                 std::format("Unexpected token '{}'", token.value), pos)
            .withExpected(expected)
-           .withActual(token.value);
+           .withActual(std::string(token.value));
 }
 
 inline Error create_missing_token_error(const std::string& expected, const Token::Position& pos, 
@@ -466,7 +469,7 @@ inline Error create_unexpected_token_error_with_snippet(const Token& token, cons
     Error error = Error(ErrorType::UnexpectedToken, 
                        std::format("Unexpected token '{}'", token.value), pos)
                   .withExpected(expected)
-                  .withActual(token.value);
+                  .withActual(std::string(token.value));
     
     // Create source snippet
     auto snippet = source_manager.create_snippet("",
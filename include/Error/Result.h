@@ -30,6 +30,11 @@ inline Result<std::string> Ok(const char* value) {
     return Result<std::string>(std::string(value));
 }
 
+// Success of an operation whose only outcome is its side effects
+inline Result<void> Ok() {
+    return Result<void>();
+}
+
 // Error cases
 template<typename T>
 Result<T> Err(ErrorType type, const std::string& message, const Position& position,
@@ -0,0 +1,87 @@
+#ifndef ARGONLANG_COMPILERSTATS_H
+#define ARGONLANG_COMPILERSTATS_H
+
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "backend/AST.h"
+
+namespace ArgonLang {
+	// Process-wide operator new calls and bytes requested since startup. Only executables linking the counting
+	// allocator (AllocationCounting.cpp: the driver and the tests) count them; elsewhere they stay 0
+	struct AllocationCounters {
+		std::size_t allocations = 0;
+		std::size_t bytes = 0;
+	};
+
+	AllocationCounters allocation_counters();
+
+	// Called by the counting allocator for each allocation
+	void count_allocation(std::size_t bytes) noexcept;
+
+	// High-water mark of the resident set size in bytes, 0 where the platform does not report it
+	std::size_t peak_rss_bytes();
+
+	// CompilerStats - per-phase measurements of one compiler run, reported by --time-passes and --stats
+	class CompilerStats {
+	public:
+		struct Pass {
+			std::string name;
+			double wall_ms = 0;
+			std::size_t peak_rss = 0;
+			std::size_t allocations = 0;
+			std::size_t allocated_bytes = 0;
+		};
+
+		// Runs phase() and records its wall time and allocations under name
+		template<typename Phase>
+		std::invoke_result_t<Phase&> time(std::string name, Phase&& phase) {
+			PassScope scope(*this, std::move(name));
+			return phase();
+		}
+
+		void set_source_bytes(std::size_t bytes) { source_bytes = bytes; }
+		void set_token_count(std::size_t count) { token_count = count; }
+		void set_generated_bytes(std::size_t bytes) { generated_bytes = bytes; }
+		void set_ast_nodes(std::size_t created, std::map<ASTNodeType, std::size_t> live) {
+			ast_nodes_created = created;
+			ast_nodes = std::move(live);
+		}
+
+		const std::vector<Pass>& get_passes() const { return passes; }
+
+		// Human-readable report; with_counts adds the token/AST/output counters of --stats
+		void print(std::ostream& os, bool with_counts) const;
+		void print_json(std::ostream& os) const;
+
+	private:
+		class PassScope {
+		private:
+			CompilerStats& stats;
+			std::string name;
+			std::chrono::steady_clock::time_point start;
+			AllocationCounters start_allocations;
+
+		public:
+			PassScope(CompilerStats& stats, std::string name);
+			PassScope(const PassScope&) = delete;
+			PassScope& operator=(const PassScope&) = delete;
+			~PassScope();
+		};
+
+		std::vector<Pass> passes;
+		std::size_t source_bytes = 0;
+		std::size_t token_count = 0;
+		std::size_t generated_bytes = 0;
+		std::size_t ast_nodes_created = 0;
+		std::map<ASTNodeType, std::size_t> ast_nodes;
+	};
+} // namespace ArgonLang
+
+#endif // ARGONLANG_COMPILERSTATS_H
@@ -1,10 +1,18 @@
 #ifndef AST_H
 #define AST_H
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <iostream>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <type_traits>
+#include <unordered_set>
 #include <utility>
+#include <vector>
 #include "Tokenizer.h"
 
 #define DEBUG
@@ -118,6 +126,117 @@ namespace ArgonLang
 
 	std::string primitive_type_to_string(PrimitiveType type);
 	std::string ast_node_type_to_string(ASTNodeType type);
+
+	class ASTNode;
+
+	// ASTNodeTracker - while installed, records every AST node constructed and destroyed on any thread, so that
+	// the driver's --stats mode can count the nodes of a parsed program by ASTNodeType without walking the tree
+	class ASTNodeTracker {
+	private:
+		std::unordered_set<const ASTNode*> live_;
+		std::size_t created_ = 0;
+		mutable std::mutex mutex_;
+
+		friend class ASTNode;
+		void add(const ASTNode* node);
+		void remove(const ASTNode* node);
+
+	public:
+		ASTNodeTracker() = default;
+		ASTNodeTracker(const ASTNodeTracker&) = delete;
+		ASTNodeTracker& operator=(const ASTNodeTracker&) = delete;
+		~ASTNodeTracker();
+
+		static ASTNodeTracker* active();
+		void install();
+		void uninstall();
+
+		// Nodes constructed while installed, including ones the parser discarded
+		std::size_t created() const;
+		// Live nodes per type; only valid once construction of the tree has finished
+		std::map<ASTNodeType, std::size_t> count_by_type() const;
+	};
+	// ASTArena - bump allocator for the nodes of one parsed program. While a Scope is active on a thread, every AST
+	// node constructed on it is placed in the arena and every InternedString made on it is interned there; deleting
+	// such a node runs its destructor but leaves the memory to the arena, which frees it in a few large blocks.
+	// Nodes constructed with no arena active are allocated on the heap as usual.
+	class ASTArena {
+	private:
+		struct StringHash {
+			using is_transparent = void;
+			std::size_t operator()(std::string_view text) const { return std::hash<std::string_view>{}(text); }
+		};
+
+		std::vector<std::unique_ptr<std::byte[]>> blocks;
+		std::byte* cursor = nullptr;
+		std::byte* limit = nullptr;
+		std::size_t bytes_used = 0;
+		// Node-based, so interned strings keep their address when the table grows
+		std::unordered_set<std::string, StringHash, std::equal_to<>> strings;
+
+		friend class ASTNode;
+		friend class InternedString;
+		void* allocate(std::size_t size);
+		const std::string& intern(std::string_view text);
+		static void* allocate_node(std::size_t size);
+		static void deallocate_node(void* node) noexcept;
+		static const std::string& intern_current(std::string_view text);
+
+	public:
+		static constexpr std::size_t BLOCK_SIZE = 64 * 1024;
+
+		ASTArena() = default;
+		ASTArena(const ASTArena&) = delete;
+		ASTArena& operator=(const ASTArena&) = delete;
+
+		static ASTArena* active();
+
+		// Makes the arena the current thread's allocation target until destroyed, restoring the previous one
+		class Scope {
+			ASTArena* previous;
+
+		public:
+			explicit Scope(ASTArena* arena);
+			~Scope();
+			Scope(const Scope&) = delete;
+			Scope& operator=(const Scope&) = delete;
+		};
+
+		std::size_t block_count() const { return blocks.size(); }
+		std::size_t bytes_allocated() const { return bytes_used; }
+		std::size_t interned_count() const { return strings.size(); }
+	};
+
+	// InternedString - name shared by every node that spells it; interned in the active ASTArena, or in a
+	// process-wide table that is never freed when there is none
+	class InternedString {
+	private:
+		const std::string* text;
+
+	public:
+		InternedString();
+		InternedString(std::string_view text);
+		InternedString(const std::string& text) : InternedString(std::string_view(text)) {}
+		InternedString(const char* text) : InternedString(std::string_view(text)) {}
+
+		const std::string& str() const { return *text; }
+		operator const std::string&() const { return *text; }
+		bool empty() const { return text->empty(); }
+		std::size_t size() const { return text->size(); }
+
+		friend bool operator==(const InternedString& lhs, const InternedString& rhs) {
+			return lhs.text == rhs.text || *lhs.text == *rhs.text;
+		}
+		friend bool operator==(const InternedString& lhs, std::string_view rhs) { return *lhs.text == rhs; }
+		friend bool operator==(const InternedString& lhs, const std::string& rhs) { return *lhs.text == rhs; }
+		friend bool operator==(const InternedString& lhs, const char* rhs) { return *lhs.text == rhs; }
+		friend std::string operator+(const InternedString& lhs, const std::string& rhs) { return *lhs.text + rhs; }
+		friend std::string operator+(const std::string& lhs, const InternedString& rhs) { return lhs + *rhs.text; }
+		friend std::string operator+(const InternedString& lhs, const char* rhs) { return *lhs.text + rhs; }
+		friend std::string operator+(const char* lhs, const InternedString& rhs) { return lhs + *rhs.text; }
+		friend std::ostream& operator<<(std::ostream& os, const InternedString& string) { return os << *string.text; }
+	};
+
 	PrimitiveType determine_integer_type(const std::string& value);
 	PrimitiveType determine_float_type(const std::string& value);
 	std::string strip_integer_suffix(const std::string& value);
@@ -125,10 +244,14 @@ namespace ArgonLang
 
     class ASTNode {
     public:
-        virtual ~ASTNode() = default;
+        virtual ~ASTNode();
 		Token::Position position;
 
 		explicit ASTNode(Token::Position pos);
+
+		// Nodes go into the active ASTArena, if any; see ASTArena
+		static void* operator new(std::size_t size);
+		static void operator delete(void* node) noexcept;
 		virtual ASTNodeType get_node_type() const = 0;
 		virtual ASTNodeGroup get_node_group() const = 0;
 
@@ -225,9 +348,9 @@ namespace ArgonLang
 
     class IdentifierNode : public ExpressionNode {
     public:
-        std::string identifier;
+        InternedString identifier;
 
-        explicit IdentifierNode(Token::Position position, std::string val);
+        explicit IdentifierNode(Token::Position position, std::string_view val);
 
 		ASTNodeType get_node_type() const override;
     #ifdef DEBUG
@@ -674,7 +797,11 @@ namespace ArgonLang
 
     class ProgramNode : public StatementNode {
     public:
+        // Memory of the nodes when they were parsed into an arena; declared first so it outlives them
+        std::unique_ptr<ASTArena> arena;
         std::vector<std::unique_ptr<ASTNode>> nodes;
+        // Parser::hash_tokens of each of nodes, when parsed from tokens; keys the incremental code generation cache
+        std::vector<uint64_t> declaration_hashes;
 
         explicit ProgramNode(Token::Position position, std::vector<std::unique_ptr<ASTNode>> stmts);
 
@@ -1071,9 +1198,9 @@ namespace ArgonLang
 
 	class IdentifierTypeNode : public TypeNode { // i32
 	public:
-		std::string typeName;
+		InternedString typeName;
 
-		explicit IdentifierTypeNode(Token::Position position, std::string typeName);
+		explicit IdentifierTypeNode(Token::Position position, std::string_view typeName);
 
 		ASTNodeType get_node_type() const override;
 #ifdef DEBUG
@@ -1126,8 +1253,8 @@ namespace ArgonLang
 		enum Prefix {
 			Pointer,        // *T - raw pointer
 			Owned,          // ~T - unique_ptr
-			SharedRef,      // ref<T> - shared_ptr
-			WeakRef,        // weak<T> - weak_ptr
+			SharedRef,      // ref<T> - Runtime::Ref
+			WeakRef,        // weak<T> - Runtime::Weak
 			ImmutableRef,   // &T - const reference
 			MutableRef      // &&T - mutable reference
 		} prefix;
@@ -1190,6 +1317,123 @@ namespace ArgonLang
 #endif
 	};
 
+	// Every concrete node class, named by the ASTNodeType it reports (class <Type>Node); NodeTraits and node_cast are
+	// generated from it
+#define ARGON_AST_NODE_TYPES(X) \
+	X(StringLiteral) \
+	X(CharLiteral) \
+	X(IntegralLiteral) \
+	X(FloatLiteral) \
+	X(BooleanLiteral) \
+	X(Identifier) \
+	X(BinaryExpression) \
+	X(UnaryExpression) \
+	X(UnaryPostExpression) \
+	X(NullExpression) \
+	X(FunctionCallExpression) \
+	X(ToExpression) \
+	X(LambdaExpression) \
+	X(ComparisonExpression) \
+	X(AssignmentExpression) \
+	X(IndexExpression) \
+	X(SliceExpression) \
+	X(MultipleIndexExpression) \
+	X(MatchExpression) \
+	X(WildcardPattern) \
+	X(LiteralPattern) \
+	X(IdentifierPattern) \
+	X(ArrayPattern) \
+	X(StructPattern) \
+	X(ConstructorPattern) \
+	X(TypePattern) \
+	X(RangePattern) \
+	X(TernaryExpression) \
+	X(ParallelExpression) \
+	X(TryExpression) \
+	X(StructExpression) \
+	X(RangeExpression) \
+	X(MemberAccessExpression) \
+	X(Program) \
+	X(ReturnStatement) \
+	X(VariableDeclaration) \
+	X(IfStatement) \
+	X(ForStatement) \
+	X(UnionDeclaration) \
+	X(EnumDeclaration) \
+	X(ConstraintDeclaration) \
+	X(ModuleDeclaration) \
+	X(ImportStatement) \
+	X(YieldStatement) \
+	X(WhileStatement) \
+	X(BreakStatement) \
+	X(ContinueStatement) \
+	X(Block) \
+	X(TypeAlias) \
+	X(ClassDeclaration) \
+	X(FunctionDeclaration) \
+	X(FunctionDefinition) \
+	X(ConstructorStatement) \
+	X(ImplStatement) \
+	X(IntersectionType) \
+	X(PrefixedType) \
+	X(GenericType) \
+	X(SumType) \
+	X(IdentifierType) \
+	X(FunctionType) \
+	X(ArrayType) \
+	X(VariadicType)
+
+	template <typename Node>
+	struct NodeTraits;
+
+#define ARGON_NODE_TRAITS(Type) \
+	template <> \
+	struct NodeTraits<Type##Node> { \
+		static constexpr ASTNodeType type = ASTNodeType::Type; \
+	};
+	ARGON_AST_NODE_TYPES(ARGON_NODE_TRAITS)
+#undef ARGON_NODE_TRAITS
+
+	// Whether node is a Node, decided from its type tag and group alone
+	template <typename Node>
+	bool is_node(const ASTNode& node) {
+		if constexpr (std::is_same_v<Node, ASTNode>) {
+			return true;
+		} else if constexpr (std::is_same_v<Node, ExpressionNode>) {
+			return node.get_node_group() == ASTNodeGroup::Expression;
+		} else if constexpr (std::is_same_v<Node, StatementNode>) {
+			return node.get_node_group() == ASTNodeGroup::Statement;
+		} else if constexpr (std::is_same_v<Node, TypeNode>) {
+			return node.get_node_group() == ASTNodeGroup::Type;
+		} else if constexpr (std::is_same_v<Node, PatternNode>) {
+			ASTNodeType type = node.get_node_type();
+			return type >= ASTNodeType::WildcardPattern && type <= ASTNodeType::RangePattern;
+		} else {
+			return node.get_node_type() == NodeTraits<Node>::type;
+		}
+	}
+
+	// Downcasts without RTTI. The reference forms are a plain static_cast for callers that have already switched
+	// on the node type; the pointer forms check the tag and give null on a mismatch, like dynamic_cast.
+	template <typename Node>
+	const Node& node_cast(const ASTNode& node) {
+		return static_cast<const Node&>(node);
+	}
+
+	template <typename Node>
+	Node& node_cast(ASTNode& node) {
+		return static_cast<Node&>(node);
+	}
+
+	template <typename Node>
+	const Node* node_cast(const ASTNode* node) {
+		return node != nullptr && is_node<Node>(*node) ? static_cast<const Node*>(node) : nullptr;
+	}
+
+	template <typename Node>
+	Node* node_cast(ASTNode* node) {
+		return node != nullptr && is_node<Node>(*node) ? static_cast<Node*>(node) : nullptr;
+	}
 }
 
 
@@ -4,32 +4,69 @@
 #include "AST.h"
 #include "Error/Result.h"
 #include "Error/ErrorFormatter.h"
+#include <cstdint>
 #include <vector>
 #include <memory>
 #include "backend/Tokenizer.h"
+#include "backend/TokenStream.h"
 
 namespace ArgonLang {
+	// Transfers ownership to a unique_ptr of the derived node type, checking the node's type tag rather than RTTI
 	template <typename Target, typename Source>
-	std::unique_ptr<Target> dynamic_unique_cast(std::unique_ptr<Source> source) {
-		if (auto* result = dynamic_cast<Target*>(source.get())) {
+	std::unique_ptr<Target> unique_node_cast(std::unique_ptr<Source> source) {
+		if (Target* result = node_cast<Target>(source.get())) {
 			source.release();
 			return std::unique_ptr<Target>(result);
 		}
 		throw std::runtime_error("Invalid cast");
 	}
 
-	template <typename Target, typename Source>
-	std::unique_ptr<Target> dynamic_unique_cast(std::unique_ptr<Source&> source) {
-		if (auto* result = dynamic_cast<Target*>(source)) {
-			source.release();
-			return std::unique_ptr<Target>(result);
-		}
-		throw std::runtime_error("Invalid cast");
-	}
+	// Binding strength of the binary and ternary operators, loosest first (see EXPRESSION_PRECEDENCE.md). An
+	// operand parsed at a level only absorbs operators of that level or a tighter one.
+	enum class BinaryLevel : uint8_t {
+		None,
+		Assignment,
+		Ternary,
+		Match,
+		Pipe,
+		Parallel, // Prefix 'par', allowed as the operand of a pipe
+		Filter,
+		Map,
+		Reduce,
+		LogicalOr,
+		LogicalAnd,
+		Equality,
+		Relational,
+		Bitwise,
+		Shift,
+		To,
+		Additive,
+		Multiplicative,
+		Unary
+	};
+
+	// Binding strength of the prefix operators, loosest first. The operand of a prefix operator is parsed one level
+	// tighter, and postfix '++'/'--' wrap everything parsed from the Postfix level inwards.
+	enum class PrefixLevel : uint8_t {
+		None,
+		BitwiseNot,
+		LogicalNot,
+		Await,
+		Iterator,
+		Plus,
+		Minus,
+		Postfix,
+		Increment,
+		Ownership,
+		Reference,
+		Deref,
+		Operand
+	};
 
 	class Parser {
 	private:
-    	const std::vector<Token>& tokens;
+		std::unique_ptr<TokenStream> owned_tokens; // Set when constructed from a vector
+		TokenStream& tokens;
     	size_t current = 0;
 		int main_counter = 0;
 		std::string current_class_name;
@@ -37,17 +74,28 @@ namespace ArgonLang {
 
 	public:
 		explicit Parser(const std::vector<Token>& tokens);
+		// Parses while tokens are being streamed; stops at a tokenizer error, which tokens reports
+		explicit Parser(TokenStream& tokens);
 
 		int get_main_counter() const;
-		Token peek() const;
-		Token peek(int offset) const;
+		// Tokens are returned by reference into the token stream; they stay valid until the enclosing top-level
+		// declaration has been parsed
+		const Token& peek() const;
+		const Token& peek(int offset) const;
+		Token::Type peek_type() const;
+		Token::Type peek_type(int offset) const;
 		bool eos() const;
 		void synchronize();
+		// Lets a streaming TokenStream drop the tokens of the declarations that have been parsed
+		void release_consumed_tokens();
+		// Hash of the types and spellings of the tokens in [begin, end), which must not have been released yet;
+		// positions are left out so that moving a declaration does not change it
+		uint64_t hash_tokens(size_t begin, size_t end) const;
 
 		bool is_lambda_expression();
 		bool is_single_parameter_lambda();
-		Result<Token> advance();
-		Result<Token> expect(Token::Type type, const std::string& errorMessage);
+		Result<const Token*> advance();
+		Result<const Token*> expect(Token::Type type, const std::string& errorMessage);
 
 		Result<std::unique_ptr<ProgramNode>> parse();
 		Result<std::unique_ptr<ASTNode>> parse_statement();
@@ -72,6 +120,10 @@ namespace ArgonLang {
 		Result<std::unique_ptr<ASTNode>> parse_parallel_expression();
 		Result<std::unique_ptr<ASTNode>> parse_struct_expression();
 		Result<std::unique_ptr<ASTNode>> parse_match_expression();
+		// Table-driven expression parsing: the parse_*_expression functions for operator levels enter here
+		Result<std::unique_ptr<ASTNode>> parse_binary_expression(BinaryLevel min_level);
+		Result<std::unique_ptr<ASTNode>> parse_unary_expression(PrefixLevel min_level);
+		Result<std::unique_ptr<ASTNode>> parse_match_branches(Token::Position pos, std::unique_ptr<ASTNode> value);
 		
 		// Pattern parsing methods
 		Result<std::unique_ptr<PatternNode>> parse_pattern();
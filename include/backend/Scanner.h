@@ -0,0 +1,33 @@
+#ifndef SCANNER_H
+#define SCANNER_H
+
+#include <cstddef>
+#include <string_view>
+
+namespace ArgonLang {
+	// Vectorised scanning primitives used by the tokenizer for runs of bytes: blanks, identifier characters,
+	// string literal bodies and comments. Each one classifies 16 (SSE2) or 32 (AVX2) bytes per step, picked at
+	// runtime from what the CPU supports, with a scalar fallback for other targets and for the last bytes of the
+	// input (loads never read past input.size(), so a memory-mapped file can end on a page boundary).
+	// All of them return input.size() when the scanned run reaches the end of the input.
+	namespace Scanner {
+		enum class InstructionSet { Scalar, SSE2, AVX2 };
+
+		// Best instruction set supported by this CPU, and the one currently in use
+		InstructionSet best_instruction_set();
+		InstructionSet active_instruction_set();
+		// Selects the kernels to use (clamped to what the CPU supports); for tests and benchmarks
+		void set_instruction_set(InstructionSet set);
+
+		// First index at or after from that is neither ' ' nor '\t'; adds the number of tabs skipped to tabs
+		std::size_t skip_blanks(std::string_view input, std::size_t from, std::size_t& tabs);
+
+		// First index at or after from that is not [A-Za-z0-9_]
+		std::size_t find_identifier_end(std::string_view input, std::size_t from);
+
+		// First index at or after from holding either a or b
+		std::size_t find_either(std::string_view input, std::size_t from, char a, char b);
+	} // namespace Scanner
+} // namespace ArgonLang
+
+#endif // SCANNER_H
@@ -0,0 +1,39 @@
+#ifndef SOURCEBUFFER_H
+#define SOURCEBUFFER_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include "Error/Result.h"
+
+namespace ArgonLang {
+	// SourceBuffer - read-only contents of a source file, memory-mapped where the platform allows it so that
+	// tokenizing reads the page cache directly instead of a heap copy. Tokens are views into the buffer, so it
+	// has to outlive them. The mapped contents are not NUL-terminated.
+	class SourceBuffer {
+	private:
+		const char* data = nullptr;
+		std::size_t size = 0;
+		bool mapped = false;
+		std::string owned; // Contents when not mapped (empty files, from_string, unsupported platforms)
+
+		void release();
+
+	public:
+		SourceBuffer() = default;
+		SourceBuffer(SourceBuffer&& other) noexcept;
+		SourceBuffer& operator=(SourceBuffer&& other) noexcept;
+		SourceBuffer(const SourceBuffer&) = delete;
+		SourceBuffer& operator=(const SourceBuffer&) = delete;
+		~SourceBuffer();
+
+		static Result<SourceBuffer> open(const std::string& filename);
+		static SourceBuffer from_string(std::string contents);
+
+		std::string_view view() const { return mapped ? std::string_view(data, size) : std::string_view(owned); }
+		bool is_mapped() const { return mapped; }
+	};
+} // namespace ArgonLang
+
+#endif // SOURCEBUFFER_H
@@ -0,0 +1,69 @@
+#ifndef TOKENSTREAM_H
+#define TOKENSTREAM_H
+
+#include <cstddef>
+#include <deque>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "backend/Tokenizer.h"
+
+namespace ArgonLang {
+	// TokenStream - the tokens a Parser reads, addressed by their index in the source.
+	// Over a string it tokenizes on demand: tokens are pulled from a Lexer a batch at a time as the parser looks
+	// ahead, and the ones before the parser's release point are dropped again. The retained window therefore
+	// holds the parser's lookahead (up to the matching ')' for lambda detection, the closing '>' for generic
+	// calls) plus one token behind the release point instead of the whole file. Over a vector of already
+	// tokenized input it is a plain view.
+	// References returned by at() stay valid until their token is released.
+	class TokenStream {
+	private:
+		const std::vector<Token>* source = nullptr;
+		std::optional<Lexer> lexer;
+		std::deque<Token> window; // Tokens [first, first + window.size())
+		// Index of the ')' closing each token of the window that is a '(', filled in as the ')' arrives
+		std::deque<size_t> closing;
+		std::vector<size_t> open_parens; // '(' still waiting for their ')'
+		std::vector<Token> batch;
+		size_t first = 0;
+		size_t release_point = 0;
+		size_t peak_window = 0;
+
+		// Pulls the next batch of tokens from the lexer; false once End has been produced
+		bool pull();
+		// Pairs up parentheses as tokens are appended, so finding a match never rescans the tokens in between
+		void match_parens(const Token& token, size_t index);
+
+	public:
+		// Tokens of input, which has to outlive the stream and the tokens read from it
+		explicit TokenStream(std::string_view input);
+		// View over tokens, which has to end with Token::End
+		explicit TokenStream(const std::vector<Token>& tokens);
+
+		TokenStream(const TokenStream&) = delete;
+		TokenStream& operator=(const TokenStream&) = delete;
+
+		// Whether there is a token at index, tokenizing up to it if needed
+		bool has(size_t index);
+		// Token at index; Token::End past the end of the input. index must not have been released.
+		const Token& at(size_t index);
+		// Tokens before index are no longer needed and may be dropped
+		void release_before(size_t index);
+		// Index of the ')' matching the '(' at index, tokenizing up to it if needed; the index of the End token
+		// when it is never closed. index must hold a '(' that has not been released.
+		size_t matching_paren(size_t index);
+
+		// A tokenizer error ends the stream early, as if the input stopped there
+		bool has_error() const { return lexer && lexer->has_error(); }
+		const std::string& get_error_message() const;
+		Token::Position get_error_position() const;
+
+		// Tokens produced so far and the largest number retained at once
+		size_t get_token_count() const;
+		size_t get_peak_window() const { return peak_window; }
+	};
+} // namespace ArgonLang
+
+#endif // TOKENSTREAM_H
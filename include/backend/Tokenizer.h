@@ -1,7 +1,10 @@
 #ifndef TOKENIZER_H
 #define TOKENIZER_H
 
+#include <cstdint>
+#include <deque>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 #include <unordered_map>
@@ -130,14 +133,26 @@ namespace ArgonLang {
 
 			End
 		} type;
-        std::string value;
 
+		// Packed into 32 bits so that it fits in the padding after the type; lines past 2^20 and columns past 2^12
+		// saturate at the largest value that fits
 		struct Position {
-			size_t line;
-			size_t column;
+			static constexpr size_t MAX_LINE = (size_t(1) << 20) - 1;
+			static constexpr size_t MAX_COLUMN = (size_t(1) << 12) - 1;
+
+			uint32_t line : 20;
+			uint32_t column : 12;
+
+			constexpr Position(size_t line = 0, size_t column = 0)
+			    : line(uint32_t(line < MAX_LINE ? line : MAX_LINE)),
+			      column(uint32_t(column < MAX_COLUMN ? column : MAX_COLUMN)) {}
 		} position;
 
-		explicit Token(Type t, std::string val, size_t line, size_t column);
+		// Slice of the tokenized source, or of the owning TokenizeResult for literals that had to be rewritten
+		// (escape sequences, digit separators); valid for as long as both of those are alive
+        std::string_view value;
+
+		explicit Token(Type t, std::string_view val, size_t line, size_t column);
 		explicit Token() = default;
 
         static std::string getTypeAsString(Token::Type type);
@@ -146,16 +161,57 @@ namespace ArgonLang {
     class TokenizeResult {
     public:
         std::vector<Token> tokens;
+        // Rewritten literal values the tokens refer to; a deque so that growing it never moves them
+        std::deque<std::string> owned_values;
         std::string error_msg;
         Token::Position error_position;
         
         bool has_error() const { return !error_msg.empty(); }
         
-        TokenizeResult(std::vector<Token> tokens) : tokens(std::move(tokens)), error_position{0, 0} {}
+        TokenizeResult(std::vector<Token> tokens, std::deque<std::string> owned_values = {})
+            : tokens(std::move(tokens)), owned_values(std::move(owned_values)), error_position{0, 0} {}
         TokenizeResult(std::string error, Token::Position pos) : error_msg(std::move(error)), error_position(pos) {}
+
+        // Tokens point into owned_values, so a copy would dangle once the original is gone
+        TokenizeResult(TokenizeResult&&) = default;
+        TokenizeResult& operator=(TokenizeResult&&) = default;
+        TokenizeResult(const TokenizeResult&) = delete;
+        TokenizeResult& operator=(const TokenizeResult&) = delete;
+    };
+
+    // Lexer - resumable tokenizer over input that produces tokens a batch at a time, so that a TokenStream can
+    // tokenize on demand. tokenize() runs a single one to the end.
+    class Lexer {
+    private:
+		std::string_view input;
+		size_t position = 0;
+		size_t line = 1;
+		size_t column = 1;
+		bool finished = false;
+		// Rewritten literal values the tokens refer to; a deque so that growing it never moves them
+		std::deque<std::string> owned_values;
+		std::string error_message;
+		Token::Position error_position{0, 0};
+
+		bool fail(std::string message, Token::Position position);
+
+    public:
+		explicit Lexer(std::string_view input);
+
+		// Appends count tokens to tokens, or all remaining ones followed by Token::End when fewer are left.
+		// Returns false once an error has been found; no tokens are produced after that.
+		bool lex(std::vector<Token>& tokens, size_t count);
+
+		bool is_finished() const { return finished; }
+		bool has_error() const { return !error_message.empty(); }
+		const std::string& get_error_message() const { return error_message; }
+		Token::Position get_error_position() const { return error_position; }
+		std::deque<std::string> take_owned_values() { return std::move(owned_values); }
     };
 
-    TokenizeResult tokenize(const std::string& input);
-    extern const std::unordered_map<std::string, Token::Type> keywords;
+    // Tokens are views into input, which must outlive them (and anything holding them, such as a Parser)
+    TokenizeResult tokenize(std::string_view input);
+    // Keyword or primitive type named by identifier, or Token::Identifier when it names neither
+    Token::Type keyword_type(std::string_view identifier);
 }
 #endif // TOKENIZER_H
\ No newline at end of file
@@ -0,0 +1,38 @@
+#ifndef ARGONLANG_CODEGENERATIONCACHE_H
+#define ARGONLANG_CODEGENERATIONCACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+namespace ArgonLang {
+	// CodeGenerationCache - generated C++ of top-level declarations from an earlier compilation, keyed by the
+	// declaration's token hash and everything else its code depends on (see CodeGenerationVisitor). Only the
+	// entries looked up or stored during this compilation are saved again, so the file tracks the current program.
+	class CodeGenerationCache {
+	private:
+		std::unordered_map<uint64_t, std::string> previous;
+		std::unordered_map<uint64_t, std::string> current;
+		std::size_t hit_count = 0;
+		std::size_t miss_count = 0;
+
+	public:
+		// Bumped whenever code generation changes, so that code from an older compiler is never reused
+		static constexpr uint32_t FORMAT_VERSION = 8;
+
+		// A missing, unreadable or outdated file gives an empty cache
+		static CodeGenerationCache load(const std::string& path);
+		// Writes to a temporary file renamed over path, so that an interrupted save leaves the old cache intact
+		bool save(const std::string& path) const;
+
+		// Code cached for key, or null; a hit is kept for the next save
+		const std::string* find(uint64_t key);
+		void store(uint64_t key, std::string code);
+
+		std::size_t hits() const { return hit_count; }
+		std::size_t misses() const { return miss_count; }
+	};
+}
+
+#endif // ARGONLANG_CODEGENERATIONCACHE_H
@@ -1,8 +1,11 @@
 
 #ifndef ARGONLANG_CODEGENERATIONSVISITOR_H
 #define ARGONLANG_CODEGENERATIONSVISITOR_H
+#include "frontend/CodeGenerationCache.h"
+#include "frontend/CodeSink.h"
 #include "frontend/Visitor.h"
 #include "Error/Result.h"
+#include <map>
 #include <set>
 
 namespace ArgonLang {
@@ -14,17 +17,34 @@ namespace ArgonLang {
 		~ScopedStatementContext() { ref = old; }
 	};
 
+	// The enums of a program, as a match sees them
+	struct MatchEnums {
+		// Enums declared without payloads, whose variants are C++ enumerators usable as case labels
+		std::set<std::string> simple;
+		// Variants of the enums generated as tagged unions, as Enum::Variant, with their field names in order
+		std::map<std::string, std::vector<std::string>> tagged;
+	};
+
 	class CodeGenerationVisitor: Visitor<Result<std::string>> {
 	public:
 		bool is_statement_context = false;
+		// Set when a par was emitted since the innermost enclosing block started
+		bool block_contains_par = false;
 		std::string current_class_name;
 	 	std::set<std::string> dependencies;
+		// When set, generate() reuses the code of top-level declarations that are unchanged since it was filled
+		// and records the code of the others
+		CodeGenerationCache* cache = nullptr;
 		Result<std::string> visit(const ASTNode& node) override;
 		Result<std::string> visit(const ExpressionNode& node) override;
 		Result<std::string> visit(const StatementNode& node) override;
 		Result<std::string> visit(const TypeNode& node) override;
 
 		Result<std::string> visit(const ProgramNode &node) override;
+		// Streams the program into out a top-level declaration at a time, so that only the declaration being
+		// generated is held in memory. With parallel, declarations are generated a window at a time on the runtime
+		// scheduler, each chunk by a visitor of its own, and written out in source order.
+		Result<void> generate(const ProgramNode& node, CodeSink& out, bool parallel = false);
 
 		Result<std::string> visit(const IntegralLiteralNode &node) override;
 		Result<std::string> visit(const FloatLiteralNode &node) override;
@@ -103,6 +123,59 @@ namespace ArgonLang {
 	private:
 		// Context flags
 		bool isConstraintContext = false;
+		bool isParallelContext = false;
+		bool isCalleeContext = false;
+		bool lowerFunctionTypeAsRef = false;
+		bool isRefAccessContext = false;
+		// Whether the function or lambda being generated has its return type deduced from its return statements
+		bool isDeducedReturnContext = false;
+
+		// Identifiers used as something other than a direct callee in the function body being generated;
+		// function-typed parameters absent from this set do not escape and are lowered to FunctionRef
+		std::set<std::string> escapingIdentifiers;
+		// Functions with a separate prototype keep std::function parameters so both signatures agree
+		std::set<std::string> prototypedFunctions;
+		MatchEnums enums;
+		// Identifiers used other than as the object of a member access or of *, in the block being generated; a ref
+		// the block declares and never names otherwise is never copied
+		std::set<std::string> copiedIdentifiers;
+		// Type of the value made by the ref(...) call being generated, when the declaration it initializes names it
+		std::string refValueType;
+		// Hash of enums, part of every cache key since any match may dispatch on one of them
+		uint64_t enumsHash = 0;
+		// Temporaries and anonymous types generated so far in the top-level declaration being generated, and what
+		// sets their names apart from those of other top-level declarations (see emit_declaration)
+		std::size_t generatedNames = 0;
+		std::string generatedNameTag;
+
+		Result<void> generate_parallel(const ProgramNode& node, CodeSink& out);
+		// Emits the top-level declaration at index, restarting the names generated for it
+		Result<void> emit_declaration(const ProgramNode& node, std::size_t index, std::string& out);
+		// A fresh name for a temporary or anonymous type, starting with base
+		std::string generated_name(const std::string& base);
+		const std::string* find_cached(const ProgramNode& node, std::size_t index);
+		void store_cached(const ProgramNode& node, std::size_t index, std::string code);
+		uint64_t declaration_key(const ProgramNode& node, std::size_t index) const;
+
+		// Append the code of a statement to out. Statements that nest other statements write their children into
+		// the same buffer, so a statement's code is copied once rather than once per enclosing level
+		Result<void> emit(const ASTNode& node, std::string& out);
+		Result<void> emit(const BlockNode& node, std::string& out);
+		Result<void> emit(const IfStatementNode& node, std::string& out);
+		Result<void> emit(const WhileStatementNode& node, std::string& out);
+		Result<void> emit(const ForStatementNode& node, std::string& out);
+		Result<void> emit(const FunctionDeclarationNode& node, std::string& out);
+
+		// Appends a match whose arms are integer, character or enumerator constants as a switch; false, with
+		// nothing appended, when some arm needs the if-chain
+		Result<bool> emit_switch_match(const MatchExpressionNode& node, const std::string& value, std::string& out);
+		// Appends a match with array or struct patterns as a decision tree; false, with nothing appended, when some
+		// arm has a pattern the tree cannot test
+		Result<bool> emit_decision_tree_match(const MatchExpressionNode& node, const std::string& value,
+		                                      std::string& out);
+
+		// Execution policy argument for runtime functional operators at the current call-site
+		std::string functionalPolicy() const;
 		
 		// Helper methods for generating destructuring assignments
 		Result<std::string> generateDestructuring(const PatternNode* pattern, const std::string& sourceVar);
@@ -0,0 +1,36 @@
+#ifndef ARGONLANG_CODESINK_H
+#define ARGONLANG_CODESINK_H
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace ArgonLang {
+	// CodeSink - append-only destination of generated code. With a stream it holds at most FLUSH_SIZE bytes before
+	// passing them on; without one it keeps everything written, for take().
+	class CodeSink {
+	private:
+		std::ostream* stream = nullptr;
+		std::string buffer;
+		std::size_t written = 0;
+
+	public:
+		static constexpr std::size_t FLUSH_SIZE = 64 * 1024;
+
+		CodeSink() = default;
+		explicit CodeSink(std::ostream& stream);
+		~CodeSink();
+		CodeSink(const CodeSink&) = delete;
+		CodeSink& operator=(const CodeSink&) = delete;
+
+		void write(std::string_view text);
+		void flush();
+
+		std::size_t bytes_written() const { return written; }
+		// Everything written so far; only meaningful for a sink without a stream
+		std::string take();
+	};
+}
+
+#endif // ARGONLANG_CODESINK_H
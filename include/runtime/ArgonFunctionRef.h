@@ -0,0 +1,61 @@
+#ifndef ARGON_FUNCTION_REF_H
+#define ARGON_FUNCTION_REF_H
+
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace ArgonLang {
+namespace Runtime {
+
+template<typename Signature>
+class FunctionRef;
+
+// FunctionRef - non-owning, non-allocating reference to a callable (lowering of function-typed parameters that
+// do not escape the function). Two words: the callable's address and a trampoline that invokes it. The
+// referenced callable must outlive the FunctionRef, which holds for arguments of the current call.
+template<typename R, typename... Args>
+class FunctionRef<R(Args...)> {
+private:
+	union Target {
+		void* object;
+		void (*function)();
+	};
+
+	Target target_;
+	R (*invoke_)(Target, Args...);
+
+public:
+	template<typename F>
+	    requires(!std::is_same_v<std::remove_cvref_t<F>, FunctionRef> && std::is_invocable_r_v<R, F&, Args...>)
+	FunctionRef(F&& callable) noexcept {
+		using Callable = std::remove_reference_t<F>;
+		if constexpr (std::is_function_v<Callable>) {
+			target_.function = reinterpret_cast<void (*)()>(&callable);
+			invoke_ = [](Target target, Args... args) -> R {
+				return std::invoke(reinterpret_cast<Callable*>(target.function), std::forward<Args>(args)...);
+			};
+		} else if constexpr (std::is_pointer_v<std::remove_cv_t<Callable>> &&
+		                     std::is_function_v<std::remove_pointer_t<std::remove_cv_t<Callable>>>) {
+			// Function pointers are stored by value so a temporary pointer does not dangle
+			target_.function = reinterpret_cast<void (*)()>(callable);
+			invoke_ = [](Target target, Args... args) -> R {
+				return std::invoke(reinterpret_cast<std::remove_cv_t<Callable>>(target.function),
+				                   std::forward<Args>(args)...);
+			};
+		} else {
+			target_.object = const_cast<void*>(static_cast<const void*>(std::addressof(callable)));
+			invoke_ = [](Target target, Args... args) -> R {
+				return std::invoke(*static_cast<Callable*>(target.object), std::forward<Args>(args)...);
+			};
+		}
+	}
+
+	R operator()(Args... args) const { return invoke_(target_, std::forward<Args>(args)...); }
+};
+
+} // namespace Runtime
+} // namespace ArgonLang
+
+#endif // ARGON_FUNCTION_REF_H
@@ -0,0 +1,301 @@
+#ifndef ARGON_PARALLEL_H
+#define ARGON_PARALLEL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <numeric>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "runtime/ArgonScheduler.h"
+
+namespace ArgonLang {
+namespace Runtime {
+
+// ExecutionPolicy - how a functional operator (|, &, ?, ||>) runs at a call-site.
+// Generated code uses Parallel inside par and Sequential elsewhere. Auto goes parallel once the operand reaches
+// parallel_threshold() elements, for runtime callers whose callables are safe to run concurrently.
+enum class ExecutionPolicy { Sequential, Parallel, Auto };
+
+// Element count from which Auto call-sites run in parallel
+std::size_t parallel_threshold() noexcept;
+void set_parallel_threshold(std::size_t threshold) noexcept;
+
+namespace detail {
+
+// Smallest chunk worth a task of its own
+constexpr std::size_t MIN_CHUNK_SIZE = 1024;
+
+// Chunks per worker, so that uneven chunks can be balanced by stealing
+constexpr std::size_t CHUNKS_PER_WORKER = 4;
+
+// Containers the parallel paths can split by index and size up front
+template<typename Container>
+concept ChunkableContainer = std::ranges::random_access_range<Container> && std::ranges::sized_range<Container> &&
+                             std::is_default_constructible_v<std::ranges::range_value_t<Container>> &&
+                             requires(std::decay_t<Container>& result, std::size_t count) { result.resize(count); };
+
+// Lazy ranges such as the pipelines of | and &, which produce their elements on demand and hold none to update
+template<typename Range>
+concept LazyRange = requires(const std::remove_cvref_t<Range>& range) { range.to_vector(); };
+
+inline std::size_t chunk_count_for(std::size_t count) {
+	std::size_t by_size = (count + MIN_CHUNK_SIZE - 1) / MIN_CHUNK_SIZE;
+	std::size_t by_workers = Scheduler::instance().worker_count() * CHUNKS_PER_WORKER;
+	return std::max<std::size_t>(1, std::min(by_size, by_workers));
+}
+
+inline bool should_parallelize(ExecutionPolicy policy, std::size_t count) {
+	switch (policy) {
+	case ExecutionPolicy::Sequential:
+		return false;
+	case ExecutionPolicy::Parallel:
+		return count > 1 && Scheduler::instance().worker_count() > 1;
+	case ExecutionPolicy::Auto:
+		return count >= parallel_threshold() && Scheduler::instance().worker_count() > 1;
+	}
+	return false;
+}
+
+// ChunkTask - runs body(chunk, begin, end) for one chunk of a parallel_chunks call
+template<typename Body>
+class ChunkTask final : public Task {
+private:
+	Body& body_;
+	std::size_t chunk_;
+	std::size_t begin_;
+	std::size_t end_;
+	std::exception_ptr error_;
+
+public:
+	ChunkTask(Body& body, std::size_t chunk, std::size_t begin, std::size_t end)
+	    : body_(body), chunk_(chunk), begin_(begin), end_(end) {}
+
+	const std::exception_ptr& error() const noexcept { return error_; }
+
+protected:
+	void execute() noexcept override {
+		try {
+			body_(chunk_, begin_, end_);
+		} catch (...) {
+			error_ = std::current_exception();
+		}
+	}
+};
+
+// Splits [0, count) into chunk_count contiguous chunks and runs body(chunk, begin, end) for each of them on
+// the scheduler. The calling thread runs the first chunk itself and then helps until all chunks are done;
+// the first exception thrown by any chunk is rethrown afterwards.
+template<typename Body>
+void parallel_chunks(std::size_t count, std::size_t chunk_count, Body& body) {
+	Scheduler& scheduler = Scheduler::instance();
+	auto chunk_begin = [&](std::size_t chunk) { return count * chunk / chunk_count; };
+
+	std::vector<TaskRef<ChunkTask<Body>>> tasks;
+	tasks.reserve(chunk_count - 1);
+	for (std::size_t chunk = 1; chunk < chunk_count; ++chunk) {
+		auto* task = new ChunkTask<Body>(body, chunk, chunk_begin(chunk), chunk_begin(chunk + 1));
+		tasks.emplace_back(task);
+		task->retain(); // Reference owned by the scheduler until the chunk has run
+		scheduler.submit(task);
+	}
+
+	std::exception_ptr error;
+	try {
+		body(std::size_t{0}, std::size_t{0}, chunk_begin(1));
+	} catch (...) {
+		error = std::current_exception();
+	}
+
+	// Chunks reference body, so every one of them must finish even when another has thrown
+	for (auto& task : tasks) {
+		scheduler.help_until_done(*task);
+		if (!error && task->error()) {
+			error = task->error();
+		}
+	}
+	if (error) {
+		std::rethrow_exception(error);
+	}
+}
+
+// Folds each chunk of [0, count) on the scheduler through fold_chunk(accumulator, begin, end), into an accumulator
+// of its own seeded with identity, and combines the partial results with combine in chunk order
+template<typename T, typename FoldChunk, typename Combine>
+T parallel_fold(std::size_t count, const T& identity, FoldChunk&& fold_chunk, Combine&& combine) {
+	std::size_t chunk_count = chunk_count_for(count);
+	std::vector<T> partials(chunk_count, identity);
+	auto fold = [&](std::size_t chunk, std::size_t begin, std::size_t end) { fold_chunk(partials[chunk], begin, end); };
+	parallel_chunks(count, chunk_count, fold);
+
+	for (std::size_t stride = 1; stride < chunk_count; stride *= 2) {
+		for (std::size_t i = 0; i + stride < chunk_count; i += 2 * stride) {
+			partials[i] = combine(std::move(partials[i]), std::move(partials[i + stride]));
+		}
+	}
+	return std::move(partials[0]);
+}
+
+} // namespace detail
+
+// Filter utility: container | predicate.
+// The parallel path evaluates the predicate once per element, counts survivors per chunk and compacts them
+// into the result at offsets given by a prefix sum of those counts, so element order is preserved.
+template<typename Container, typename Predicate>
+std::decay_t<Container> filter(ExecutionPolicy policy, Container&& container, Predicate&& predicate) {
+	using Result = std::decay_t<Container>;
+
+	if constexpr (detail::ChunkableContainer<Container>) {
+		std::size_t count = std::ranges::size(container);
+		if (detail::should_parallelize(policy, count)) {
+			std::size_t chunk_count = detail::chunk_count_for(count);
+			std::vector<unsigned char> keep(count);
+			std::vector<std::size_t> offsets(chunk_count + 1, 0);
+
+			auto mark = [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+				std::size_t kept = 0;
+				for (std::size_t i = begin; i < end; ++i) {
+					keep[i] = predicate(container[i]) ? 1 : 0;
+					kept += keep[i];
+				}
+				offsets[chunk + 1] = kept;
+			};
+			detail::parallel_chunks(count, chunk_count, mark);
+
+			std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+			Result result;
+			result.resize(offsets.back());
+			auto compact = [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+				std::size_t out = offsets[chunk];
+				for (std::size_t i = begin; i < end; ++i) {
+					if (!keep[i]) {
+						continue;
+					}
+					if constexpr (std::is_lvalue_reference_v<Container>) {
+						result[out++] = container[i];
+					} else {
+						result[out++] = std::move(container[i]);
+					}
+				}
+			};
+			detail::parallel_chunks(count, chunk_count, compact);
+			return result;
+		}
+	}
+
+	Result result{};
+	std::copy_if(container.begin(), container.end(), std::back_inserter(result), predicate);
+	return result;
+}
+
+// Map utility: container & transform
+template<typename Container, typename Transform>
+std::decay_t<Container> map(ExecutionPolicy policy, Container&& container, Transform&& transform) {
+	using Result = std::decay_t<Container>;
+
+	if constexpr (detail::ChunkableContainer<Container>) {
+		std::size_t count = std::ranges::size(container);
+		if (detail::should_parallelize(policy, count)) {
+			Result result;
+			result.resize(count);
+			auto apply = [&](std::size_t, std::size_t begin, std::size_t end) {
+				for (std::size_t i = begin; i < end; ++i) {
+					result[i] = transform(container[i]);
+				}
+			};
+			detail::parallel_chunks(count, detail::chunk_count_for(count), apply);
+			return result;
+		}
+	}
+
+	Result result{};
+	std::transform(container.begin(), container.end(), std::back_inserter(result), transform);
+	return result;
+}
+
+// Reduce utility: container ? reducer.
+// A left fold of reducer(accumulator, element) from a value-initialized accumulator. Nothing makes reducer
+// associative, so it runs in order on the calling thread under every policy.
+template<typename Container, typename Reducer>
+typename std::decay_t<Container>::value_type reduce(ExecutionPolicy policy, Container&& container,
+                                                    Reducer&& reducer) {
+	using ValueType = typename std::decay_t<Container>::value_type;
+
+	if constexpr (requires { container.reduce(policy, reducer); }) {
+		// Lazy pipelines fold their fused stages themselves
+		return container.reduce(policy, reducer);
+	} else {
+		return std::accumulate(container.begin(), container.end(), ValueType{}, reducer);
+	}
+}
+
+// Reduce with a separate combine: the parallel path folds each chunk with reducer from identity and combines the
+// partial results pairwise in a tree, keeping the left-to-right operand order. It matches the sequential fold when
+// combine is associative with identity as its neutral element and combine(a, reducer(identity, x)) == reducer(a, x).
+template<typename Container, typename T, typename Reducer, typename Combine>
+T reduce(ExecutionPolicy policy, Container&& container, T identity, Reducer&& reducer, Combine&& combine) {
+	if constexpr (requires { container.reduce(policy, identity, reducer, combine); }) {
+		return container.reduce(policy, std::move(identity), reducer, combine);
+	} else {
+		if constexpr (detail::ChunkableContainer<Container>) {
+			std::size_t count = std::ranges::size(container);
+			if (detail::should_parallelize(policy, count)) {
+				auto fold = [&](T& accumulator, std::size_t begin, std::size_t end) {
+					for (std::size_t i = begin; i < end; ++i) {
+						accumulator = reducer(std::move(accumulator), container[i]);
+					}
+				};
+				return detail::parallel_fold(count, identity, fold, combine);
+			}
+		}
+
+		return std::accumulate(container.begin(), container.end(), std::move(identity), reducer);
+	}
+}
+
+// Map-pipe utility: container ||> transform (in-place transformation)
+template<typename Container, typename Transform>
+    requires(!detail::LazyRange<Container>)
+Container& map_pipe(ExecutionPolicy policy, Container& container, Transform&& transform) {
+	if constexpr (detail::ChunkableContainer<Container>) {
+		std::size_t count = std::ranges::size(container);
+		if (detail::should_parallelize(policy, count)) {
+			auto apply = [&](std::size_t, std::size_t begin, std::size_t end) {
+				for (std::size_t i = begin; i < end; ++i) {
+					container[i] = transform(container[i]);
+				}
+			};
+			detail::parallel_chunks(count, detail::chunk_count_for(count), apply);
+			return container;
+		}
+	}
+
+	std::transform(container.begin(), container.end(), container.begin(), transform);
+	return container;
+}
+
+// Map-pipe over a temporary or a lazy pipeline: there is nothing to update in place, so the elements are moved or
+// materialised into a container of their own, which is transformed and returned
+template<typename Container, typename Transform>
+    requires(detail::LazyRange<Container> || !std::is_lvalue_reference_v<Container>)
+auto map_pipe(ExecutionPolicy policy, Container&& container, Transform&& transform) {
+	auto result = [&] {
+		if constexpr (detail::LazyRange<Container>) {
+			return container.to_vector(policy);
+		} else {
+			return std::move(container);
+		}
+	}();
+	map_pipe(policy, result, std::forward<Transform>(transform));
+	return result;
+}
+
+} // namespace Runtime
+} // namespace ArgonLang
+
+#endif // ARGON_PARALLEL_H
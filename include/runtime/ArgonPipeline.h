@@ -0,0 +1,358 @@
+#ifndef ARGON_PIPELINE_H
+#define ARGON_PIPELINE_H
+
+#include <cstddef>
+#include <iterator>
+#include <numeric>
+#include <optional>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "runtime/ArgonParallel.h"
+
+namespace ArgonLang {
+namespace Runtime {
+
+namespace detail {
+
+// Pipeline stages are push-based: push(value, sink) hands the stage output to sink, or nothing when a filter
+// drops the value. A chain of stages is a nest of these calls that the compiler flattens into one loop body.
+// Sinks return false to stop the traversal early.
+
+struct IdentityStage {
+	template<typename In>
+	using output_t = In;
+
+	template<typename T, typename Sink>
+	bool push(T&& value, Sink&& sink) const {
+		return sink(std::forward<T>(value));
+	}
+};
+
+template<typename Prev, typename Predicate>
+struct FilterStage {
+	Prev prev;
+	Predicate predicate;
+
+	template<typename In>
+	using output_t = typename Prev::template output_t<In>;
+
+	template<typename T, typename Sink>
+	bool push(T&& value, Sink&& sink) const {
+		return prev.push(std::forward<T>(value), [&](auto&& element) -> bool {
+			if (!predicate(element)) {
+				return true;
+			}
+			return sink(std::forward<decltype(element)>(element));
+		});
+	}
+};
+
+template<typename Prev, typename Transform>
+struct MapStage {
+	Prev prev;
+	Transform transform;
+
+	template<typename In>
+	using output_t = std::invoke_result_t<const Transform&, typename Prev::template output_t<In>>;
+
+	template<typename T, typename Sink>
+	bool push(T&& value, Sink&& sink) const {
+		return prev.push(std::forward<T>(value), [&](auto&& element) -> bool {
+			return sink(transform(std::forward<decltype(element)>(element)));
+		});
+	}
+};
+
+} // namespace detail
+
+// Pipeline - lazy, fused chain of filter/map stages over a source range (lowering of | and &).
+// Nothing runs until the pipeline is materialised by reduce, indexing, take, iteration or conversion to a
+// vector; each source element then flows through every stage in a single pass without intermediate
+// containers. Lvalue sources are referenced and must outlive the pipeline, rvalue sources are moved in.
+template<typename Source, typename Stages>
+class Pipeline {
+public:
+	using source_type = std::remove_reference_t<Source>;
+	using source_reference = std::ranges::range_reference_t<const source_type>;
+	using value_type = std::remove_cvref_t<typename Stages::template output_t<source_reference>>;
+
+private:
+	Source source_;
+	Stages stages_;
+	ExecutionPolicy policy_;
+
+	template<typename, typename>
+	friend class Pipeline;
+
+	static constexpr bool indexable_source =
+	    std::ranges::random_access_range<const source_type> && std::ranges::sized_range<const source_type>;
+
+	// Pushes the source elements in [begin, end) through the stages (indexable sources only)
+	template<typename Sink>
+	bool push_range(std::size_t begin, std::size_t end, Sink&& sink) const {
+		auto first = std::ranges::begin(source_);
+		for (std::size_t i = begin; i < end; ++i) {
+			if (!stages_.push(first[i], sink)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+public:
+	template<typename S, typename St>
+	Pipeline(S&& source, St&& stages, ExecutionPolicy policy)
+	    : source_(std::forward<S>(source)), stages_(std::forward<St>(stages)), policy_(policy) {}
+
+	ExecutionPolicy policy() const noexcept { return policy_; }
+
+	// Appends a stage; the source is shared with (lvalue) or moved out of (rvalue) this pipeline.
+	// A Parallel call-site anywhere in the chain makes the whole pipeline materialise in parallel.
+	template<typename Predicate>
+	auto filtered(Predicate&& predicate, ExecutionPolicy policy) const& {
+		using Stage = detail::FilterStage<Stages, std::decay_t<Predicate>>;
+		return Pipeline<Source, Stage>(source_, Stage{stages_, std::forward<Predicate>(predicate)},
+		                               combine_policy(policy));
+	}
+
+	template<typename Predicate>
+	auto filtered(Predicate&& predicate, ExecutionPolicy policy) && {
+		using Stage = detail::FilterStage<Stages, std::decay_t<Predicate>>;
+		return Pipeline<Source, Stage>(std::forward<Source>(source_),
+		                               Stage{std::move(stages_), std::forward<Predicate>(predicate)},
+		                               combine_policy(policy));
+	}
+
+	template<typename Transform>
+	auto mapped(Transform&& transform, ExecutionPolicy policy) const& {
+		using Stage = detail::MapStage<Stages, std::decay_t<Transform>>;
+		return Pipeline<Source, Stage>(source_, Stage{stages_, std::forward<Transform>(transform)},
+		                               combine_policy(policy));
+	}
+
+	template<typename Transform>
+	auto mapped(Transform&& transform, ExecutionPolicy policy) && {
+		using Stage = detail::MapStage<Stages, std::decay_t<Transform>>;
+		return Pipeline<Source, Stage>(std::forward<Source>(source_),
+		                               Stage{std::move(stages_), std::forward<Transform>(transform)},
+		                               combine_policy(policy));
+	}
+
+	// Feeds every output element to sink in order; returns false if sink stopped the traversal
+	template<typename Sink>
+	bool for_each(Sink&& sink) const {
+		for (auto&& element : source_) {
+			if (!stages_.push(std::forward<decltype(element)>(element), sink)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// Materialises the pipeline. The parallel path runs the fused stages per chunk of the source into
+	// per-chunk buffers and concatenates them in chunk order.
+	std::vector<value_type> to_vector(ExecutionPolicy policy) const {
+		std::vector<value_type> result;
+		if constexpr (indexable_source) {
+			std::size_t count = std::ranges::size(source_);
+			if (detail::should_parallelize(policy, count)) {
+				std::size_t chunk_count = detail::chunk_count_for(count);
+				std::vector<std::vector<value_type>> chunks(chunk_count);
+				auto collect = [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+					push_range(begin, end, [&](auto&& element) {
+						chunks[chunk].emplace_back(std::forward<decltype(element)>(element));
+						return true;
+					});
+				};
+				detail::parallel_chunks(count, chunk_count, collect);
+
+				std::size_t total = 0;
+				for (const auto& chunk : chunks) {
+					total += chunk.size();
+				}
+				result.reserve(total);
+				for (auto& chunk : chunks) {
+					std::move(chunk.begin(), chunk.end(), std::back_inserter(result));
+				}
+				return result;
+			}
+		}
+		for_each([&](auto&& element) {
+			result.emplace_back(std::forward<decltype(element)>(element));
+			return true;
+		});
+		return result;
+	}
+
+	std::vector<value_type> to_vector() const { return to_vector(policy_); }
+
+	// vec<T> binding
+	template<typename T, typename Allocator>
+	operator std::vector<T, Allocator>() const {
+		if constexpr (std::is_same_v<std::vector<T, Allocator>, std::vector<value_type>>) {
+			return to_vector();
+		} else {
+			std::vector<T, Allocator> result;
+			for_each([&](auto&& element) {
+				result.emplace_back(std::forward<decltype(element)>(element));
+				return true;
+			});
+			return result;
+		}
+	}
+
+	// First n output elements; stops pulling from the source once they have been produced
+	std::vector<value_type> take(std::size_t n) const {
+		std::vector<value_type> result;
+		if (n == 0) {
+			return result;
+		}
+		for_each([&](auto&& element) {
+			result.emplace_back(std::forward<decltype(element)>(element));
+			return result.size() < n;
+		});
+		return result;
+	}
+
+	// Element at output position index; evaluates the pipeline only up to that element
+	value_type operator[](std::size_t index) const {
+		std::optional<value_type> found;
+		std::size_t position = 0;
+		for_each([&](auto&& element) {
+			if (position++ == index) {
+				found.emplace(std::forward<decltype(element)>(element));
+				return false;
+			}
+			return true;
+		});
+		if (!found) {
+			throw std::out_of_range("pipeline index out of range");
+		}
+		return std::move(*found);
+	}
+
+	// Reduce utility: pipeline ? reducer.
+	// Folds the fused stages directly over the source, in order like the reduce of a container, whatever the policy.
+	template<typename Reducer>
+	value_type reduce(ExecutionPolicy, Reducer&& reducer) const {
+		return reduce(ExecutionPolicy::Sequential, value_type{}, reducer, reducer);
+	}
+
+	// Reduce with a separate combine, under the same conditions as the reduce of a container; each chunk of the
+	// source folds into its own accumulator, even when its elements are all filtered out.
+	template<typename T, typename Reducer, typename Combine>
+	T reduce(ExecutionPolicy policy, T identity, Reducer&& reducer, Combine&& combine) const {
+		if constexpr (indexable_source) {
+			std::size_t count = std::ranges::size(source_);
+			if (detail::should_parallelize(combine_policy(policy), count)) {
+				auto fold = [&](T& accumulator, std::size_t begin, std::size_t end) {
+					push_range(begin, end, [&](auto&& element) {
+						accumulator = reducer(std::move(accumulator), std::forward<decltype(element)>(element));
+						return true;
+					});
+				};
+				return detail::parallel_fold(count, identity, fold, combine);
+			}
+		}
+
+		T accumulator = std::move(identity);
+		for_each([&](auto&& element) {
+			accumulator = reducer(std::move(accumulator), std::forward<decltype(element)>(element));
+			return true;
+		});
+		return accumulator;
+	}
+
+	// Single-pass input iteration (for loops over a pipeline)
+	class Iterator {
+	public:
+		using value_type = Pipeline::value_type;
+		using difference_type = std::ptrdiff_t;
+
+	private:
+		const Pipeline* pipeline_ = nullptr;
+		std::ranges::iterator_t<const source_type> current_;
+		std::optional<value_type> value_;
+
+		void advance() {
+			value_.reset();
+			auto end = std::ranges::end(pipeline_->source_);
+			while (!value_ && current_ != end) {
+				pipeline_->stages_.push(*current_, [&](auto&& element) {
+					value_.emplace(std::forward<decltype(element)>(element));
+					return true;
+				});
+				++current_;
+			}
+		}
+
+	public:
+		Iterator() = default;
+
+		explicit Iterator(const Pipeline& pipeline)
+		    : pipeline_(&pipeline), current_(std::ranges::begin(pipeline.source_)) {
+			advance();
+		}
+
+		const value_type& operator*() const { return *value_; }
+
+		Iterator& operator++() {
+			advance();
+			return *this;
+		}
+
+		void operator++(int) { advance(); }
+
+		bool operator==(std::default_sentinel_t) const { return !value_; }
+	};
+
+	Iterator begin() const { return Iterator(*this); }
+	std::default_sentinel_t end() const { return std::default_sentinel; }
+
+private:
+	ExecutionPolicy combine_policy(ExecutionPolicy policy) const noexcept {
+		return policy_ == ExecutionPolicy::Parallel ? policy_ : policy;
+	}
+};
+
+template<typename>
+struct is_pipeline : std::false_type {};
+
+template<typename Source, typename Stages>
+struct is_pipeline<Pipeline<Source, Stages>> : std::true_type {};
+
+template<typename T>
+inline constexpr bool is_pipeline_v = is_pipeline<std::remove_cvref_t<T>>::value;
+
+// Lazy filter: source | predicate. Extends an existing pipeline instead of nesting a new one.
+template<typename Range, typename Predicate>
+auto lazy_filter(ExecutionPolicy policy, Range&& source, Predicate&& predicate) {
+	if constexpr (is_pipeline_v<Range>) {
+		return std::forward<Range>(source).filtered(std::forward<Predicate>(predicate), policy);
+	} else {
+		using Stage = detail::FilterStage<detail::IdentityStage, std::decay_t<Predicate>>;
+		return Pipeline<Range, Stage>(std::forward<Range>(source), Stage{{}, std::forward<Predicate>(predicate)},
+		                              policy);
+	}
+}
+
+// Lazy map: source & transform
+template<typename Range, typename Transform>
+auto lazy_map(ExecutionPolicy policy, Range&& source, Transform&& transform) {
+	if constexpr (is_pipeline_v<Range>) {
+		return std::forward<Range>(source).mapped(std::forward<Transform>(transform), policy);
+	} else {
+		using Stage = detail::MapStage<detail::IdentityStage, std::decay_t<Transform>>;
+		return Pipeline<Range, Stage>(std::forward<Range>(source), Stage{{}, std::forward<Transform>(transform)},
+		                              policy);
+	}
+}
+
+} // namespace Runtime
+} // namespace ArgonLang
+
+#endif // ARGON_PIPELINE_H
@@ -0,0 +1,217 @@
+#ifndef ARGON_REF_H
+#define ARGON_REF_H
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace ArgonLang {
+namespace Runtime {
+
+// Counts in front of the value of a ref, in the same allocation. Any copy of a ref may be made or dropped on another
+// thread, so they are updated atomically. Local counts are plain integers instead; code generation asks for them
+// only for a ref that the block declaring it never copies, whose counts then change only on that thread.
+struct RefCounts {
+	// Strong references; the value is destroyed when the last one goes
+	uint32_t strong = 1;
+	// Weak references, plus one held by all strong references together; the allocation is freed when it drops to 0
+	uint32_t weak = 1;
+	// Fixed when the value is made, see make_local_ref
+	bool local = false;
+
+	void retain(uint32_t& count) noexcept {
+		if (local) {
+			++count;
+		} else {
+			std::atomic_ref<uint32_t>(count).fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	// Whether this was the last reference counted by count
+	bool release(uint32_t& count) noexcept {
+		if (local) {
+			return --count == 0;
+		}
+		return std::atomic_ref<uint32_t>(count).fetch_sub(1, std::memory_order_acq_rel) == 1;
+	}
+
+	uint32_t load(uint32_t& count) const noexcept {
+		return local ? count : std::atomic_ref<uint32_t>(count).load(std::memory_order_relaxed);
+	}
+
+	// Takes a strong reference unless the value is already destroyed
+	bool retain_if_alive() noexcept {
+		if (local) {
+			if (strong == 0) {
+				return false;
+			}
+			++strong;
+			return true;
+		}
+		std::atomic_ref<uint32_t> count(strong);
+		uint32_t current = count.load(std::memory_order_relaxed);
+		while (current != 0) {
+			if (count.compare_exchange_weak(current, current + 1, std::memory_order_relaxed)) {
+				return true;
+			}
+		}
+		return false;
+	}
+};
+
+template<typename T>
+struct RefBox {
+	RefCounts counts;
+	// In a union so that the value can be destroyed while weak references keep the allocation
+	union {
+		T value;
+	};
+
+	template<typename... Args>
+	explicit RefBox(Args&&... args) : value(std::forward<Args>(args)...) {}
+	~RefBox() {}
+};
+
+template<typename T>
+class Weak;
+
+// Selects local counts when constructing a Ref
+struct LocalCounts {
+	explicit LocalCounts() = default;
+};
+
+// Ref - lowering of ref<T>: a reference counted value, one pointer wide, whose counts live in the same allocation
+// as the value. A null Ref is the only empty state, so no separate flag is needed to represent the absence of a
+// value.
+template<typename T>
+class Ref {
+private:
+	RefBox<T>* box_ = nullptr;
+
+	explicit Ref(RefBox<T>* box) noexcept : box_(box) {}
+
+	friend class Weak<T>;
+
+public:
+	Ref() noexcept = default;
+
+	// Allocates the counts and a value constructed from args together
+	template<typename... Args>
+	explicit Ref(std::in_place_t, Args&&... args) : box_(new RefBox<T>(std::forward<Args>(args)...)) {}
+
+	// As above, with local counts
+	template<typename... Args>
+	explicit Ref(LocalCounts, Args&&... args) : Ref(std::in_place, std::forward<Args>(args)...) {
+		box_->counts.local = true;
+	}
+
+	Ref(const Ref& other) noexcept : box_(other.box_) {
+		if (box_ != nullptr) {
+			box_->counts.retain(box_->counts.strong);
+		}
+	}
+
+	Ref(Ref&& other) noexcept : box_(std::exchange(other.box_, nullptr)) {}
+
+	Ref& operator=(Ref other) noexcept {
+		std::swap(box_, other.box_);
+		return *this;
+	}
+
+	~Ref() {
+		if (box_ == nullptr || !box_->counts.release(box_->counts.strong)) {
+			return;
+		}
+		box_->value.~T();
+		if (box_->counts.release(box_->counts.weak)) {
+			delete box_;
+		}
+	}
+
+	T& operator*() const noexcept { return box_->value; }
+	T* operator->() const noexcept { return &box_->value; }
+	T* get() const noexcept { return box_ != nullptr ? &box_->value : nullptr; }
+	explicit operator bool() const noexcept { return box_ != nullptr; }
+
+	uint32_t use_count() const noexcept { return box_ != nullptr ? box_->counts.load(box_->counts.strong) : 0; }
+
+	// Whether the counts are plain integers rather than updated atomically
+	bool is_local() const noexcept { return box_ != nullptr && box_->counts.local; }
+
+	friend bool operator==(const Ref& left, const Ref& right) noexcept { return left.box_ == right.box_; }
+};
+
+// Weak - lowering of weak<T>: one pointer to the allocation of a Ref, keeping the counts alive but not the value
+template<typename T>
+class Weak {
+private:
+	RefBox<T>* box_ = nullptr;
+
+public:
+	Weak() noexcept = default;
+
+	Weak(const Ref<T>& ref) noexcept : box_(ref.box_) {
+		if (box_ != nullptr) {
+			box_->counts.retain(box_->counts.weak);
+		}
+	}
+
+	Weak(const Weak& other) noexcept : box_(other.box_) {
+		if (box_ != nullptr) {
+			box_->counts.retain(box_->counts.weak);
+		}
+	}
+
+	Weak(Weak&& other) noexcept : box_(std::exchange(other.box_, nullptr)) {}
+
+	Weak& operator=(Weak other) noexcept {
+		std::swap(box_, other.box_);
+		return *this;
+	}
+
+	~Weak() {
+		if (box_ != nullptr && box_->counts.release(box_->counts.weak)) {
+			delete box_;
+		}
+	}
+
+	// A strong reference to the value, or a null Ref when it is already destroyed
+	Ref<T> lock() const noexcept {
+		if (box_ != nullptr && box_->counts.retain_if_alive()) {
+			return Ref<T>(box_);
+		}
+		return Ref<T>();
+	}
+
+	bool expired() const noexcept { return box_ == nullptr || box_->counts.load(box_->counts.strong) == 0; }
+};
+
+namespace detail {
+template<typename T, typename Construct, typename... Args>
+auto make_ref_as(Construct construct, Args&&... args) {
+	if constexpr (std::is_void_v<T>) {
+		static_assert(sizeof...(Args) == 1, "the type of a ref made from several arguments must be given");
+		return Ref<std::decay_t<Args>...>(construct, std::forward<Args>(args)...);
+	} else {
+		return Ref<T>(construct, std::forward<Args>(args)...);
+	}
+}
+} // namespace detail
+
+// Lowering of ref(args...): the type is deduced from a single argument when it is not given
+template<typename T = void, typename... Args>
+auto make_ref(Args&&... args) {
+	return detail::make_ref_as<T>(std::in_place, std::forward<Args>(args)...);
+}
+
+// Lowering of ref(args...) for a ref whose copies all stay on the thread that made it
+template<typename T = void, typename... Args>
+auto make_local_ref(Args&&... args) {
+	return detail::make_ref_as<T>(LocalCounts{}, std::forward<Args>(args)...);
+}
+
+} // namespace Runtime
+} // namespace ArgonLang
+
+#endif // ARGON_REF_H
@@ -12,7 +12,18 @@
 #include <istream>
 #include <string>
 #include <cmath>
+#include <concepts>
+#include <stdexcept>
+#include <exception>
+#include <optional>
 #include <stdfloat>
+#include <type_traits>
+
+#include "runtime/ArgonFunctionRef.h"
+#include "runtime/ArgonRef.h"
+#include "runtime/ArgonParallel.h"
+#include "runtime/ArgonPipeline.h"
+#include "runtime/ArgonScheduler.h"
 
 // ===== ARGONLANG TYPE SYSTEM =====
 namespace ArgonLang {
@@ -32,26 +43,59 @@ namespace Runtime {
     #define F128 std::float128_t
 
     #define STR std::string
-    // Custom 128-bit integer class (using two 64-bit values for compatibility)
+    // ARGON_HAS_INT128 - 1 when the compiler has a native 128-bit integer (GCC/Clang on 64-bit targets).
+    // I128/U128 then wrap __int128 and their operators are inline; otherwise they fall back to a two-word
+    // implementation in ArgonRuntime.cpp. Can be predefined to 0 to force the portable path.
+    #ifndef ARGON_HAS_INT128
+        #if defined(__SIZEOF_INT128__)
+            #define ARGON_HAS_INT128 1
+        #else
+            #define ARGON_HAS_INT128 0
+        #endif
+    #endif
+
+    class U128;
+
+    // Custom 128-bit integer class
     class I128 {
     private:
+    #if ARGON_HAS_INT128
+        __int128 value;
+    #else
         I64 high;  // High 64 bits (signed)
         U64 low;   // Low 64 bits (unsigned)
+    #endif
 
     public:
         // Constructors
+    #if ARGON_HAS_INT128
+        constexpr I128() : value(0) {}
+        constexpr I128(I64 h, U64 l)
+            : value(static_cast<__int128>((static_cast<unsigned __int128>(static_cast<U64>(h)) << 64) | l)) {}
+        template<std::integral T>
+        constexpr I128(T v) : value(static_cast<__int128>(v)) {}
+        constexpr explicit I128(__int128 v) : value(v) {}
+
+        constexpr __int128 native() const { return value; }
+        constexpr I64 high_word() const { return static_cast<I64>(value >> 64); }
+        constexpr U64 low_word() const { return static_cast<U64>(value); }
+    #else
         constexpr I128() : high(0), low(0) {}
         constexpr I128(I64 h, U64 l) : high(h), low(l) {}
-        constexpr I128(I64 v) : high(v < 0 ? -1 : 0), low(static_cast<U64>(v)) {}
-        constexpr I128(I32 v) : high(v < 0 ? -1 : 0), low(static_cast<U64>(static_cast<I64>(v))) {}
+        template<std::integral T>
+        constexpr I128(T v) : high(v < 0 ? -1 : 0), low(static_cast<U64>(static_cast<I64>(v))) {}
+
+        constexpr I64 high_word() const { return high; }
+        constexpr U64 low_word() const { return low; }
+    #endif
         I128(const std::string& str);
 
         // Conversion operators
-        explicit operator int64_t() const;
+        explicit operator int64_t() const { return static_cast<int64_t>(low_word()); }
         explicit operator int32_t() const { return static_cast<int32_t>(static_cast<int64_t>(*this)); }
         explicit operator double() const;
 
-        // Arithmetic operators
+        // Arithmetic operators (wrap around on overflow)
         I128 operator+(const I128& other) const;
         I128 operator-(const I128& other) const;
         I128 operator*(const I128& other) const;
@@ -60,17 +104,17 @@ namespace Runtime {
         I128 operator-() const;
         
         // Compound assignment
-        I128& operator+=(const I128& other);
-        I128& operator-=(const I128& other);
-        I128& operator*=(const I128& other);
-        I128& operator/=(const I128& other);
-        I128& operator%=(const I128& other);
+        I128& operator+=(const I128& other) { return *this = *this + other; }
+        I128& operator-=(const I128& other) { return *this = *this - other; }
+        I128& operator*=(const I128& other) { return *this = *this * other; }
+        I128& operator/=(const I128& other) { return *this = *this / other; }
+        I128& operator%=(const I128& other) { return *this = *this % other; }
         
         // Increment/Decrement
-        I128& operator++();
-        I128 operator++(int);
-        I128& operator--();
-        I128 operator--(int);
+        I128& operator++() { return *this += I128(1); }
+        I128 operator++(int) { I128 temp(*this); ++(*this); return temp; }
+        I128& operator--() { return *this -= I128(1); }
+        I128 operator--(int) { I128 temp(*this); --(*this); return temp; }
         
         // Bitwise operators
         I128 operator&(const I128& other) const;
@@ -80,19 +124,19 @@ namespace Runtime {
         I128 operator<<(int shift) const;
         I128 operator>>(int shift) const;
         
-        I128& operator&=(const I128& other);
-        I128& operator|=(const I128& other);
-        I128& operator^=(const I128& other);
-        I128& operator<<=(int shift);
-        I128& operator>>=(int shift);
+        I128& operator&=(const I128& other) { return *this = *this & other; }
+        I128& operator|=(const I128& other) { return *this = *this | other; }
+        I128& operator^=(const I128& other) { return *this = *this ^ other; }
+        I128& operator<<=(int shift) { return *this = *this << shift; }
+        I128& operator>>=(int shift) { return *this = *this >> shift; }
         
         // Comparison operators
         bool operator==(const I128& other) const;
-        bool operator!=(const I128& other) const;
+        bool operator!=(const I128& other) const { return !(*this == other); }
         bool operator<(const I128& other) const;
-        bool operator>(const I128& other) const;
-        bool operator<=(const I128& other) const;
-        bool operator>=(const I128& other) const;
+        bool operator>(const I128& other) const { return other < *this; }
+        bool operator<=(const I128& other) const { return !(other < *this); }
+        bool operator>=(const I128& other) const { return !(*this < other); }
         
         // Stream operators
         friend std::ostream& operator<<(std::ostream& os, const I128& val);
@@ -102,32 +146,55 @@ namespace Runtime {
         std::string to_string() const;
         
         // Helper methods
-        bool is_negative() const { return high < 0; }
-        bool is_zero() const { return high == 0 && low == 0; }
+        bool is_negative() const { return high_word() < 0; }
+        bool is_zero() const { return high_word() == 0 && low_word() == 0; }
+
+        // Two's complement bit pattern and back
+        U128 to_bits() const;
+        static I128 from_bits(const U128& bits);
     };
 
-    // Custom unsigned 128-bit integer class (using two 64-bit values for compatibility)
+    // Custom unsigned 128-bit integer class
     class U128 {
         friend class I128;  // Allow i128 to access private members for conversions
         
     private:
+    #if ARGON_HAS_INT128
+        unsigned __int128 value;
+    #else
         U64 high;  // High 64 bits
         U64 low;   // Low 64 bits
+    #endif
 
     public:
         // Constructors
+    #if ARGON_HAS_INT128
+        constexpr U128() : value(0) {}
+        constexpr U128(U64 h, U64 l) : value((static_cast<unsigned __int128>(h) << 64) | l) {}
+        template<std::integral T>
+        constexpr U128(T v) : value(static_cast<unsigned __int128>(v)) {}
+        constexpr explicit U128(unsigned __int128 v) : value(v) {}
+
+        constexpr unsigned __int128 native() const { return value; }
+        constexpr U64 high_word() const { return static_cast<U64>(value >> 64); }
+        constexpr U64 low_word() const { return static_cast<U64>(value); }
+    #else
         constexpr U128() : high(0), low(0) {}
         constexpr U128(U64 h, U64 l) : high(h), low(l) {}
-        constexpr U128(U64 v) : high(0), low(v) {}
-        constexpr U128(U32 v) : high(0), low(static_cast<U64>(v)) {}
+        template<std::integral T>
+        constexpr U128(T v) : high(v < 0 ? ~U64{0} : 0), low(static_cast<U64>(v)) {}
+
+        constexpr U64 high_word() const { return high; }
+        constexpr U64 low_word() const { return low; }
+    #endif
         U128(const std::string& str);
 
         // Conversion operators
-        explicit operator uint64_t() const;
+        explicit operator uint64_t() const { return low_word(); }
         explicit operator uint32_t() const { return static_cast<uint32_t>(static_cast<uint64_t>(*this)); }
         explicit operator double() const;
 
-        // Arithmetic operators
+        // Arithmetic operators (wrap around on overflow)
         U128 operator+(const U128& other) const;
         U128 operator-(const U128& other) const;
         U128 operator*(const U128& other) const;
@@ -135,17 +202,17 @@ namespace Runtime {
         U128 operator%(const U128& other) const;
         
         // Compound assignment
-        U128& operator+=(const U128& other);
-        U128& operator-=(const U128& other);
-        U128& operator*=(const U128& other);
-        U128& operator/=(const U128& other);
-        U128& operator%=(const U128& other);
+        U128& operator+=(const U128& other) { return *this = *this + other; }
+        U128& operator-=(const U128& other) { return *this = *this - other; }
+        U128& operator*=(const U128& other) { return *this = *this * other; }
+        U128& operator/=(const U128& other) { return *this = *this / other; }
+        U128& operator%=(const U128& other) { return *this = *this % other; }
         
         // Increment/Decrement
-        U128& operator++();
-        U128 operator++(int);
-        U128& operator--();
-        U128 operator--(int);
+        U128& operator++() { return *this += U128(1u); }
+        U128 operator++(int) { U128 temp(*this); ++(*this); return temp; }
+        U128& operator--() { return *this -= U128(1u); }
+        U128 operator--(int) { U128 temp(*this); --(*this); return temp; }
         
         // Bitwise operators
         U128 operator&(const U128& other) const;
@@ -155,19 +222,19 @@ namespace Runtime {
         U128 operator<<(int shift) const;
         U128 operator>>(int shift) const;
         
-        U128& operator&=(const U128& other);
-        U128& operator|=(const U128& other);
-        U128& operator^=(const U128& other);
-        U128& operator<<=(int shift);
-        U128& operator>>=(int shift);
+        U128& operator&=(const U128& other) { return *this = *this & other; }
+        U128& operator|=(const U128& other) { return *this = *this | other; }
+        U128& operator^=(const U128& other) { return *this = *this ^ other; }
+        U128& operator<<=(int shift) { return *this = *this << shift; }
+        U128& operator>>=(int shift) { return *this = *this >> shift; }
         
         // Comparison operators
         bool operator==(const U128& other) const;
-        bool operator!=(const U128& other) const;
+        bool operator!=(const U128& other) const { return !(*this == other); }
         bool operator<(const U128& other) const;
-        bool operator>(const U128& other) const;
-        bool operator<=(const U128& other) const;
-        bool operator>=(const U128& other) const;
+        bool operator>(const U128& other) const { return other < *this; }
+        bool operator<=(const U128& other) const { return !(other < *this); }
+        bool operator>=(const U128& other) const { return !(*this < other); }
         
         // Stream operators
         friend std::ostream& operator<<(std::ostream& os, const U128& val);
@@ -177,140 +244,303 @@ namespace Runtime {
         std::string to_string() const;
         
         // Helper methods
-        bool is_zero() const { return high == 0 && low == 0; }
+        bool is_zero() const { return high_word() == 0 && low_word() == 0; }
     };
 
-    // Forward declarations
-    class ScopeManager;
-    
-    // ArgonFuture - wrapper around std::future with scope tracking
-    template<typename T>
-    class ArgonFuture {
+    namespace detail {
+        // Full 64x64 -> 128-bit product; returns the low word and stores the high word
+        inline U64 multiply_64x64(U64 a, U64 b, U64& high) {
+        #if ARGON_HAS_INT128
+            unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+            high = static_cast<U64>(product >> 64);
+            return static_cast<U64>(product);
+        #else
+            U64 a_lo = a & 0xFFFFFFFFULL, a_hi = a >> 32;
+            U64 b_lo = b & 0xFFFFFFFFULL, b_hi = b >> 32;
+            U64 lo_lo = a_lo * b_lo;
+            U64 hi_lo = a_hi * b_lo;
+            U64 lo_hi = a_lo * b_hi;
+            U64 hi_hi = a_hi * b_hi;
+            U64 cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFFULL) + lo_hi;
+            high = hi_hi + (hi_lo >> 32) + (cross >> 32);
+            return (cross << 32) | (lo_lo & 0xFFFFFFFFULL);
+        #endif
+        }
+
+        // (high:low) / divisor for high < divisor; used where no reciprocal is available
+        U64 divide_2by1(U64 high, U64 low, U64 divisor, U64& remainder);
+
+        inline int count_leading_zeros(U64 value) {
+            int count = 0;
+            for (U64 bit = U64{1} << 63; bit && !(value & bit); bit >>= 1) {
+                ++count;
+            }
+            return count;
+        }
+    }
+
+    // U64Divisor - division of U128 values by a fixed 64-bit divisor.
+    // Precomputes the reciprocal of the normalised divisor once so that each 128-by-64 step is two
+    // multiplications and a couple of corrections (Moller & Granlund, "Improved division by invariant
+    // integers", 2011) instead of a hardware or bitwise division. Used for base-10^19 string conversion.
+    class U64Divisor {
     private:
-        std::future<T> future_;
-        std::shared_ptr<ScopeManager> scope_manager_;
-        
-    public:
-        ArgonFuture(std::future<T>&& future, std::shared_ptr<ScopeManager> scope_manager)
-            : future_(std::move(future)), scope_manager_(std::move(scope_manager)) {}
-        
-        // Move constructor
-        ArgonFuture(ArgonFuture&& other) noexcept 
-            : future_(std::move(other.future_)), scope_manager_(std::move(other.scope_manager_)) {}
-        
-        // Move assignment
-        ArgonFuture& operator=(ArgonFuture&& other) noexcept {
-            if (this != &other) {
-                future_ = std::move(other.future_);
-                scope_manager_ = std::move(other.scope_manager_);
+        U64 normalized_;
+        U64 reciprocal_;
+        int shift_;
+
+        // (high:low) / normalized_ for high < normalized_
+        U64 divide_step(U64 high, U64 low, U64& remainder) const {
+            U64 quotient_high;
+            U64 quotient_low = detail::multiply_64x64(reciprocal_, high, quotient_high);
+            quotient_low += low;
+            quotient_high += high + 1 + (quotient_low < low ? 1 : 0);
+
+            U64 rest = low - quotient_high * normalized_;
+            if (rest > quotient_low) {
+                --quotient_high;
+                rest += normalized_;
             }
-            return *this;
+            if (rest >= normalized_) {
+                ++quotient_high;
+                rest -= normalized_;
+            }
+            remainder = rest;
+            return quotient_high;
         }
-        
-        // Delete copy operations
-        ArgonFuture(const ArgonFuture&) = delete;
-        ArgonFuture& operator=(const ArgonFuture&) = delete;
-        
-        // Await operation - blocks until result is ready
-        T get() {
-            return future_.get();
+
+    public:
+        explicit U64Divisor(U64 divisor);
+
+        U64 divisor() const { return normalized_ >> shift_; }
+
+        // Returns dividend / divisor and stores dividend % divisor
+        U128 divide(const U128& dividend, U64& remainder) const {
+            U64 high = dividend.high_word();
+            U64 low = dividend.low_word();
+            U64 top = shift_ ? high >> (64 - shift_) : 0;
+            U64 middle = shift_ ? (high << shift_) | (low >> (64 - shift_)) : high;
+            U64 bottom = low << shift_;
+
+            U64 rest;
+            U64 quotient_high = divide_step(top, middle, rest);
+            U64 quotient_low = divide_step(rest, bottom, rest);
+            remainder = rest >> shift_;
+            return U128(quotient_high, quotient_low);
         }
-        
-        // Check if result is ready
-        bool is_ready() const {
-            return future_.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    };
+
+#if ARGON_HAS_INT128
+    // Native operator definitions; inline so that 128-bit arithmetic compiles down to plain instructions
+
+    inline I128::operator double() const { return static_cast<double>(value); }
+
+    inline I128 I128::operator+(const I128& other) const { return from_bits(to_bits() + other.to_bits()); }
+    inline I128 I128::operator-(const I128& other) const { return from_bits(to_bits() - other.to_bits()); }
+    inline I128 I128::operator*(const I128& other) const { return from_bits(to_bits() * other.to_bits()); }
+    inline I128 I128::operator-() const { return from_bits(U128(0u) - to_bits()); }
+
+    inline I128 I128::operator/(const I128& other) const {
+        if (other.value == 0) {
+            throw std::runtime_error("Division by zero");
         }
-        
-        // Wait with timeout
-        template<typename Rep, typename Period>
-        std::future_status wait_for(const std::chrono::duration<Rep, Period>& timeout_duration) {
-            return future_.wait_for(timeout_duration);
+        if (other.value == -1) {
+            return -*this; // Avoids the overflow trap on MIN / -1
         }
-    };
-    
-    // ScopeManager - tracks futures in a scope and waits for completion
-    class ScopeManager {
-    private:
-        std::vector<std::function<void()>> pending_futures_;
-        bool is_destroyed_ = false;
-        
+        return I128(value / other.value);
+    }
+
+    inline I128 I128::operator%(const I128& other) const {
+        if (other.value == 0) {
+            throw std::runtime_error("Modulo by zero");
+        }
+        if (other.value == -1) {
+            return I128(0);
+        }
+        return I128(value % other.value);
+    }
+
+    inline I128 I128::operator&(const I128& other) const { return I128(value & other.value); }
+    inline I128 I128::operator|(const I128& other) const { return I128(value | other.value); }
+    inline I128 I128::operator^(const I128& other) const { return I128(value ^ other.value); }
+    inline I128 I128::operator~() const { return I128(~value); }
+
+    inline I128 I128::operator<<(int shift) const {
+        if (shift <= 0) return *this;
+        if (shift >= 128) return I128(0);
+        return from_bits(to_bits() << shift);
+    }
+
+    inline I128 I128::operator>>(int shift) const {
+        if (shift <= 0) return *this;
+        if (shift >= 128) return I128(is_negative() ? -1 : 0);
+        return I128(value >> shift);
+    }
+
+    inline bool I128::operator==(const I128& other) const { return value == other.value; }
+    inline bool I128::operator<(const I128& other) const { return value < other.value; }
+
+    inline U128 I128::to_bits() const { return U128(static_cast<unsigned __int128>(value)); }
+    inline I128 I128::from_bits(const U128& bits) { return I128(static_cast<__int128>(bits.value)); }
+
+    inline U128::operator double() const { return static_cast<double>(value); }
+
+    inline U128 U128::operator+(const U128& other) const { return U128(value + other.value); }
+    inline U128 U128::operator-(const U128& other) const { return U128(value - other.value); }
+    inline U128 U128::operator*(const U128& other) const { return U128(value * other.value); }
+
+    inline U128 U128::operator/(const U128& other) const {
+        if (other.value == 0) {
+            throw std::runtime_error("Division by zero");
+        }
+        return U128(value / other.value);
+    }
+
+    inline U128 U128::operator%(const U128& other) const {
+        if (other.value == 0) {
+            throw std::runtime_error("Modulo by zero");
+        }
+        return U128(value % other.value);
+    }
+
+    inline U128 U128::operator&(const U128& other) const { return U128(value & other.value); }
+    inline U128 U128::operator|(const U128& other) const { return U128(value | other.value); }
+    inline U128 U128::operator^(const U128& other) const { return U128(value ^ other.value); }
+    inline U128 U128::operator~() const { return U128(~value); }
+
+    inline U128 U128::operator<<(int shift) const {
+        if (shift <= 0) return *this;
+        if (shift >= 128) return U128(0u);
+        return U128(value << shift);
+    }
+
+    inline U128 U128::operator>>(int shift) const {
+        if (shift <= 0) return *this;
+        if (shift >= 128) return U128(0u);
+        return U128(value >> shift);
+    }
+
+    inline bool U128::operator==(const U128& other) const { return value == other.value; }
+    inline bool U128::operator<(const U128& other) const { return value < other.value; }
+#endif
+
+    // TaskResult - task-owned shared state read by ArgonFuture
+    template<typename T>
+    class TaskResult : public Task {
+    protected:
+        std::optional<T> value_;
+        std::exception_ptr error_;
+
     public:
-        ScopeManager() = default;
-        
-        // Destructor waits for all pending futures
-        ~ScopeManager() {
-            wait_all();
-            is_destroyed_ = true;
-        }
-        
-        // Register a future to be waited on at scope exit
-        template<typename T>
-        void register_future(const std::future<T>& future) {
-            if (!is_destroyed_) {
-                pending_futures_.push_back([&future]() {
-                    if (future.valid()) {
-                        future.wait();
-                    }
-                });
+        T take() {
+            if (error_) {
+                std::rethrow_exception(error_);
             }
+            return std::move(*value_);
         }
-        
-        // Wait for all registered futures
-        void wait_all() {
-            for (auto& waiter : pending_futures_) {
-                waiter();
+    };
+
+    template<>
+    class TaskResult<void> : public Task {
+    protected:
+        std::exception_ptr error_;
+
+    public:
+        void take() {
+            if (error_) {
+                std::rethrow_exception(error_);
             }
-            pending_futures_.clear();
         }
-        
-        // Get shared pointer to this scope manager
-        std::shared_ptr<ScopeManager> get_shared() {
-            return std::shared_ptr<ScopeManager>(this, [](ScopeManager*){});
+    };
+
+    // ParTask - runs a par body and stores its result next to it (single allocation per par)
+    template<typename F, typename T>
+    class ParTask final : public TaskResult<T> {
+    private:
+        F func_;
+
+    public:
+        template<typename Fn>
+        explicit ParTask(Fn&& func) : func_(std::forward<Fn>(func)) {}
+
+    protected:
+        void execute() noexcept override {
+            try {
+                if constexpr (std::is_void_v<T>) {
+                    func_();
+                } else {
+                    this->value_.emplace(func_());
+                }
+            } catch (...) {
+                this->error_ = std::current_exception();
+            }
         }
     };
-    
-    // Thread-local scope manager stack
-    extern thread_local std::vector<std::shared_ptr<ScopeManager>> scope_stack;
-    
-    // Scope guard for automatic scope management
-    class ScopeGuard {
+
+    // ArgonFuture - handle to the result of a par task
+    template<typename T>
+    class ArgonFuture {
     private:
-        std::shared_ptr<ScopeManager> scope_manager_;
+        TaskRef<TaskResult<T>> task_;
         
     public:
-        ScopeGuard() {
-            scope_manager_ = std::make_shared<ScopeManager>();
-            scope_stack.push_back(scope_manager_);
+        explicit ArgonFuture(TaskRef<TaskResult<T>> task) : task_(std::move(task)) {}
+        
+        ArgonFuture(ArgonFuture&& other) noexcept = default;
+        ArgonFuture& operator=(ArgonFuture&& other) noexcept = default;
+        
+        // Delete copy operations
+        ArgonFuture(const ArgonFuture&) = delete;
+        ArgonFuture& operator=(const ArgonFuture&) = delete;
+        
+        // Await operation - runs pending tasks on this thread until the result is ready
+        T get() {
+            Scheduler::instance().help_until_done(*task_);
+            return task_->take();
         }
         
-        ~ScopeGuard() {
-            if (!scope_stack.empty()) {
-                scope_stack.pop_back();
-            }
+        // Check if result is ready
+        bool is_ready() const {
+            return task_->is_done();
         }
         
-        std::shared_ptr<ScopeManager> get_scope_manager() {
-            return scope_manager_;
+        // Wait with timeout, helping with pending tasks while waiting
+        template<typename Rep, typename Period>
+        std::future_status wait_for(const std::chrono::duration<Rep, Period>& timeout_duration) {
+            auto deadline = std::chrono::steady_clock::now() + timeout_duration;
+            while (!task_->is_done()) {
+                if (std::chrono::steady_clock::now() >= deadline) {
+                    return std::future_status::timeout;
+                }
+                if (!Scheduler::instance().run_one()) {
+                    std::this_thread::yield();
+                }
+            }
+            return std::future_status::ready;
         }
     };
     
-    // Parallel execution functions
+    // Parallel execution: submits func to the work-stealing scheduler
     template<typename F>
-    auto par(F&& func) -> ArgonFuture<decltype(func())> {
-        auto scope_manager = scope_stack.empty() ? nullptr : scope_stack.back();
+    auto par(F&& func) -> ArgonFuture<std::invoke_result_t<std::decay_t<F>&>> {
+        using ResultType = std::invoke_result_t<std::decay_t<F>&>;
         
-        auto future = std::async(std::launch::async, std::forward<F>(func));
+        auto* task = new ParTask<std::decay_t<F>, ResultType>(std::forward<F>(func));
+        TaskRef<TaskResult<ResultType>> handle(task);
         
-        if (scope_manager) {
-            scope_manager->register_future(future);
+        if (Scope* scope = Scope::current()) {
+            scope->attach(task);
         }
         
-        return ArgonFuture<decltype(func())>(std::move(future), scope_manager);
+        task->retain(); // Reference owned by the scheduler until the task has run
+        Scheduler::instance().submit(task);
+        
+        return ArgonFuture<ResultType>(std::move(handle));
     }
     
     // Parallel execution with configuration (placeholder for now)
     template<typename Config, typename F>
-    auto par(Config&& config, F&& func) -> ArgonFuture<decltype(func())> {
+    auto par(Config&& config, F&& func) -> ArgonFuture<std::invoke_result_t<std::decay_t<F>&>> {
         // TODO: Use config for timeout, retries, etc.
         return par(std::forward<F>(func));
     }
@@ -321,24 +551,37 @@ namespace Runtime {
         return future.get();
     }
     
-    // Functional programming utilities to reduce code bloat
-    // (Implementations moved to ArgonRuntime.cpp)
+    // Functional programming utilities
+    // Header-only so that per-element callables inline; the ExecutionPolicy overloads are in ArgonParallel.h,
+    // the lazy pipelines generated for | and & are in ArgonPipeline.h
     
     // Filter utility: container | predicate
     template<typename Container, typename Predicate>
-    std::decay_t<Container> filter(Container&& container, Predicate&& predicate);
+    std::decay_t<Container> filter(Container&& container, Predicate&& predicate) {
+        return filter(ExecutionPolicy::Sequential, std::forward<Container>(container),
+                      std::forward<Predicate>(predicate));
+    }
     
     // Map utility: container & transform
     template<typename Container, typename Transform>
-    std::decay_t<Container> map(Container&& container, Transform&& transform);
+    std::decay_t<Container> map(Container&& container, Transform&& transform) {
+        return map(ExecutionPolicy::Sequential, std::forward<Container>(container),
+                   std::forward<Transform>(transform));
+    }
     
-    // Reduce utility: container ^ reducer
+    // Reduce utility: container ? reducer
     template<typename Container, typename Reducer>
-    typename std::decay_t<Container>::value_type reduce(Container&& container, Reducer&& reducer);
+    typename std::decay_t<Container>::value_type reduce(Container&& container, Reducer&& reducer) {
+        return reduce(ExecutionPolicy::Sequential, std::forward<Container>(container),
+                      std::forward<Reducer>(reducer));
+    }
     
     // Map-pipe utility: container ||> transform (in-place transformation)
     template<typename Container, typename Transform>
-    Container& map_pipe(Container& container, Transform&& transform);
+    decltype(auto) map_pipe(Container&& container, Transform&& transform) {
+        return map_pipe(ExecutionPolicy::Sequential, std::forward<Container>(container),
+                        std::forward<Transform>(transform));
+    }
     
     // Pattern matching utilities to reduce code bloat
     // (Implementations moved to ArgonRuntime.cpp)
@@ -355,7 +598,31 @@ namespace Runtime {
     bool match_range_int(int value, int start, int end, bool inclusive = false);
     bool match_range_float(float value, float start, float end, bool inclusive = false);
     bool match_range_double(double value, double start, double end, bool inclusive = false);
+
+    // Range pattern whose bounds are constants, both inclusive: an integer is tested with one subtraction and one
+    // comparison, since value - Low wraps around to above the width of the range when value is below Low. The
+    // subtraction is as wide as the widest of the three, so 128-bit values are not truncated
+    template<auto Low, auto High, typename T>
+    constexpr bool match_constant_range(const T& value) {
+        if constexpr (std::is_enum_v<T>) {
+            return match_constant_range<Low, High>(static_cast<std::underlying_type_t<T>>(value));
+        } else if constexpr (std::is_integral_v<T>) {
+            using Unsigned = std::make_unsigned_t<std::common_type_t<T, decltype(Low), decltype(High)>>;
+            return static_cast<Unsigned>(value) - static_cast<Unsigned>(Low) <=
+                   static_cast<Unsigned>(High) - static_cast<Unsigned>(Low);
+        } else if constexpr (std::is_arithmetic_v<T>) {
+            return Low <= value && value <= High;
+        } else {
+            // Class types such as I128 and U128 only compare with values of their own type
+            return T(Low) <= value && value <= T(High);
+        }
+    }
     
+    // Whether a match on a value of type T can switch on it: case labels only compare integers and enumerators
+    template<typename T>
+    inline constexpr bool is_switchable_v =
+        std::is_integral_v<std::remove_cvref_t<T>> || std::is_enum_v<std::remove_cvref_t<T>>;
+
     // Wildcard pattern (always matches)
     template<typename T>
     bool match_wildcard(T&& value);
@@ -405,24 +672,6 @@ namespace Runtime {
     // ===== EXTERN TEMPLATE DECLARATIONS FOR COMMON TYPES =====
     // These reduce compilation bloat by preventing implicit instantiation
     
-    // Functional operators for std::vector<int>
-    extern template std::vector<int> filter(std::vector<int>&& container, std::function<bool(int)>&& predicate);
-    extern template std::vector<int> filter(const std::vector<int>& container, std::function<bool(int)>&& predicate);
-    extern template std::vector<int> map(std::vector<int>&& container, std::function<int(int)>&& transform);
-    extern template std::vector<int> map(const std::vector<int>& container, std::function<int(int)>&& transform);
-    extern template int reduce(std::vector<int>&& container, std::function<int(int, int)>&& reducer);
-    extern template int reduce(const std::vector<int>& container, std::function<int(int, int)>&& reducer);
-    extern template std::vector<int>& map_pipe(std::vector<int>& container, std::function<int(int)>&& transform);
-
-    // Functional operators for std::vector<float>
-    extern template std::vector<float> filter(std::vector<float>&& container, std::function<bool(float)>&& predicate);
-    extern template std::vector<float> filter(const std::vector<float>& container, std::function<bool(float)>&& predicate);
-    extern template std::vector<float> map(std::vector<float>&& container, std::function<float(float)>&& transform);
-    extern template std::vector<float> map(const std::vector<float>& container, std::function<float(float)>&& transform);
-    extern template float reduce(std::vector<float>&& container, std::function<float(float, float)>&& reducer);
-    extern template float reduce(const std::vector<float>& container, std::function<float(float, float)>&& reducer);
-    extern template std::vector<float>& map_pipe(std::vector<float>& container, std::function<float(float)>&& transform);
-
     // Destructuring for std::vector<int>
     extern template int destructure_array_element(std::vector<int>&& container, size_t index);
     extern template int destructure_array_element(const std::vector<int>& container, size_t index);
@@ -589,9 +838,13 @@ namespace Runtime {
     }
 
     // Helper macros for code generation
-    #define ARGON_SCOPE_BEGIN() ArgonLang::Runtime::ScopeGuard __scope_guard;
+    #define ARGON_SCOPE_BEGIN() ArgonLang::Runtime::Scope __argon_scope;
     
 } // namespace Runtime
 } // namespace ArgonLang
 
+// Generated code names the 128-bit types unqualified, like the macro aliases above
+using ArgonLang::Runtime::I128;
+using ArgonLang::Runtime::U128;
+
 #endif // ARGON_RUNTIME_H
@@ -0,0 +1,243 @@
+#ifndef ARGON_SCHEDULER_H
+#define ARGON_SCHEDULER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ArgonLang {
+namespace Runtime {
+
+class Scope;
+
+// Task - unit of work executed by the scheduler.
+// Tasks are intrusively reference counted so that the scheduler, the future returned by par and
+// any enclosing scope can share one allocation without a separate control block.
+class Task {
+public:
+	Task() = default;
+	virtual ~Task() = default;
+
+	Task(const Task&) = delete;
+	Task& operator=(const Task&) = delete;
+
+	// Runs the task body and publishes completion
+	void run() noexcept {
+		execute();
+		done_.store(true, std::memory_order_release);
+		done_.notify_all();
+	}
+
+	bool is_done() const noexcept { return done_.load(std::memory_order_acquire); }
+
+	// Blocks the calling thread until the task has completed (no helping)
+	void wait_done() const noexcept {
+		while (!done_.load(std::memory_order_acquire)) {
+			done_.wait(false, std::memory_order_acquire);
+		}
+	}
+
+	void retain() noexcept { ref_count_.fetch_add(1, std::memory_order_relaxed); }
+
+	void release() noexcept {
+		if (ref_count_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+			delete this;
+		}
+	}
+
+protected:
+	virtual void execute() noexcept = 0;
+
+private:
+	friend class Scope;
+
+	std::atomic<std::uint32_t> ref_count_{1};
+	std::atomic<bool> done_{false};
+
+	// Next task attached to the same scope (owned by that scope's thread)
+	Task* scope_next_ = nullptr;
+};
+
+// TaskRef - owning handle to a Task (intrusive_ptr semantics)
+template<typename T = Task>
+class TaskRef {
+private:
+	T* task_ = nullptr;
+
+public:
+	TaskRef() = default;
+
+	// Adopts an existing reference without retaining
+	explicit TaskRef(T* task) noexcept : task_(task) {}
+
+	TaskRef(const TaskRef& other) noexcept : task_(other.task_) {
+		if (task_) {
+			task_->retain();
+		}
+	}
+
+	TaskRef(TaskRef&& other) noexcept : task_(other.task_) { other.task_ = nullptr; }
+
+	template<typename U>
+	TaskRef(const TaskRef<U>& other) noexcept : task_(other.get()) {
+		if (task_) {
+			task_->retain();
+		}
+	}
+
+	TaskRef& operator=(TaskRef other) noexcept {
+		std::swap(task_, other.task_);
+		return *this;
+	}
+
+	~TaskRef() {
+		if (task_) {
+			task_->release();
+		}
+	}
+
+	T* get() const noexcept { return task_; }
+	T* operator->() const noexcept { return task_; }
+	T& operator*() const noexcept { return *task_; }
+	explicit operator bool() const noexcept { return task_ != nullptr; }
+};
+
+// WorkStealingDeque - Chase-Lev deque of tasks.
+// The owning worker pushes and pops at the bottom, other threads steal from the top.
+class WorkStealingDeque {
+public:
+	explicit WorkStealingDeque(std::size_t capacity = 256);
+	~WorkStealingDeque();
+
+	WorkStealingDeque(const WorkStealingDeque&) = delete;
+	WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+	// Owner only
+	void push(Task* task);
+	Task* pop();
+
+	// Any thread; returns nullptr when the deque is empty
+	Task* steal();
+
+	bool empty() const noexcept;
+
+private:
+	struct Buffer {
+		std::int64_t capacity;
+		std::int64_t mask;
+		std::unique_ptr<std::atomic<Task*>[]> slots;
+
+		explicit Buffer(std::int64_t capacity);
+		Task* get(std::int64_t index) const noexcept;
+		void put(std::int64_t index, Task* task) noexcept;
+	};
+
+	alignas(64) std::atomic<std::int64_t> top_{0};
+	alignas(64) std::atomic<std::int64_t> bottom_{0};
+	alignas(64) std::atomic<Buffer*> buffer_;
+
+	// Buffers replaced by growth; kept alive until destruction because thieves may still read them
+	std::vector<std::unique_ptr<Buffer>> retired_;
+};
+
+// Scheduler - per-process work-stealing thread pool backing par.
+// One worker per hardware thread, each with its own deque; submissions from threads outside the
+// pool go through a shared injection queue.
+class Scheduler {
+public:
+	explicit Scheduler(std::size_t worker_count);
+	~Scheduler();
+
+	Scheduler(const Scheduler&) = delete;
+	Scheduler& operator=(const Scheduler&) = delete;
+
+	// Process-wide scheduler, created on first use
+	static Scheduler& instance();
+
+	// Enqueues a task; the scheduler takes over the caller's reference
+	void submit(Task* task);
+
+	// Runs one pending task on the calling thread if any is available
+	bool run_one();
+
+	// Executes pending tasks on the calling thread until the given task completes
+	void help_until_done(const Task& task);
+
+	std::size_t worker_count() const noexcept { return workers_.size(); }
+
+	// Index of the calling worker in this scheduler, or -1 for foreign threads
+	int current_worker_index() const noexcept;
+
+private:
+	struct Worker {
+		WorkStealingDeque deque;
+		std::thread thread;
+	};
+
+	void worker_loop(std::size_t index);
+	Task* find_work(int index);
+	Task* steal_from_others(int index);
+	Task* pop_injected();
+	void notify_workers();
+	void execute(Task* task);
+
+	std::vector<std::unique_ptr<Worker>> workers_;
+
+	std::mutex injection_mutex_;
+	std::deque<Task*> injection_queue_;
+	std::atomic<std::size_t> injected_count_{0};
+
+	std::mutex sleep_mutex_;
+	std::condition_variable sleep_cv_;
+	std::atomic<std::uint64_t> epoch_{0};
+	std::atomic<std::size_t> sleepers_{0};
+	std::atomic<bool> stopping_{false};
+};
+
+// Scope - structured-concurrency region waiting for every par started inside it.
+// Lives on the stack of the thread that opened it; attached tasks form an intrusive list through
+// Task::scope_next_, so opening a scope and attaching a task never allocate.
+class Scope {
+public:
+	Scope() noexcept : parent_(current_) { current_ = this; }
+
+	~Scope() {
+		wait_all();
+		current_ = parent_;
+	}
+
+	Scope(const Scope&) = delete;
+	Scope& operator=(const Scope&) = delete;
+
+	// Innermost scope open on the calling thread, or nullptr
+	static Scope* current() noexcept { return current_; }
+
+	// Keeps the task alive until the scope has waited for it
+	void attach(Task* task) noexcept {
+		task->retain();
+		task->scope_next_ = head_;
+		head_ = task;
+	}
+
+	// Helps the scheduler until every attached task has completed
+	void wait_all() noexcept;
+
+private:
+	friend class Scheduler;
+
+	static inline thread_local Scope* current_ = nullptr;
+
+	Scope* parent_;
+	Task* head_ = nullptr;
+};
+
+} // namespace Runtime
+} // namespace ArgonLang
+
+#endif // ARGON_SCHEDULER_H
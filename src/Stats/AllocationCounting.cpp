@@ -0,0 +1,33 @@
+#include "Stats/CompilerStats.h"
+
+#include <cstdlib>
+#include <new>
+
+// Replacing the global allocation functions is the only portable way to count allocations made by the standard
+// containers the compiler uses. The array and sized/nothrow forms forward to these by default. This file is linked
+// into the driver and the tests only, so the library and the benchmarks keep the default allocator.
+namespace {
+void* counted_allocate(std::size_t size) {
+	ArgonLang::count_allocation(size);
+	return std::malloc(size == 0 ? 1 : size);
+}
+} // namespace
+
+void* operator new(std::size_t size) {
+	if (void* memory = counted_allocate(size)) {
+		return memory;
+	}
+	throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+	return counted_allocate(size);
+}
+
+void operator delete(void* memory) noexcept {
+	std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+	std::free(memory);
+}
@@ -0,0 +1,144 @@
+#include "Stats/CompilerStats.h"
+
+#include <atomic>
+#include <iomanip>
+
+#if defined(_WIN32)
+#define PSAPI_VERSION 2
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace {
+std::atomic<std::size_t> allocation_count{0};
+std::atomic<std::size_t> allocation_bytes{0};
+
+double to_mebibytes(std::size_t bytes) {
+	return static_cast<double>(bytes) / (1024.0 * 1024.0);
+}
+
+void write_json_string(std::ostream& os, const std::string& value) {
+	os << '"';
+	for (char c : value) {
+		if (c == '"' || c == '\\') {
+			os << '\\';
+		}
+		os << c;
+	}
+	os << '"';
+}
+} // namespace
+
+void ArgonLang::count_allocation(std::size_t bytes) noexcept {
+	allocation_count.fetch_add(1, std::memory_order_relaxed);
+	allocation_bytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+ArgonLang::AllocationCounters ArgonLang::allocation_counters() {
+	return {allocation_count.load(std::memory_order_relaxed), allocation_bytes.load(std::memory_order_relaxed)};
+}
+
+std::size_t ArgonLang::peak_rss_bytes() {
+#if defined(_WIN32)
+	PROCESS_MEMORY_COUNTERS counters;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+		return counters.PeakWorkingSetSize;
+	}
+	return 0;
+#else
+	rusage usage{};
+	if (getrusage(RUSAGE_SELF, &usage) != 0) {
+		return 0;
+	}
+#if defined(__APPLE__)
+	return static_cast<std::size_t>(usage.ru_maxrss); // Bytes on macOS
+#else
+	return static_cast<std::size_t>(usage.ru_maxrss) * 1024; // Kilobytes on Linux and the BSDs
+#endif
+#endif
+}
+
+ArgonLang::CompilerStats::PassScope::PassScope(CompilerStats& stats, std::string name)
+    : stats(stats), name(std::move(name)), start(std::chrono::steady_clock::now()),
+      start_allocations(allocation_counters()) {}
+
+ArgonLang::CompilerStats::PassScope::~PassScope() {
+	auto end = std::chrono::steady_clock::now();
+	AllocationCounters end_allocations = allocation_counters();
+
+	Pass pass;
+	pass.name = std::move(name);
+	pass.wall_ms = std::chrono::duration<double, std::milli>(end - start).count();
+	pass.peak_rss = peak_rss_bytes();
+	pass.allocations = end_allocations.allocations - start_allocations.allocations;
+	pass.allocated_bytes = end_allocations.bytes - start_allocations.bytes;
+	stats.passes.push_back(std::move(pass));
+}
+
+void ArgonLang::CompilerStats::print(std::ostream& os, bool with_counts) const {
+	double total_ms = 0;
+	for (const auto& pass : passes) {
+		total_ms += pass.wall_ms;
+	}
+
+	auto flags = os.flags();
+	os << "===== Pass timing =====\n";
+	os << std::left << std::setw(14) << "Pass" << std::right << std::setw(12) << "Wall (ms)" << std::setw(8) << "%"
+	   << std::setw(16) << "Peak RSS (MiB)" << std::setw(14) << "Allocations" << std::setw(16) << "Alloc (MiB)"
+	   << "\n";
+	os << std::fixed;
+	for (const auto& pass : passes) {
+		os << std::left << std::setw(14) << pass.name << std::right << std::setprecision(3) << std::setw(12)
+		   << pass.wall_ms << std::setprecision(1) << std::setw(8)
+		   << (total_ms > 0 ? 100.0 * pass.wall_ms / total_ms : 0.0) << std::setprecision(2) << std::setw(16)
+		   << to_mebibytes(pass.peak_rss) << std::setw(14) << pass.allocations << std::setw(16)
+		   << to_mebibytes(pass.allocated_bytes) << "\n";
+	}
+	os << std::left << std::setw(14) << "Total" << std::right << std::setprecision(3) << std::setw(12) << total_ms
+	   << "\n";
+
+	if (with_counts) {
+		os << "===== Statistics =====\n";
+		os << "Source bytes:     " << source_bytes << "\n";
+		os << "Tokens:           " << token_count << "\n";
+		os << "AST nodes:        " << [&] {
+			std::size_t live = 0;
+			for (const auto& [type, count] : ast_nodes) {
+				live += count;
+			}
+			return live;
+		}() << " (" << ast_nodes_created << " constructed)\n";
+		for (const auto& [type, count] : ast_nodes) {
+			os << "  " << std::left << std::setw(24) << ast_node_type_to_string(type) << std::right << count << "\n";
+		}
+		os << "Generated bytes:  " << generated_bytes << "\n";
+	}
+	os.flags(flags);
+}
+
+void ArgonLang::CompilerStats::print_json(std::ostream& os) const {
+	os << "{\n  \"passes\": [";
+	for (std::size_t i = 0; i < passes.size(); ++i) {
+		const Pass& pass = passes[i];
+		os << (i ? ",\n" : "\n") << "    {\"name\": ";
+		write_json_string(os, pass.name);
+		os << ", \"wall_ms\": " << pass.wall_ms << ", \"peak_rss_bytes\": " << pass.peak_rss
+		   << ", \"allocations\": " << pass.allocations << ", \"allocated_bytes\": " << pass.allocated_bytes << "}";
+	}
+	os << "\n  ],\n";
+	os << "  \"source_bytes\": " << source_bytes << ",\n";
+	os << "  \"tokens\": " << token_count << ",\n";
+	os << "  \"ast_nodes_constructed\": " << ast_nodes_created << ",\n";
+	os << "  \"ast_nodes\": {";
+	bool first = true;
+	for (const auto& [type, count] : ast_nodes) {
+		os << (first ? "\n    " : ",\n    ");
+		write_json_string(os, ast_node_type_to_string(type));
+		os << ": " << count;
+		first = false;
+	}
+	os << (first ? "},\n" : "\n  },\n");
+	os << "  \"generated_bytes\": " << generated_bytes << "\n}\n";
+}
@@ -1,5 +1,8 @@
 #include "backend/AST.h"
 
+#include <atomic>
+#include <cstddef>
+
 std::string ArgonLang::primitive_type_to_string(PrimitiveType type) {
 	switch (type) {
 	case INT8:
@@ -267,6 +270,146 @@ std::string ArgonLang::ast_node_type_to_string(ASTNodeType type) {
 	return "Unknown";
 }
 
+namespace {
+std::atomic<ArgonLang::ASTNodeTracker*> active_tracker{nullptr};
+}
+
+ArgonLang::ASTNodeTracker::~ASTNodeTracker() {
+	uninstall();
+}
+
+ArgonLang::ASTNodeTracker* ArgonLang::ASTNodeTracker::active() {
+	return active_tracker.load(std::memory_order_acquire);
+}
+
+void ArgonLang::ASTNodeTracker::install() {
+	active_tracker.store(this, std::memory_order_release);
+}
+
+void ArgonLang::ASTNodeTracker::uninstall() {
+	ASTNodeTracker* expected = this;
+	active_tracker.compare_exchange_strong(expected, nullptr, std::memory_order_acq_rel);
+}
+
+void ArgonLang::ASTNodeTracker::add(const ASTNode* node) {
+	std::lock_guard lock(mutex_);
+	live_.insert(node);
+	++created_;
+}
+
+void ArgonLang::ASTNodeTracker::remove(const ASTNode* node) {
+	std::lock_guard lock(mutex_);
+	live_.erase(node);
+}
+
+std::size_t ArgonLang::ASTNodeTracker::created() const {
+	std::lock_guard lock(mutex_);
+	return created_;
+}
+
+std::map<ArgonLang::ASTNodeType, std::size_t> ArgonLang::ASTNodeTracker::count_by_type() const {
+	std::lock_guard lock(mutex_);
+	std::map<ASTNodeType, std::size_t> counts;
+	for (const ASTNode* node : live_) {
+		++counts[node->get_node_type()];
+	}
+	return counts;
+}
+
+namespace {
+thread_local ArgonLang::ASTArena* current_arena = nullptr;
+
+// Every node starts with the arena it was allocated from, or null for the heap, so that delete knows which it was
+constexpr std::size_t NODE_HEADER = alignof(std::max_align_t);
+static_assert(sizeof(ArgonLang::ASTArena*) <= NODE_HEADER);
+
+constexpr std::size_t align_up(std::size_t size) {
+	return (size + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+}
+} // namespace
+
+ArgonLang::ASTArena* ArgonLang::ASTArena::active() {
+	return current_arena;
+}
+
+ArgonLang::ASTArena::Scope::Scope(ASTArena* arena) : previous(current_arena) {
+	current_arena = arena;
+}
+
+ArgonLang::ASTArena::Scope::~Scope() {
+	current_arena = previous;
+}
+
+void* ArgonLang::ASTArena::allocate(std::size_t size) {
+	size = align_up(size);
+	bytes_used += size;
+	// Large requests get a block of their own rather than wasting the rest of the current one
+	if (size > BLOCK_SIZE / 4) {
+		blocks.push_back(std::make_unique_for_overwrite<std::byte[]>(size));
+		return blocks.back().get();
+	}
+	if (static_cast<std::size_t>(limit - cursor) < size) {
+		blocks.push_back(std::make_unique_for_overwrite<std::byte[]>(BLOCK_SIZE));
+		cursor = blocks.back().get();
+		limit = cursor + BLOCK_SIZE;
+	}
+	void* memory = cursor;
+	cursor += size;
+	return memory;
+}
+
+const std::string& ArgonLang::ASTArena::intern(std::string_view text) {
+	auto found = strings.find(text);
+	if (found != strings.end()) {
+		return *found;
+	}
+	return *strings.emplace(text).first;
+}
+
+void* ArgonLang::ASTArena::allocate_node(std::size_t size) {
+	ASTArena* arena = current_arena;
+	void* memory = arena ? arena->allocate(NODE_HEADER + size) : ::operator new(NODE_HEADER + size);
+	*static_cast<ASTArena**>(memory) = arena;
+	return static_cast<std::byte*>(memory) + NODE_HEADER;
+}
+
+void ArgonLang::ASTArena::deallocate_node(void* node) noexcept {
+	if (node == nullptr) {
+		return;
+	}
+	void* memory = static_cast<std::byte*>(node) - NODE_HEADER;
+	// Arena memory is only given back when the arena itself goes
+	if (*static_cast<ASTArena**>(memory) == nullptr) {
+		::operator delete(memory);
+	}
+}
+
+const std::string& ArgonLang::ASTArena::intern_current(std::string_view text) {
+	if (current_arena != nullptr) {
+		return current_arena->intern(text);
+	}
+	static std::mutex mutex;
+	static ASTArena global;
+	std::lock_guard lock(mutex);
+	return global.intern(text);
+}
+
+namespace {
+const std::string empty_string;
+}
+
+ArgonLang::InternedString::InternedString() : text(&empty_string) {}
+
+ArgonLang::InternedString::InternedString(std::string_view text) : text(&ASTArena::intern_current(text)) {}
+
+void* ArgonLang::ASTNode::operator new(std::size_t size) {
+	return ASTArena::allocate_node(size);
+}
+
+void ArgonLang::ASTNode::operator delete(void* node) noexcept {
+	ASTArena::deallocate_node(node);
+}
+
 ArgonLang::ASTNodeGroup ArgonLang::ExpressionNode::get_node_group() const {
 	return ArgonLang::ASTNodeGroup::Expression;
 }
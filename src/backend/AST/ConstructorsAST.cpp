@@ -3,7 +3,18 @@
 #include <utility>
 
 using namespace ArgonLang;
-ASTNode::ASTNode(Token::Position position) : position(position) {}
+ASTNode::ASTNode(Token::Position position) : position(position) {
+	if (ASTNodeTracker* tracker = ASTNodeTracker::active()) {
+		tracker->add(this);
+	}
+}
+
+ASTNode::~ASTNode() {
+	if (ASTNodeTracker* tracker = ASTNodeTracker::active()) {
+		tracker->remove(this);
+	}
+}
+
 ExpressionNode::ExpressionNode(Token::Position position) : ASTNode(position) {}
 StatementNode::StatementNode(Token::Position position) : ASTNode(position) {}
 TypeNode::TypeNode(Token::Position position) : ASTNode(position) {}
@@ -24,8 +35,8 @@ ArgonLang::FloatLiteralNode::FloatLiteralNode(Token::Position position, std::str
 }
 ArgonLang::BooleanLiteralNode::BooleanLiteralNode(Token::Position position, bool val)
     : value(val), ExpressionNode(position) {}
-ArgonLang::IdentifierNode::IdentifierNode(Token::Position position, std::string val)
-    : identifier(std::move(val)), ExpressionNode(position) {}
+ArgonLang::IdentifierNode::IdentifierNode(Token::Position position, std::string_view val)
+    : identifier(val), ExpressionNode(position) {}
 ArgonLang::BinaryExpressionNode::BinaryExpressionNode(Token::Position position, std::unique_ptr<ExpressionNode> lhs,
                                                       Token operatorSymbol, std::unique_ptr<ExpressionNode> rhs)
     : left(std::move(lhs)), right(std::move(rhs)), op(std::move(operatorSymbol)), ExpressionNode(position) {}
@@ -146,8 +157,8 @@ ArgonLang::UnionDeclarationNode::UnionDeclarationNode(Token::Position position,
                                                       std::vector<UnionField> fields)
     : unionName(std::move(unionName)), fields(std::move(fields)), StatementNode(position) {}
 
-ArgonLang::IdentifierTypeNode::IdentifierTypeNode(Token::Position position, std::string typeName)
-    : typeName(std::move(typeName)), TypeNode(position) {}
+ArgonLang::IdentifierTypeNode::IdentifierTypeNode(Token::Position position, std::string_view typeName)
+    : typeName(typeName), TypeNode(position) {}
 
 ArgonLang::RangeExpressionNode::RangeExpressionNode(Token::Position position,
                                                     std::vector<std::unique_ptr<ExpressionNode>> range)
@@ -1,24 +1,26 @@
 #include "backend/Parser.h"
 
+#include <array>
+
 using namespace ArgonLang;
 
 Result<std::unique_ptr<ASTNode>> Parser::parse_primary() {
-	Result<Token> token_error = advance();
+	Result<const Token*> token_error = advance();
 	if (!token_error.has_value()) {
 		return Err<std::unique_ptr<ASTNode>>(token_error.error());
 	}
-	Token token = token_error.value();
+	const Token& token = *token_error.value();
 
 	if (token.type == Token::IntegralLiteral) {
-		std::string strippedValue = strip_integer_suffix(token.value);
+		std::string strippedValue = strip_integer_suffix(std::string(token.value));
 		return Ok(std::make_unique<IntegralLiteralNode>(
-		    token.position, strippedValue, determine_integer_type(token.value)));
+		    token.position, strippedValue, determine_integer_type(std::string(token.value))));
 	} else if (token.type == Token::FloatLiteral) {
-		std::string strippedValue = strip_float_suffix(token.value);
+		std::string strippedValue = strip_float_suffix(std::string(token.value));
 		return Ok(std::make_unique<FloatLiteralNode>(token.position, strippedValue,
-		                                             determine_float_type(token.value)));
+		                                             determine_float_type(std::string(token.value))));
 	} else if (token.type == Token::StringLiteral) {
-		return Ok(std::make_unique<StringLiteralNode>(token.position, token.value));
+		return Ok(std::make_unique<StringLiteralNode>(token.position, std::string(token.value)));
 	} else if (token.type == Token::CharLiteral) {
 		return Ok(std::make_unique<CharLiteralNode>(token.position, token.value[0]));
 	} else if (token.type == Token::BooleanLiteral) {
@@ -41,7 +43,7 @@ Result<std::unique_ptr<ASTNode>> Parser::parse_primary() {
 
 		// Not a lambda, parse as parenthesized expression
 		Result<std::unique_ptr<ASTNode>> expr = parse_expression();
-		Result<Token> token_error1 = expect(Token::RightParen, "Expected closing ')'");
+		Result<const Token*> token_error1 = expect(Token::RightParen, "Expected closing ')'");
 		if (!token_error1.has_value()) {
 			return Err<std::unique_ptr<ASTNode>>(token_error1.error());
 		}
@@ -49,350 +51,330 @@ Result<std::unique_ptr<ASTNode>> Parser::parse_primary() {
 		return expr;
 	}
 
-	Error error =
-	    Error(ErrorType::UnexpectedToken, "Unexpected token: " + token.value + " " + Token::getTypeAsString(token.type),
-	          Position("", token.position.line, token.position.column))
-	        .withActual(token.value);
+	Error error = Error(ErrorType::UnexpectedToken,
+	                    "Unexpected token: " + std::string(token.value) + " " + Token::getTypeAsString(token.type),
+	                    Position("", token.position.line, token.position.column))
+	                  .withActual(std::string(token.value));
 	return Err<std::unique_ptr<ASTNode>>(error);
 }
 
-Result<std::unique_ptr<ASTNode>> Parser::parse_additive_expression() {
-	Result<std::unique_ptr<ASTNode>> left = parse_multiplicative_expression();
-	if (!left.has_value()) {
-		return Err<std::unique_ptr<ASTNode>>(left.error());
-	}
-	while (peek().type == Token::Plus || peek().type == Token::Minus) {
-		Result<Token> op_error = advance();
-		if (!op_error.has_value()) {
-			return Err<std::unique_ptr<ASTNode>>(op_error.error());
-		}
-		Token op = op_error.value();
-
-		Token::Position pos = peek().position;
-		Result<std::unique_ptr<ASTNode>> right = parse_multiplicative_expression();
-		if (!right.has_value()) {
-			return Err<std::unique_ptr<ASTNode>>(right.error());
-		}
-		Token::Position left_pos = left.value()->position;
-		left = Ok(std::make_unique<BinaryExpressionNode>(
-		    left_pos, dynamic_unique_cast<ExpressionNode>(std::move(left.value())), op,
-		    dynamic_unique_cast<ExpressionNode>(std::move(right.value()))));
-	}
+namespace {
+	constexpr size_t TOKEN_TYPE_COUNT = Token::End + 1;
+
+	constexpr std::array<BinaryLevel, TOKEN_TYPE_COUNT> BINARY_LEVELS = [] {
+		std::array<BinaryLevel, TOKEN_TYPE_COUNT> levels{};
+		for (Token::Type type : {Token::Assign, Token::PlusAssign, Token::MinusAssign, Token::ReduceAssign,
+		                         Token::BitwiseOrAssign, Token::BitwiseXorAssign, Token::DivideAssign,
+		                         Token::MultiplyAssign, Token::FilterAssign, Token::MapAssign, Token::ModuloAssign,
+		                         Token::PipeAssign, Token::LeftShiftAssign, Token::RightShiftAssign}) {
+			levels[type] = BinaryLevel::Assignment;
+		}
+		levels[Token::DoubleQuestionMark] = BinaryLevel::Ternary;
+		levels[Token::MatchArrow] = BinaryLevel::Match;
+		levels[Token::Pipe] = levels[Token::MapPipe] = BinaryLevel::Pipe;
+		levels[Token::FilterRange] = BinaryLevel::Filter;
+		levels[Token::MapRange] = BinaryLevel::Map;
+		levels[Token::ReduceRange] = BinaryLevel::Reduce;
+		levels[Token::LogicalOr] = BinaryLevel::LogicalOr;
+		levels[Token::LogicalAnd] = BinaryLevel::LogicalAnd;
+		levels[Token::Equal] = levels[Token::NotEqual] = BinaryLevel::Equality;
+		for (Token::Type type : {Token::Greater, Token::GreaterEqual, Token::Less, Token::LessEqual}) {
+			levels[type] = BinaryLevel::Relational;
+		}
+		levels[Token::BitwiseOr] = levels[Token::BitwiseAnd] = levels[Token::BitwiseXor] = BinaryLevel::Bitwise;
+		levels[Token::LeftShift] = levels[Token::RightShift] = BinaryLevel::Shift;
+		levels[Token::KeywordTo] = BinaryLevel::To;
+		levels[Token::Plus] = levels[Token::Minus] = BinaryLevel::Additive;
+		levels[Token::Multiply] = levels[Token::Divide] = levels[Token::Modulo] = BinaryLevel::Multiplicative;
+		return levels;
+	}();
+
+	constexpr std::array<PrefixLevel, TOKEN_TYPE_COUNT> PREFIX_LEVELS = [] {
+		std::array<PrefixLevel, TOKEN_TYPE_COUNT> levels{};
+		levels[Token::BitwiseNot] = PrefixLevel::BitwiseNot;
+		levels[Token::LogicalNot] = PrefixLevel::LogicalNot;
+		levels[Token::KeywordAwait] = PrefixLevel::Await;
+		levels[Token::Dollar] = PrefixLevel::Iterator;
+		levels[Token::Plus] = PrefixLevel::Plus;
+		levels[Token::Minus] = PrefixLevel::Minus;
+		levels[Token::Increment] = levels[Token::Decrement] = PrefixLevel::Increment;
+		levels[Token::Ownership] = PrefixLevel::Ownership;
+		levels[Token::LogicalAnd] = levels[Token::MapRange] = PrefixLevel::Reference;
+		levels[Token::Multiply] = PrefixLevel::Deref;
+		return levels;
+	}();
+
+	template <typename Level>
+	constexpr Level tighter(Level level) {
+		return static_cast<Level>(static_cast<uint8_t>(level) + 1);
+	}
+} // namespace
 
-	return left;
+Result<std::unique_ptr<ASTNode>> Parser::parse_expression() {
+	return parse_binary_expression(BinaryLevel::Assignment);
 }
 
-Result<std::unique_ptr<ASTNode>> Parser::parse_multiplicative_expression() {
-	Result<std::unique_ptr<ASTNode>> left = parse_bitwise_not_expression();
+Result<std::unique_ptr<ASTNode>> Parser::parse_binary_expression(BinaryLevel min_level) {
+	Token::Position start_pos = peek().position;
+	Result<std::unique_ptr<ASTNode>> left = peek_type() == Token::KeywordPar && min_level <= BinaryLevel::Parallel
+	                                            ? parse_parallel_expression()
+	                                            : parse_unary_expression(PrefixLevel::BitwiseNot);
 	if (!left.has_value()) {
-		return Err<std::unique_ptr<ASTNode>>(left.error());
+		return left;
 	}
 
-	while (peek().type == Token::Multiply || peek().type == Token::Divide || peek().type == Token::Modulo) {
-		Result<Token> op_error = advance();
+	// Right operands can end early at a match expression, so after each operator only looser ones may follow, or
+	// equal ones where the operator chains
+	BinaryLevel max_level = BinaryLevel::Multiplicative;
+	while (true) {
+		BinaryLevel level = BINARY_LEVELS[peek_type()];
+		if (level < min_level || level > max_level) {
+			return left;
+		}
+
+		Result<const Token*> op_error = advance();
 		if (!op_error.has_value()) {
 			return Err<std::unique_ptr<ASTNode>>(op_error.error());
 		}
-		Token op = op_error.value();
+		const Token& op = *op_error.value();
+		Token::Position left_pos = left.value()->position;
 
-		Token::Position pos = peek().position;
-		Result<std::unique_ptr<ASTNode>> right = parse_bitwise_not_expression();
-		if (!right.has_value()) {
-			return Err<std::unique_ptr<ASTNode>>(right.error());
+		if (level == BinaryLevel::Match) {
+			left = parse_match_branches(start_pos, std::move(left.value()));
+			if (!left.has_value()) {
+				return left;
+			}
+			max_level = BinaryLevel::Ternary;
+			continue;
 		}
-		Token::Position left_pos = left.value()->position;
-		left = Ok(std::make_unique<BinaryExpressionNode>(
-		    left_pos, dynamic_unique_cast<ExpressionNode>(std::move(left.value())), op,
-		    dynamic_unique_cast<ExpressionNode>(std::move(right.value()))));
-	}
 
-	return left;
-}
+		if (level == BinaryLevel::Ternary) {
+			// Both branches may hold further ternaries, which makes the operator right-associative
+			Result<std::unique_ptr<ASTNode>> trueBranch = parse_binary_expression(BinaryLevel::Ternary);
+			if (!trueBranch.has_value()) {
+				return trueBranch;
+			}
 
-Result<std::unique_ptr<ASTNode>> Parser::parse_expression() {
-	return parse_assignment_expression();
-}
+			Result<const Token*> colon = expect(Token::Colon, "Expected ':' after ternary true branch");
+			if (!colon.has_value()) {
+				return Err<std::unique_ptr<ASTNode>>(colon.error());
+			}
 
-Parser::Parser(const std::vector<Token>& tokens) : tokens(tokens) {}
+			Result<std::unique_ptr<ASTNode>> falseBranch = parse_binary_expression(BinaryLevel::Ternary);
+			if (!falseBranch.has_value()) {
+				return falseBranch;
+			}
 
-Result<std::unique_ptr<ASTNode>> Parser::parse_logical_or_expression() {
-	Result<std::unique_ptr<ASTNode>> left = parse_logical_and_expression();
-	if (!left.has_value()) {
-		return Err<std::unique_ptr<ASTNode>>(left.error());
-	}
+			left = Ok(std::make_unique<TernaryExpressionNode>(
+			    left_pos, unique_node_cast<ExpressionNode>(std::move(left.value())),
+			    unique_node_cast<ExpressionNode>(std::move(trueBranch.value())),
+			    unique_node_cast<ExpressionNode>(std::move(falseBranch.value()))));
+			max_level = BinaryLevel::Assignment;
+			continue;
+		}
 
-	while (peek().type == Token::LogicalOr) {
-		Result<Token> op_error = advance();
-		if (!op_error.has_value()) {
-			return Err<std::unique_ptr<ASTNode>>(op_error.error());
+		// 'to=' is the inclusive form of 'to'
+		bool isInclusive = level == BinaryLevel::To && peek_type() == Token::Assign;
+		if (isInclusive) {
+			Result<const Token*> assign = advance();
+			if (!assign.has_value()) {
+				return Err<std::unique_ptr<ASTNode>>(assign.error());
+			}
 		}
-		Token op = op_error.value();
 
-		Token::Position pos = peek().position;
-		Result<std::unique_ptr<ASTNode>> right = parse_logical_and_expression();
+		// Every remaining operator is left-associative, so its right operand stops at the operator's own level
+		Result<std::unique_ptr<ASTNode>> right = parse_binary_expression(tighter(level));
 		if (!right.has_value()) {
-			return Err<std::unique_ptr<ASTNode>>(right.error());
+			return right;
+		}
+		max_level = level;
+
+		if (level == BinaryLevel::Assignment) {
+			left = Ok(std::make_unique<AssignmentExpressionNode>(
+			    left_pos, unique_node_cast<ExpressionNode>(std::move(left.value())), op,
+			    unique_node_cast<ExpressionNode>(std::move(right.value()))));
+		} else if (level == BinaryLevel::To) {
+			left = Ok(std::make_unique<ToExpressionNode>(
+			    left_pos, unique_node_cast<ExpressionNode>(std::move(left.value())),
+			    unique_node_cast<ExpressionNode>(std::move(right.value())), isInclusive));
+		} else {
+			left = Ok(std::make_unique<BinaryExpressionNode>(
+			    left_pos, unique_node_cast<ExpressionNode>(std::move(left.value())), op,
+			    unique_node_cast<ExpressionNode>(std::move(right.value()))));
 		}
-		Token::Position left_pos = left.value()->position;
-		left = Ok(std::make_unique<BinaryExpressionNode>(
-		    left_pos, dynamic_unique_cast<ExpressionNode>(std::move(left.value())), op,
-		    dynamic_unique_cast<ExpressionNode>(std::move(right.value()))));
 	}
-
-	return left;
 }
 
-Result<std::unique_ptr<ASTNode>> Parser::parse_logical_and_expression() {
-	Result<std::unique_ptr<ASTNode>> left = parse_equality_expression();
-	if (!left.has_value()) {
-		return Err<std::unique_ptr<ASTNode>>(left.error());
-	}
+Result<std::unique_ptr<ASTNode>> Parser::parse_unary_expression(PrefixLevel min_level) {
+	PrefixLevel level = PREFIX_LEVELS[peek_type()];
+	Result<std::unique_ptr<ASTNode>> operand;
 
-	while (peek().type == Token::LogicalAnd) {
-		Result<Token> op_error = advance();
+	if (level >= min_level) {
+		Result<const Token*> op_error = advance();
 		if (!op_error.has_value()) {
 			return Err<std::unique_ptr<ASTNode>>(op_error.error());
 		}
-		Token op = op_error.value();
+		const Token& op = *op_error.value();
 
-		Token::Position pos = peek().position;
-		Result<std::unique_ptr<ASTNode>> right = parse_equality_expression();
-		if (!right.has_value()) {
-			return Err<std::unique_ptr<ASTNode>>(right.error());
+		operand = parse_unary_expression(tighter(level));
+		if (!operand.has_value()) {
+			return operand;
 		}
-		Token::Position left_pos = left.value()->position;
-		left = Ok(std::make_unique<BinaryExpressionNode>(
-		    left_pos, dynamic_unique_cast<ExpressionNode>(std::move(left.value())), op,
-		    dynamic_unique_cast<ExpressionNode>(std::move(right.value()))));
-	}
 
-	return left;
-}
+		// '*~' and prefix '++'/'--' take the position of their operand, every other prefix its own
+		bool operandPosition = level == PrefixLevel::BitwiseNot || level == PrefixLevel::Increment;
+		Token::Position pos = operandPosition ? operand.value()->position : op.position;
+		operand = Ok(std::make_unique<UnaryExpressionNode>(
+		    pos, op, unique_node_cast<ExpressionNode>(std::move(operand.value()))));
 
-Result<std::unique_ptr<ASTNode>> Parser::parse_equality_expression() {
-	Result<std::unique_ptr<ASTNode>> left = parse_relational_expression();
-	if (!left.has_value()) {
-		return Err<std::unique_ptr<ASTNode>>(left.error());
+		// Looser prefixes parsed their operand from the Postfix level, which already took the postfix operators
+		if (level < PrefixLevel::Postfix) {
+			return operand;
+		}
+	} else {
+		operand = parse_range_expression();
+		if (!operand.has_value()) {
+			return operand;
+		}
+	}
+
+	if (min_level > PrefixLevel::Postfix) {
+		return operand;
 	}
 
-	while (peek().type == Token::Equal || peek().type == Token::NotEqual) {
-		Result<Token> op_error = advance();
+	while (peek_type() == Token::Increment || peek_type() == Token::Decrement) {
+		Result<const Token*> op_error = advance();
 		if (!op_error.has_value()) {
 			return Err<std::unique_ptr<ASTNode>>(op_error.error());
 		}
-		Token op = op_error.value();
-
-		Token::Position pos = peek().position;
-		Result<std::unique_ptr<ASTNode>> right = parse_relational_expression();
-		if (!right.has_value()) {
-			return Err<std::unique_ptr<ASTNode>>(right.error());
-		}
-
-		Token::Position left_pos = left.value()->position;
-		left = Ok(std::make_unique<BinaryExpressionNode>(
-		    left_pos, dynamic_unique_cast<ExpressionNode>(std::move(left.value())), op,
-		    dynamic_unique_cast<ExpressionNode>(std::move(right.value()))));
+		Token::Position left_pos = operand.value()->position;
+		operand = Ok(std::make_unique<UnaryPostExpressionNode>(
+		    left_pos, *op_error.value(), unique_node_cast<ExpressionNode>(std::move(operand.value()))));
 	}
+	return operand;
+}
 
-	return left;
+Result<std::unique_ptr<ASTNode>> Parser::parse_assignment_expression() {
+	return parse_binary_expression(BinaryLevel::Assignment);
 }
 
-Result<std::unique_ptr<ASTNode>> Parser::parse_relational_expression() {
-	Result<std::unique_ptr<ASTNode>> left = parse_bitwise_expression();
-	if (!left.has_value()) {
-		return Err<std::unique_ptr<ASTNode>>(left.error());
-	}
+Result<std::unique_ptr<ASTNode>> Parser::parse_ternary_expression() {
+	return parse_binary_expression(BinaryLevel::Ternary);
+}
 
-	while (peek().type == Token::Greater || peek().type == Token::GreaterEqual || peek().type == Token::Less ||
-	       peek().type == Token::LessEqual) {
-		Result<Token> op_error = advance();
-		if (!op_error.has_value()) {
-			return Err<std::unique_ptr<ASTNode>>(op_error.error());
-		}
-		Token op = op_error.value();
+Result<std::unique_ptr<ASTNode>> Parser::parse_match_expression() {
+	return parse_binary_expression(BinaryLevel::Match);
+}
 
-		Token::Position pos = peek().position;
-		Result<std::unique_ptr<ASTNode>> right = parse_bitwise_expression();
-		if (!right.has_value()) {
-			return Err<std::unique_ptr<ASTNode>>(right.error());
-		}
+Result<std::unique_ptr<ASTNode>> Parser::parse_pipe_expression() {
+	return parse_binary_expression(BinaryLevel::Pipe);
+}
 
-		Token::Position left_pos = left.value()->position;
-		left = Ok(std::make_unique<BinaryExpressionNode>(
-		    left_pos, dynamic_unique_cast<ExpressionNode>(std::move(left.value())), op,
-		    dynamic_unique_cast<ExpressionNode>(std::move(right.value()))));
-	}
-	return left;
+Result<std::unique_ptr<ASTNode>> Parser::parse_filter_expression() {
+	return parse_binary_expression(BinaryLevel::Filter);
 }
 
-Result<std::unique_ptr<ASTNode>> Parser::parse_bitwise_expression() {
-	Result<std::unique_ptr<ASTNode>> left = parse_shift_expression();
-	if (!left.has_value()) {
-		return Err<std::unique_ptr<ASTNode>>(left.error());
-	}
+Result<std::unique_ptr<ASTNode>> Parser::parse_map_expression() {
+	return parse_binary_expression(BinaryLevel::Map);
+}
 
-	while (peek().type == Token::BitwiseOr || peek().type == Token::BitwiseAnd || peek().type == Token::BitwiseXor) {
-		Result<Token> op_error = advance();
-		if (!op_error.has_value()) {
-			return Err<std::unique_ptr<ASTNode>>(op_error.error());
-		}
-		Token op = op_error.value();
+Result<std::unique_ptr<ASTNode>> Parser::parse_reduce_expression() {
+	return parse_binary_expression(BinaryLevel::Reduce);
+}
 
-		Token::Position pos = peek().position;
-		Result<std::unique_ptr<ASTNode>> right = parse_shift_expression();
-		if (!right.has_value()) {
-			return Err<std::unique_ptr<ASTNode>>(right.error());
-		}
+Result<std::unique_ptr<ASTNode>> Parser::parse_logical_or_expression() {
+	return parse_binary_expression(BinaryLevel::LogicalOr);
+}
 
-		Token::Position left_pos = left.value()->position;
-		left = Ok(std::make_unique<BinaryExpressionNode>(
-		    left_pos, dynamic_unique_cast<ExpressionNode>(std::move(left.value())), op,
-		    dynamic_unique_cast<ExpressionNode>(std::move(right.value()))));
-	}
-	return left;
+Result<std::unique_ptr<ASTNode>> Parser::parse_logical_and_expression() {
+	return parse_binary_expression(BinaryLevel::LogicalAnd);
 }
 
-Result<std::unique_ptr<ASTNode>> Parser::parse_shift_expression() {
-	Result<std::unique_ptr<ASTNode>> left = parse_to_expression();
-	if (!left.has_value()) {
-		return Err<std::unique_ptr<ASTNode>>(left.error());
-	}
+Result<std::unique_ptr<ASTNode>> Parser::parse_equality_expression() {
+	return parse_binary_expression(BinaryLevel::Equality);
+}
 
-	while (peek().type == Token::LeftShift || peek().type == Token::RightShift) {
-		Result<Token> op_error = advance();
-		if (!op_error.has_value()) {
-			return Err<std::unique_ptr<ASTNode>>(op_error.error());
-		}
-		Token op = op_error.value();
+Result<std::unique_ptr<ASTNode>> Parser::parse_relational_expression() {
+	return parse_binary_expression(BinaryLevel::Relational);
+}
 
-		Token::Position pos = peek().position;
-		Result<std::unique_ptr<ASTNode>> right = parse_to_expression();
-		if (!right.has_value()) {
-			return Err<std::unique_ptr<ASTNode>>(right.error());
-		}
-		Token::Position left_pos = left.value()->position;
-		left = Ok(std::make_unique<BinaryExpressionNode>(
-		    left_pos, dynamic_unique_cast<ExpressionNode>(std::move(left.value())), op,
-		    dynamic_unique_cast<ExpressionNode>(std::move(right.value()))));
-	}
-	return left;
+Result<std::unique_ptr<ASTNode>> Parser::parse_bitwise_expression() {
+	return parse_binary_expression(BinaryLevel::Bitwise);
 }
 
-Result<std::unique_ptr<ASTNode>> Parser::parse_ternary_expression() {
-	Result<std::unique_ptr<ASTNode>> condition = parse_match_expression();
-	if (!condition.has_value()) {
-		return Err<std::unique_ptr<ASTNode>>(condition.error());
-	}
+Result<std::unique_ptr<ASTNode>> Parser::parse_shift_expression() {
+	return parse_binary_expression(BinaryLevel::Shift);
+}
 
-	if (peek().type == Token::DoubleQuestionMark) {
-		Result<Token> question_mark = advance();
-		if (!question_mark.has_value()) {
-			return Err<std::unique_ptr<ASTNode>>(question_mark.error());
-		}
+Result<std::unique_ptr<ASTNode>> Parser::parse_to_expression() {
+	return parse_binary_expression(BinaryLevel::To);
+}
 
-		// Parse true branch
-		Result<std::unique_ptr<ASTNode>> trueBranch = parse_ternary_expression();
-		if (!trueBranch.has_value()) {
-			return Err<std::unique_ptr<ASTNode>>(trueBranch.error());
-		}
+Result<std::unique_ptr<ASTNode>> Parser::parse_additive_expression() {
+	return parse_binary_expression(BinaryLevel::Additive);
+}
 
-		// Expect colon
-		Result<Token> colon = expect(Token::Colon, "Expected ':' after ternary true branch");
-		if (!colon.has_value()) {
-			return Err<std::unique_ptr<ASTNode>>(colon.error());
-		}
+Result<std::unique_ptr<ASTNode>> Parser::parse_multiplicative_expression() {
+	return parse_binary_expression(BinaryLevel::Multiplicative);
+}
 
-		// Parse false branch (right-associative, so parse another ternary for nesting)
-		Result<std::unique_ptr<ASTNode>> falseBranch = parse_ternary_expression();
-		if (!falseBranch.has_value()) {
-			return Err<std::unique_ptr<ASTNode>>(falseBranch.error());
-		}
+Result<std::unique_ptr<ASTNode>> Parser::parse_bitwise_not_expression() {
+	return parse_unary_expression(PrefixLevel::BitwiseNot);
+}
 
-		Token::Position pos = condition.value()->position;
-		return Ok(std::make_unique<TernaryExpressionNode>(
-		    pos, dynamic_unique_cast<ExpressionNode>(std::move(condition.value())),
-		    dynamic_unique_cast<ExpressionNode>(std::move(trueBranch.value())),
-		    dynamic_unique_cast<ExpressionNode>(std::move(falseBranch.value()))));
-	}
+Result<std::unique_ptr<ASTNode>> Parser::parse_logical_not_expression() {
+	return parse_unary_expression(PrefixLevel::LogicalNot);
+}
 
-	return condition;
+Result<std::unique_ptr<ASTNode>> Parser::parse_await_expression() {
+	return parse_unary_expression(PrefixLevel::Await);
 }
 
-Result<std::unique_ptr<ASTNode>> Parser::parse_assignment_expression() {
-	Result<std::unique_ptr<ASTNode>> left = parse_ternary_expression();
-	if (!left.has_value()) {
-		return Err<std::unique_ptr<ASTNode>>(left.error());
-	}
+Result<std::unique_ptr<ASTNode>> Parser::parse_iterator_expression() {
+	return parse_unary_expression(PrefixLevel::Iterator);
+}
 
-	while (peek().type == Token::Assign ||
-	peek().type == Token::PlusAssign ||
-	peek().type == Token::MinusAssign ||
-	peek().type == Token::ReduceAssign ||
-	peek().type == Token::BitwiseOrAssign ||
-	peek().type == Token::BitwiseOrAssign ||
-	peek().type == Token::BitwiseXorAssign ||
-	peek().type == Token::DivideAssign ||
-	peek().type == Token::MultiplyAssign ||
-	peek().type == Token::FilterAssign ||
-	peek().type == Token::MapAssign ||
-	peek().type == Token::ModuloAssign ||
-	peek().type == Token::PipeAssign ||
-	peek().type == Token::LeftShiftAssign ||
-	peek().type == Token::RightShiftAssign) {
-		Result<Token> assign = advance();
-		if (!assign.has_value()) {
-			return Err<std::unique_ptr<ASTNode>>(assign.error());
-		}
+Result<std::unique_ptr<ASTNode>> Parser::parse_unary_plus_expression() {
+	return parse_unary_expression(PrefixLevel::Plus);
+}
 
-		Token::Position pos = peek().position;
-		Result<std::unique_ptr<ASTNode>> right = parse_ternary_expression();
-		if (!right.has_value()) {
-			return Err<std::unique_ptr<ASTNode>>(right.error());
-		}
-		Token::Position left_pos = left.value()->position;
-		left = Ok(std::make_unique<AssignmentExpressionNode>(
-		    left_pos, dynamic_unique_cast<ExpressionNode>(std::move(left.value())), assign.value(),
-		    dynamic_unique_cast<ExpressionNode>(std::move(right.value()))));
-	}
+Result<std::unique_ptr<ASTNode>> Parser::parse_unary_minus_expression() {
+	return parse_unary_expression(PrefixLevel::Minus);
+}
 
-	return left;
+Result<std::unique_ptr<ASTNode>> Parser::parse_increment_expression() {
+	return parse_unary_expression(PrefixLevel::Postfix);
 }
 
-Result<std::unique_ptr<ASTNode>> Parser::parse_pipe_expression() {
-	Result<std::unique_ptr<ASTNode>> left = parse_parallel_expression();
-	if (!left.has_value()) {
-		return Err<std::unique_ptr<ASTNode>>(left.error());
-	}
+Result<std::unique_ptr<ASTNode>> Parser::parse_post_increment_expression() {
+	return parse_unary_expression(PrefixLevel::Increment);
+}
 
-	while (peek().type == Token::Pipe || peek().type == Token::MapPipe) {
-		Result<Token> op_error = advance();
-		if (!op_error.has_value()) {
-			return Err<std::unique_ptr<ASTNode>>(op_error.error());
-		}
-		Token op = op_error.value();
+Result<std::unique_ptr<ASTNode>> Parser::parse_ownership_expression() {
+	return parse_unary_expression(PrefixLevel::Ownership);
+}
 
-		Token::Position pos = peek().position;
-		Result<std::unique_ptr<ASTNode>> right = parse_parallel_expression();
-		if (!right.has_value()) {
-			return Err<std::unique_ptr<ASTNode>>(right.error());
-		}
-		Token::Position left_pos = left.value()->position;
-		left = Ok(std::make_unique<BinaryExpressionNode>(
-		    left_pos, dynamic_unique_cast<ExpressionNode>(std::move(left.value())), op,
-		    dynamic_unique_cast<ExpressionNode>(std::move(right.value()))));
-	}
+Result<std::unique_ptr<ASTNode>> Parser::parse_reference_expression() {
+	return parse_unary_expression(PrefixLevel::Reference);
+}
 
-	return left;
+Result<std::unique_ptr<ASTNode>> Parser::parse_deref_expression() {
+	return parse_unary_expression(PrefixLevel::Deref);
 }
 
+Parser::Parser(const std::vector<Token>& tokens)
+    : owned_tokens(std::make_unique<TokenStream>(tokens)), tokens(*owned_tokens) {}
+
+Parser::Parser(TokenStream& tokens) : tokens(tokens) {}
+
 Result<std::unique_ptr<ASTNode>> Parser::parse_member_access_expression() {
 	Result<std::unique_ptr<ASTNode>> left = parse_primary();
 	if (!left.has_value()) {
 		return Err<std::unique_ptr<ASTNode>>(left.error());
 	}
 
-	while (peek().type == Token::Dot || peek().type == Token::DoubleColon) {
-		Result<Token> access_type = advance();
+	while (peek_type() == Token::Dot || peek_type() == Token::DoubleColon) {
+		Result<const Token*> access_type = advance();
 		if (!access_type.has_value()) {
 			return Err<std::unique_ptr<ASTNode>>(access_type.error());
 		}
@@ -404,8 +386,8 @@ Result<std::unique_ptr<ASTNode>> Parser::parse_member_access_expression() {
 		}
 		Token::Position left_pos = left.value()->position;
 		left = Ok(std::make_unique<MemberAccessExpressionNode>(
-		    left_pos, dynamic_unique_cast<ExpressionNode>(std::move(left.value())), access_type.value(),
-		    dynamic_unique_cast<ExpressionNode>(std::move(right.value()))));
+		    left_pos, unique_node_cast<ExpressionNode>(std::move(left.value())), *access_type.value(),
+		    unique_node_cast<ExpressionNode>(std::move(right.value()))));
 	}
 	return left;
 }
@@ -416,8 +398,8 @@ Result<std::unique_ptr<ASTNode>> Parser::parse_index_expression() {
 		return Err<std::unique_ptr<ASTNode>>(left.error());
 	}
 
-	while (peek().type == Token::LeftBracket) {
-		Result<Token> left_bracket = expect(Token::LeftBracket, "Expected '['");
+	while (peek_type() == Token::LeftBracket) {
+		Result<const Token*> left_bracket = expect(Token::LeftBracket, "Expected '['");
 		if (!left_bracket.has_value()) {
 			return Err<std::unique_ptr<ASTNode>>(left_bracket.error());
 		}
@@ -427,12 +409,12 @@ Result<std::unique_ptr<ASTNode>> Parser::parse_index_expression() {
 
 		// Check for slice expression (start:end) or multiple indices (idx1,idx2,idx3)
 		Result<std::unique_ptr<ASTNode>> arrayExpr =
-		    parse_advanced_array_expression(dynamic_unique_cast<ExpressionNode>(std::move(left.value())));
+		    parse_advanced_array_expression(unique_node_cast<ExpressionNode>(std::move(left.value())));
 		if (!arrayExpr.has_value()) {
 			return Err<std::unique_ptr<ASTNode>>(arrayExpr.error());
 		}
 
-		Result<Token> right_bracket = expect(Token::RightBracket, "Expected ']'");
+		Result<const Token*> right_bracket = expect(Token::RightBracket, "Expected ']'");
 		if (!right_bracket.has_value()) {
 			return Err<std::unique_ptr<ASTNode>>(right_bracket.error());
 		}
@@ -453,8 +435,8 @@ Result<std::unique_ptr<ASTNode>> Parser::parse_advanced_array_expression(std::un
 	}
 
 	// Check if this is a slice expression (contains ':')
-	if (peek().type == Token::Colon) {
-		Result<Token> colon = advance();
+	if (peek_type() == Token::Colon) {
+		Result<const Token*> colon = advance();
 		if (!colon.has_value()) {
 			return Err<std::unique_ptr<ASTNode>>(colon.error());
 		}
@@ -467,18 +449,18 @@ Result<std::unique_ptr<ASTNode>> Parser::parse_advanced_array_expression(std::un
 
 		// Create slice expression
 		return Ok(std::make_unique<SliceExpressionNode>(
-		    start_pos, std::move(array_expr), dynamic_unique_cast<ExpressionNode>(std::move(firstExpr.value())),
-		    dynamic_unique_cast<ExpressionNode>(std::move(endExpr.value())),
+		    start_pos, std::move(array_expr), unique_node_cast<ExpressionNode>(std::move(firstExpr.value())),
+		    unique_node_cast<ExpressionNode>(std::move(endExpr.value())),
 		    true // inclusive by default
 		    ));
 	}
 
 	// Check if this is a multiple index expression (contains ',')
 	std::vector<std::unique_ptr<ExpressionNode>> indices;
-	indices.push_back(dynamic_unique_cast<ExpressionNode>(std::move(firstExpr.value())));
+	indices.push_back(unique_node_cast<ExpressionNode>(std::move(firstExpr.value())));
 
-	while (peek().type == Token::Comma) {
-		Result<Token> comma = advance();
+	while (peek_type() == Token::Comma) {
+		Result<const Token*> comma = advance();
 		if (!comma.has_value()) {
 			return Err<std::unique_ptr<ASTNode>>(comma.error());
 		}
@@ -488,7 +470,7 @@ Result<std::unique_ptr<ASTNode>> Parser::parse_advanced_array_expression(std::un
 			return Err<std::unique_ptr<ASTNode>>(nextExpr.error());
 		}
 
-		indices.push_back(dynamic_unique_cast<ExpressionNode>(std::move(nextExpr.value())));
+		indices.push_back(unique_node_cast<ExpressionNode>(std::move(nextExpr.value())));
 	}
 
 	// If we have multiple indices, create MultipleIndexExpression
@@ -500,104 +482,23 @@ Result<std::unique_ptr<ASTNode>> Parser::parse_advanced_array_expression(std::un
 	return Ok(std::make_unique<IndexExpressionNode>(start_pos, std::move(array_expr), std::move(indices[0])));
 }
 
-Result<std::unique_ptr<ASTNode>> Parser::parse_filter_expression() {
-	Result<std::unique_ptr<ASTNode>> left = parse_map_expression();
-	if (!left.has_value()) {
-		return Err<std::unique_ptr<ASTNode>>(left.error());
-	}
-
-	while (peek().type == Token::FilterRange) {
-		Result<Token> op_error = advance();
-		if (!op_error.has_value()) {
-			return Err<std::unique_ptr<ASTNode>>(op_error.error());
-		}
-		Token op = op_error.value();
-
-		Token::Position pos = peek().position;
-		Result<std::unique_ptr<ASTNode>> right = parse_map_expression();
-		if (!right.has_value()) {
-			return Err<std::unique_ptr<ASTNode>>(right.error());
-		}
-		Token::Position left_pos = left.value()->position;
-		left = Ok(std::make_unique<BinaryExpressionNode>(
-		    left_pos, dynamic_unique_cast<ExpressionNode>(std::move(left.value())), op,
-		    dynamic_unique_cast<ExpressionNode>(std::move(right.value()))));
-	}
-
-	return left;
-}
-
-Result<std::unique_ptr<ASTNode>> Parser::parse_map_expression() {
-	Result<std::unique_ptr<ASTNode>> left = parse_reduce_expression();
-	if (!left.has_value()) {
-		return Err<std::unique_ptr<ASTNode>>(left.error());
-	}
-
-	while (peek().type == Token::MapRange) {
-		Result<Token> op_error = advance();
-		if (!op_error.has_value()) {
-			return Err<std::unique_ptr<ASTNode>>(op_error.error());
-		}
-		Token op = op_error.value();
-
-		Token::Position pos = peek().position;
-		Result<std::unique_ptr<ASTNode>> right = parse_reduce_expression();
-		if (!right.has_value()) {
-			return Err<std::unique_ptr<ASTNode>>(right.error());
-		}
-		Token::Position left_pos = left.value()->position;
-		left = Ok(std::make_unique<BinaryExpressionNode>(
-		    left_pos, dynamic_unique_cast<ExpressionNode>(std::move(left.value())), op,
-		    dynamic_unique_cast<ExpressionNode>(std::move(right.value()))));
-	}
-
-	return left;
-}
-
-Result<std::unique_ptr<ASTNode>> Parser::parse_reduce_expression() {
-	Result<std::unique_ptr<ASTNode>> left = parse_logical_or_expression();
-	if (!left.has_value()) {
-		return Err<std::unique_ptr<ASTNode>>(left.error());
-	}
-
-	while (peek().type == Token::ReduceRange) {
-		Result<Token> op_error = advance();
-		if (!op_error.has_value()) {
-			return Err<std::unique_ptr<ASTNode>>(op_error.error());
-		}
-		Token op = op_error.value();
-
-		Token::Position pos = peek().position;
-		Result<std::unique_ptr<ASTNode>> right = parse_logical_or_expression();
-		if (!right.has_value()) {
-			return Err<std::unique_ptr<ASTNode>>(right.error());
-		}
-		Token::Position left_pos = left.value()->position;
-		left = Ok(std::make_unique<BinaryExpressionNode>(
-		    left_pos, dynamic_unique_cast<ExpressionNode>(std::move(left.value())), op,
-		    dynamic_unique_cast<ExpressionNode>(std::move(right.value()))));
-	}
-
-	return left;
-}
-
 Result<std::unique_ptr<ASTNode>> Parser::parse_range_expression() {
-	if (peek().type != Token::LeftBracket)
+	if (peek_type() != Token::LeftBracket)
 		return parse_function_call_expression();
 
-	Result<Token> left_bracket = advance();
+	Result<const Token*> left_bracket = advance();
 	if (!left_bracket.has_value()) {
 		return Err<std::unique_ptr<ASTNode>>(left_bracket.error());
 	}
 
 	std::vector<std::unique_ptr<ExpressionNode>> elements;
 
-	while (peek().type != Token::RightBracket) {
+	while (peek_type() != Token::RightBracket) {
 		Token::Position pos = peek().position;
 		Result<std::unique_ptr<ASTNode>> element;
 
 		// Check if this is a nested array literal
-		if (peek().type == Token::LeftBracket) {
+		if (peek_type() == Token::LeftBracket) {
 			element = parse_nested_array_literal();
 		} else {
 			element = parse_expression();
@@ -607,57 +508,57 @@ Result<std::unique_ptr<ASTNode>> Parser::parse_range_expression() {
 			return Err<std::unique_ptr<ASTNode>>(element.error());
 		}
 
-		elements.push_back(dynamic_unique_cast<ExpressionNode>(std::move(element.value())));
+		elements.push_back(unique_node_cast<ExpressionNode>(std::move(element.value())));
 
-		if (peek().type != Token::Comma)
+		if (peek_type() != Token::Comma)
 			break;
 
-		Result<Token> comma = advance();
+		Result<const Token*> comma = advance();
 		if (!comma.has_value()) {
 			return Err<std::unique_ptr<ASTNode>>(comma.error());
 		}
 	}
 
-	Result<Token> right_bracket = expect(Token::RightBracket, "Expected ']' to close the range expression");
+	Result<const Token*> right_bracket = expect(Token::RightBracket, "Expected ']' to close the range expression");
 	if (!right_bracket.has_value()) {
 		return Err<std::unique_ptr<ASTNode>>(right_bracket.error());
 	}
 
-	return Ok(std::make_unique<RangeExpressionNode>(left_bracket.value().position, std::move(elements)));
+	return Ok(std::make_unique<RangeExpressionNode>(left_bracket.value()->position, std::move(elements)));
 }
 
 Result<std::unique_ptr<ASTNode>> Parser::parse_nested_array_literal() {
-	Result<Token> left_bracket = advance();
+	Result<const Token*> left_bracket = advance();
 	if (!left_bracket.has_value()) {
 		return Err<std::unique_ptr<ASTNode>>(left_bracket.error());
 	}
 
 	std::vector<std::unique_ptr<ExpressionNode>> elements;
 
-	while (peek().type != Token::RightBracket) {
+	while (peek_type() != Token::RightBracket) {
 		Token::Position pos = peek().position;
 		Result<std::unique_ptr<ASTNode>> element = parse_function_call_expression();
 		if (!element.has_value()) {
 			return Err<std::unique_ptr<ASTNode>>(element.error());
 		}
 
-		elements.push_back(dynamic_unique_cast<ExpressionNode>(std::move(element.value())));
+		elements.push_back(unique_node_cast<ExpressionNode>(std::move(element.value())));
 
-		if (peek().type != Token::Comma)
+		if (peek_type() != Token::Comma)
 			break;
 
-		Result<Token> comma = advance();
+		Result<const Token*> comma = advance();
 		if (!comma.has_value()) {
 			return Err<std::unique_ptr<ASTNode>>(comma.error());
 		}
 	}
 
-	Result<Token> right_bracket = expect(Token::RightBracket, "Expected ']' to close the nested array literal");
+	Result<const Token*> right_bracket = expect(Token::RightBracket, "Expected ']' to close the nested array literal");
 	if (!right_bracket.has_value()) {
 		return Err<std::unique_ptr<ASTNode>>(right_bracket.error());
 	}
 
-	return Ok(std::make_unique<RangeExpressionNode>(left_bracket.value().position, std::move(elements)));
+	return Ok(std::make_unique<RangeExpressionNode>(left_bracket.value()->position, std::move(elements)));
 }
 
 Result<std::unique_ptr<ASTNode>> Parser::parse_function_call_expression() {
@@ -667,7 +568,7 @@ Result<std::unique_ptr<ASTNode>> Parser::parse_function_call_expression() {
 	}
 
 	// Check for generic type arguments followed by function call: func<Type1, Type2>(args)
-	if (peek().type == Token::Less) {
+	if (peek_type() == Token::Less) {
 		// Look ahead to see if this is followed by a function call
 		size_t saved_pos = current;
 		advance(); // consume '<'
@@ -675,15 +576,23 @@ Result<std::unique_ptr<ASTNode>> Parser::parse_function_call_expression() {
 		// Skip over the generic arguments to see if there's a '(' after
 		int angle_bracket_depth = 1;
 		bool found_function_call = false;
-		while (angle_bracket_depth > 0 && current < tokens.size()) {
-			if (peek().type == Token::Less)
+		// Types never contain ';', '{' or '}', so the lookahead for a comparison such as a < b ends at the
+		// statement instead of running on to the next '>' in the file
+		bool ended_early = false;
+		while (angle_bracket_depth > 0 && tokens.has(current)) {
+			Token::Type type = peek_type();
+			if (type == Token::Semicolon || type == Token::LeftBrace || type == Token::RightBrace) {
+				ended_early = true;
+				break;
+			}
+			if (type == Token::Less)
 				angle_bracket_depth++;
-			else if (peek().type == Token::Greater)
+			else if (type == Token::Greater)
 				angle_bracket_depth--;
 			advance();
 		}
 
-		if (current < tokens.size() && peek().type == Token::LeftParen) {
+		if (!ended_early && tokens.has(current) && peek_type() == Token::LeftParen) {
 			found_function_call = true;
 		}
 
@@ -693,7 +602,7 @@ Result<std::unique_ptr<ASTNode>> Parser::parse_function_call_expression() {
 		if (found_function_call) {
 			std::vector<std::unique_ptr<TypeNode>> genericTypeArgs;
 			Token::Position less_pos = peek().position;
-			Result<Token> less = advance();
+			Result<const Token*> less = advance();
 			if (!less.has_value()) {
 				return Err<std::unique_ptr<ASTNode>>(less.error());
 			}
@@ -708,9 +617,9 @@ Result<std::unique_ptr<ASTNode>> Parser::parse_function_call_expression() {
 
 				genericTypeArgs.push_back(std::move(typeArg.value()));
 
-				if (peek().type == Token::Comma) {
+				if (peek_type() == Token::Comma) {
 					Token::Position commaPos = peek().position;
-					Result<Token> comma = advance();
+					Result<const Token*> comma = advance();
 					if (!comma.has_value()) {
 						return Err<std::unique_ptr<ASTNode>>(comma.error());
 					}
@@ -720,368 +629,88 @@ Result<std::unique_ptr<ASTNode>> Parser::parse_function_call_expression() {
 			} while (true);
 
 			Token::Position greaterPos = peek().position;
-			Result<Token> greater = expect(Token::Greater, "Expected '>' after generic type arguments");
+			Result<const Token*> greater = expect(Token::Greater, "Expected '>' after generic type arguments");
 			if (!greater.has_value()) {
 				return Err<std::unique_ptr<ASTNode>>(greater.error());
 			}
 
 			// Now parse the function call
-			if (peek().type == Token::LeftParen) {
-				Result<Token> leftParen = advance();
+			if (peek_type() == Token::LeftParen) {
+				Result<const Token*> leftParen = advance();
 				if (!leftParen.has_value()) {
 					return Err<std::unique_ptr<ASTNode>>(leftParen.error());
 				}
 
 				std::vector<std::unique_ptr<ExpressionNode>> arguments;
-				while (peek().type != Token::RightParen) {
+				while (peek_type() != Token::RightParen) {
 					Token::Position pos = peek().position;
 					Result<std::unique_ptr<ASTNode>> argument = parse_expression();
 					if (!argument.has_value()) {
 						return Err<std::unique_ptr<ASTNode>>(argument.error());
 					}
 
-					arguments.push_back(dynamic_unique_cast<ExpressionNode>(std::move(argument.value())));
-					if (peek().type == Token::RightParen)
+					arguments.push_back(unique_node_cast<ExpressionNode>(std::move(argument.value())));
+					if (peek_type() == Token::RightParen)
 						break;
 
-					Result<Token> comma = expect(Token::Comma, "Expected ',' between function arguments");
+					Result<const Token*> comma = expect(Token::Comma, "Expected ',' between function arguments");
 					if (!comma.has_value()) {
 						return Err<std::unique_ptr<ASTNode>>(comma.error());
 					}
 				}
-				Result<Token> rightParen = expect(Token::RightParen, "Expected ')' after function arguments");
+				Result<const Token*> rightParen = expect(Token::RightParen, "Expected ')' after function arguments");
 				if (!rightParen.has_value()) {
 					return Err<std::unique_ptr<ASTNode>>(rightParen.error());
 				}
 
 				Token::Position left_pos = left.value()->position;
 				left = Ok(std::make_unique<FunctionCallExpressionNode>(
-				    left_pos, dynamic_unique_cast<ExpressionNode>(std::move(left.value())), std::move(arguments),
+				    left_pos, unique_node_cast<ExpressionNode>(std::move(left.value())), std::move(arguments),
 				    std::move(genericTypeArgs)));
 			}
 		}
 	}
 
-	while (peek().type == Token::LeftParen) {
-		Result<Token> leftParen = advance();
+	while (peek_type() == Token::LeftParen) {
+		Result<const Token*> leftParen = advance();
 		if (!leftParen.has_value()) {
 			return Err<std::unique_ptr<ASTNode>>(leftParen.error());
 		}
 
 		std::vector<std::unique_ptr<ExpressionNode>> arguments;
-		while (peek().type != Token::RightParen) {
+		while (peek_type() != Token::RightParen) {
 			Token::Position pos = peek().position;
 			Result<std::unique_ptr<ASTNode>> argument = parse_expression();
 			if (!argument.has_value()) {
 				return Err<std::unique_ptr<ASTNode>>(argument.error());
 			}
 
-			arguments.push_back(dynamic_unique_cast<ExpressionNode>(std::move(argument.value())));
-			if (peek().type == Token::RightParen)
+			arguments.push_back(unique_node_cast<ExpressionNode>(std::move(argument.value())));
+			if (peek_type() == Token::RightParen)
 				break;
 
-			Result<Token> comma = expect(Token::Comma, "Expected ',' between function arguments");
+			Result<const Token*> comma = expect(Token::Comma, "Expected ',' between function arguments");
 			if (!comma.has_value()) {
 				return Err<std::unique_ptr<ASTNode>>(comma.error());
 			}
 		}
-		Result<Token> rightParen = expect(Token::RightParen, "Expected ')' after function arguments");
+		Result<const Token*> rightParen = expect(Token::RightParen, "Expected ')' after function arguments");
 		if (!rightParen.has_value()) {
 			return Err<std::unique_ptr<ASTNode>>(rightParen.error());
 		}
 		Token::Position left_pos = left.value()->position;
 		left = Ok(std::make_unique<FunctionCallExpressionNode>(
-		    left_pos, dynamic_unique_cast<ExpressionNode>(std::move(left.value())), std::move(arguments)));
-	}
-
-	return left;
-}
-
-Result<std::unique_ptr<ASTNode>> Parser::parse_to_expression() {
-	Result<std::unique_ptr<ASTNode>> left = parse_additive_expression();
-	if (!left.has_value()) {
-		return Err<std::unique_ptr<ASTNode>>(left.error());
-	}
-
-	while (peek().type == Token::KeywordTo) {
-		Result<Token> op_error = advance();
-		if (!op_error.has_value()) {
-			return Err<std::unique_ptr<ASTNode>>(op_error.error());
-		}
-		Token op = op_error.value();
-
-		bool isInclusive = peek().type == Token::Assign;
-		if (isInclusive) {
-			Result<Token> assign = advance();
-			if (!assign.has_value()) {
-				return Err<std::unique_ptr<ASTNode>>(assign.error());
-			}
-		}
-
-		Token::Position pos = peek().position;
-		Result<std::unique_ptr<ASTNode>> right = parse_additive_expression();
-		if (!right.has_value()) {
-			return Err<std::unique_ptr<ASTNode>>(right.error());
-		}
-		Token::Position left_pos = left.value()->position;
-		left = Ok(std::make_unique<ToExpressionNode>(
-		    left_pos, dynamic_unique_cast<ExpressionNode>(std::move(left.value())),
-		    dynamic_unique_cast<ExpressionNode>(std::move(right.value())), isInclusive));
-	}
-	return left;
-}
-
-Result<std::unique_ptr<ASTNode>> Parser::parse_deref_expression() {
-	if (peek().type != Token::Multiply)
-		return parse_range_expression();
-
-	Result<Token> derefToken = advance();
-	if (!derefToken.has_value()) {
-		return Err<std::unique_ptr<ASTNode>>(derefToken.error());
-	}
-
-	Token::Position pos = peek().position;
-	Result<std::unique_ptr<ASTNode>> operand = parse_range_expression();
-	if (!operand.has_value()) {
-		return Err<std::unique_ptr<ASTNode>>(operand.error());
-	}
-
-	return Ok(std::make_unique<UnaryExpressionNode>(derefToken.value().position, derefToken.value(),
-	                                                dynamic_unique_cast<ExpressionNode>(std::move(operand.value()))));
-}
-
-Result<std::unique_ptr<ASTNode>> Parser::parse_ownership_expression() {
-	if (peek().type != Token::Ownership)
-		return parse_reference_expression();
-
-	Result<Token> ownershipToken = advance();
-	if (!ownershipToken.has_value()) {
-		return Err<std::unique_ptr<ASTNode>>(ownershipToken.error());
-	}
-
-	Token::Position pos = peek().position;
-	Result<std::unique_ptr<ASTNode>> operand = parse_reference_expression();
-	if (!operand.has_value()) {
-		return Err<std::unique_ptr<ASTNode>>(operand.error());
-	}
-
-	return Ok(std::make_unique<UnaryExpressionNode>(ownershipToken.value().position, ownershipToken.value(),
-	                                                dynamic_unique_cast<ExpressionNode>(std::move(operand.value()))));
-}
-
-Result<std::unique_ptr<ASTNode>> Parser::parse_reference_expression() {
-	// Check for && (move reference) first, then & (immutable reference)
-	if (peek().type == Token::LogicalAnd) {
-		Result<Token> moveRefToken = advance();
-		if (!moveRefToken.has_value()) {
-			return Err<std::unique_ptr<ASTNode>>(moveRefToken.error());
-		}
-
-		Token::Position pos = peek().position;
-		Result<std::unique_ptr<ASTNode>> operand = parse_deref_expression();
-		if (!operand.has_value()) {
-			return Err<std::unique_ptr<ASTNode>>(operand.error());
-		}
-
-		return Ok(
-		    std::make_unique<UnaryExpressionNode>(moveRefToken.value().position, moveRefToken.value(),
-		                                          dynamic_unique_cast<ExpressionNode>(std::move(operand.value()))));
-	} else if (peek().type == Token::MapRange) {
-		Result<Token> refToken = advance();
-		if (!refToken.has_value()) {
-			return Err<std::unique_ptr<ASTNode>>(refToken.error());
-		}
-
-		Token::Position pos = peek().position;
-		Result<std::unique_ptr<ASTNode>> operand = parse_deref_expression();
-		if (!operand.has_value()) {
-			return Err<std::unique_ptr<ASTNode>>(operand.error());
-		}
-
-		return Ok(
-		    std::make_unique<UnaryExpressionNode>(refToken.value().position, refToken.value(),
-		                                          dynamic_unique_cast<ExpressionNode>(std::move(operand.value()))));
-	}
-
-	return parse_deref_expression();
-}
-
-Result<std::unique_ptr<ASTNode>> Parser::parse_increment_expression() {
-	Result<std::unique_ptr<ASTNode>> left = parse_post_increment_expression();
-	if (!left.has_value()) {
-		return Err<std::unique_ptr<ASTNode>>(left.error());
-	}
-
-	while (peek().type == Token::Increment || peek().type == Token::Decrement) {
-		Result<Token> op_error = advance();
-		if (!op_error.has_value()) {
-			return Err<std::unique_ptr<ASTNode>>(op_error.error());
-		}
-		Token op = op_error.value();
-		Token::Position left_pos = left.value()->position;
-		left = Ok(std::make_unique<UnaryPostExpressionNode>(left_pos, op,
-		                                                dynamic_unique_cast<ExpressionNode>(std::move(left.value()))));
-	}
-	return left;
-}
-
-Result<std::unique_ptr<ASTNode>> Parser::parse_post_increment_expression() {
-	if(peek().type != Token::Increment && peek().type != Token::Decrement){
-		return parse_ownership_expression();
-	}
-
-	Result<std::unique_ptr<ASTNode>> left;
-	while(peek().type == Token::Increment || peek().type == Token::Decrement) {
-		Result<Token> op_error = advance();
-		if (!op_error.has_value()) {
-			return Err<std::unique_ptr<ASTNode>>(op_error.error());
-		}
-		Token op = op_error.value();
-
-		left = parse_ownership_expression();
-		Token::Position left_pos = left.value()->position;
-		left = Ok(std::make_unique<UnaryExpressionNode>(left_pos, op,
-		                                                dynamic_unique_cast<ExpressionNode>(std::move(left.value()))));
-
-	}
-	
-	return left;
-}
-
-Result<std::unique_ptr<ASTNode>> Parser::parse_unary_minus_expression() {
-	if (peek().type != Token::Minus)
-		return parse_increment_expression();
-
-	Result<Token> minusToken = advance();
-	if (!minusToken.has_value()) {
-		return Err<std::unique_ptr<ASTNode>>(minusToken.error());
-	}
-
-	if (peek().type == Token::Plus) {
-		// Decrement
-	}
-
-	Token::Position pos = peek().position;
-	Result<std::unique_ptr<ASTNode>> operand = parse_increment_expression();
-	if (!operand.has_value()) {
-		return Err<std::unique_ptr<ASTNode>>(operand.error());
-	}
-
-	return Ok(std::make_unique<UnaryExpressionNode>(minusToken.value().position, minusToken.value(),
-	                                                dynamic_unique_cast<ExpressionNode>(std::move(operand.value()))));
-}
-
-Result<std::unique_ptr<ASTNode>> Parser::parse_await_expression() {
-	if (peek().type != Token::KeywordAwait)
-		return parse_iterator_expression();
-
-	Result<Token> awaitToken = advance();
-	if (!awaitToken.has_value()) {
-		return Err<std::unique_ptr<ASTNode>>(awaitToken.error());
-	}
-
-	Token::Position pos = peek().position;
-	Result<std::unique_ptr<ASTNode>> operand = parse_iterator_expression();
-	if (!operand.has_value()) {
-		return Err<std::unique_ptr<ASTNode>>(operand.error());
-	}
-
-	return Ok(std::make_unique<UnaryExpressionNode>(awaitToken.value().position, awaitToken.value(),
-	                                                dynamic_unique_cast<ExpressionNode>(std::move(operand.value()))));
-}
-
-Result<std::unique_ptr<ASTNode>> Parser::parse_iterator_expression() {
-	if (peek().type != Token::Dollar)
-		return parse_unary_plus_expression();
-
-	Result<Token> dollarToken = advance();
-	if (!dollarToken.has_value()) {
-		return Err<std::unique_ptr<ASTNode>>(dollarToken.error());
-	}
-
-	Token::Position pos = peek().position;
-	Result<std::unique_ptr<ASTNode>> operand = parse_unary_plus_expression();
-	if (!operand.has_value()) {
-		return Err<std::unique_ptr<ASTNode>>(operand.error());
-	}
-
-	return Ok(std::make_unique<UnaryExpressionNode>(dollarToken.value().position, dollarToken.value(),
-	                                                dynamic_unique_cast<ExpressionNode>(std::move(operand.value()))));
-}
-
-Result<std::unique_ptr<ASTNode>> Parser::parse_unary_plus_expression() {
-	if (peek().type != Token::Plus)
-		return parse_unary_minus_expression();
-
-	Result<Token> plusToken = advance();
-	if (!plusToken.has_value()) {
-		return Err<std::unique_ptr<ASTNode>>(plusToken.error());
-	}
-
-	if (peek().type == Token::Plus) {
-		// Increment
-	}
-
-	Token::Position pos = peek().position;
-	Result<std::unique_ptr<ASTNode>> operand = parse_unary_minus_expression();
-	if (!operand.has_value()) {
-		return Err<std::unique_ptr<ASTNode>>(operand.error());
-	}
-
-	return Ok(std::make_unique<UnaryExpressionNode>(plusToken.value().position, plusToken.value(),
-	                                                dynamic_unique_cast<ExpressionNode>(std::move(operand.value()))));
-}
-
-Result<std::unique_ptr<ASTNode>> Parser::parse_logical_not_expression() {
-	// Check for prefix logical not operator
-	if (peek().type == Token::LogicalNot) {
-		Result<Token> op_error = advance();
-		if (!op_error.has_value()) {
-			return Err<std::unique_ptr<ASTNode>>(op_error.error());
-		}
-		Token op = op_error.value();
-
-		// Parse the operand
-		Result<std::unique_ptr<ASTNode>> operand = parse_await_expression();
-		if (!operand.has_value()) {
-			return Err<std::unique_ptr<ASTNode>>(operand.error());
-		}
-
-		return Ok(std::make_unique<UnaryExpressionNode>(
-		    op.position, op, dynamic_unique_cast<ExpressionNode>(std::move(operand.value()))));
+		    left_pos, unique_node_cast<ExpressionNode>(std::move(left.value())), std::move(arguments)));
 	}
 
-	// No logical not operator, continue with next level
-	return parse_await_expression();
-}
-
-Result<std::unique_ptr<ASTNode>> Parser::parse_bitwise_not_expression() {
-	if (peek().type != Token::BitwiseNot) return parse_logical_not_expression();
-	Result<std::unique_ptr<ASTNode>> left;
-
-	while (peek().type == Token::BitwiseNot) {
-		Result<Token> op_error = advance();
-		left = parse_logical_not_expression();
-		if (!left.has_value()) {
-			return Err<std::unique_ptr<ASTNode>>(left.error());
-		}
-
-		if (!op_error.has_value()) {
-			return Err<std::unique_ptr<ASTNode>>(op_error.error());
-		}
-		Token op = op_error.value();
-		Token::Position left_pos = left.value()->position;
-		left = Ok(std::make_unique<UnaryExpressionNode>(left_pos, op,
-		                                                dynamic_unique_cast<ExpressionNode>(std::move(left.value()))));
-	}
 	return left;
 }
 
 Result<std::unique_ptr<ASTNode>> Parser::parse_parallel_expression() {
-	if (peek().type != Token::KeywordPar)
+	if (peek_type() != Token::KeywordPar)
 		return parse_filter_expression();
 
-	Result<Token> token = advance();
+	Result<const Token*> token = advance();
 	if (!token.has_value()) {
 		return Err<std::unique_ptr<ASTNode>>(token.error());
 	}
@@ -1089,61 +718,67 @@ Result<std::unique_ptr<ASTNode>> Parser::parse_parallel_expression() {
 	Token::Position pos = peek().position;
 
 	// Check if this is a par with configuration: par(struct { ... }) expression
-	if (peek().type == Token::LeftParen) {
+	if (peek_type() == Token::LeftParen) {
 		// For now, skip the configuration parsing and just parse the expression after it
 		// TODO: Implement configuration parsing
 		Result<std::unique_ptr<ASTNode>> expr = parse_filter_expression();
 		if (!expr.has_value()) {
 			return Err<std::unique_ptr<ASTNode>>(expr.error());
 		}
-		return Ok(std::make_unique<ParallelExpressionNode>(token.value().position, std::move(expr.value())));
+		return Ok(std::make_unique<ParallelExpressionNode>(token.value()->position, std::move(expr.value())));
 	}
 	// Parse as expression, not statement - use a lower level to avoid recursion
 	Result<std::unique_ptr<ASTNode>> expr = parse_filter_expression();
 	if (!expr.has_value()) {
 		return Err<std::unique_ptr<ASTNode>>(expr.error());
 	}
-	return Ok(std::make_unique<ParallelExpressionNode>(token.value().position, std::move(expr.value())));
+	return Ok(std::make_unique<ParallelExpressionNode>(token.value()->position, std::move(expr.value())));
 }
 
 Result<std::unique_ptr<ASTNode>> Parser::parse_struct_expression() {
-	if (peek().type != Token::KeywordStruct)
+	if (peek_type() != Token::KeywordStruct)
 		return parse_index_expression();
 
-	Result<Token> token = advance();
+	Result<const Token*> token = advance();
 	if (!token.has_value()) {
 		return Err<std::unique_ptr<ASTNode>>(token.error());
 	}
 	std::string type = "";
 
-	if (peek().type == Token::Identifier) {
+	if (peek_type() == Token::Identifier) {
 		Result<std::unique_ptr<ASTNode>> type_expr = parse_primary();
 		if (!type_expr.has_value()) {
 			return Err<std::unique_ptr<ASTNode>>(type_expr.error());
 		}
-		type = dynamic_cast<const IdentifierNode&>(*type_expr.value()).identifier;
+		// An identifier can also start a lambda here, as in struct x -> y
+		const auto* identifier = node_cast<IdentifierNode>(type_expr.value().get());
+		if (identifier == nullptr) {
+			return Err<std::unique_ptr<ASTNode>>(create_parse_error(
+			    ErrorType::InvalidStructLiteral, "Expected a type name after struct", type_expr.value()->position));
+		}
+		type = identifier->identifier;
 	}
 
-	Result<Token> leftBrace = expect(Token::LeftBrace, "Expected '{' after struct");
+	Result<const Token*> leftBrace = expect(Token::LeftBrace, "Expected '{' after struct");
 	if (!leftBrace.has_value()) {
 		return Err<std::unique_ptr<ASTNode>>(leftBrace.error());
 	}
 
 	std::vector<StructField> fields;
-	while (peek().type != Token::RightBrace) {
+	while (peek_type() != Token::RightBrace) {
 		Token::Position namePos = peek().position;
-		Result<Token> nameError = expect(Token::Identifier, "Expected fields base");
+		Result<const Token*> nameError = expect(Token::Identifier, "Expected fields base");
 		if (!nameError.has_value()) {
 			return Err<std::unique_ptr<ASTNode>>(nameError.error());
 		}
-		Token name = nameError.value();
+		const Token& name = *nameError.value();
 
 		Result<std::unique_ptr<TypeNode>> type;
 		Result<std::unique_ptr<ASTNode>> expression;
 
-		if (peek().type == Token::Colon) {
+		if (peek_type() == Token::Colon) {
 			Token::Position colonPos = peek().position;
-			Result<Token> token1 = advance();
+			Result<const Token*> token1 = advance();
 			if (!token1.has_value()) {
 				return Err<std::unique_ptr<ASTNode>>(token1.error());
 			}
@@ -1155,9 +790,9 @@ Result<std::unique_ptr<ASTNode>> Parser::parse_struct_expression() {
 			}
 		}
 
-		if (peek().type == Token::Assign) {
+		if (peek_type() == Token::Assign) {
 			Token::Position assignPos = peek().position;
-			Result<Token> token1 = advance();
+			Result<const Token*> token1 = advance();
 			if (!token1.has_value()) {
 				return Err<std::unique_ptr<ASTNode>>(token1.error());
 			}
@@ -1174,9 +809,9 @@ Result<std::unique_ptr<ASTNode>> Parser::parse_struct_expression() {
 			    ErrorType::UnexpectedToken, "Cannot have field without value or type", peek().position));
 		}
 
-		if (peek().type != Token::RightBrace) {
+		if (peek_type() != Token::RightBrace) {
 			Token::Position commaPos = peek().position;
-			Result<Token> comma = expect(Token::Comma, "Expected ',' between fields");
+			Result<const Token*> comma = expect(Token::Comma, "Expected ',' between fields");
 			if (!comma.has_value()) {
 				return Err<std::unique_ptr<ASTNode>>(comma.error());
 			}
@@ -1184,37 +819,24 @@ Result<std::unique_ptr<ASTNode>> Parser::parse_struct_expression() {
 
 		std::unique_ptr<TypeNode> typeValue = type.value() ? std::move(type.value()) : nullptr;
 		std::unique_ptr<ExpressionNode> expressionValue =
-		    expression.value() ? dynamic_unique_cast<ExpressionNode>(std::move(expression.value())) : nullptr;
+		    expression.value() ? unique_node_cast<ExpressionNode>(std::move(expression.value())) : nullptr;
 
-		fields.emplace_back(name.position, name.value, std::move(typeValue), std::move(expressionValue));
+		fields.emplace_back(name.position, std::string(name.value), std::move(typeValue), std::move(expressionValue));
 	}
 
 	advance();
 
-	return Ok(std::make_unique<StructExpressionNode>(leftBrace.value().position, std::move(fields), std::move(type)));
+	return Ok(std::make_unique<StructExpressionNode>(leftBrace.value()->position, std::move(fields), std::move(type)));
 }
 
-Result<std::unique_ptr<ASTNode>> Parser::parse_match_expression() {
-	Token::Position pos = peek().position;
-	Result<std::unique_ptr<ASTNode>> value = parse_pipe_expression();
-	if (!value.has_value()) {
-		return Err<std::unique_ptr<ASTNode>>(value.error());
-	}
-	if (peek().type != Token::MatchArrow)
-		return value;
-
-	Result<Token> token = advance();
-	if (!token.has_value()) {
-		return Err<std::unique_ptr<ASTNode>>(token.error());
-	}
-
-	Result<Token> leftBrace = expect(Token::LeftBrace, "Expected '{' after match expression");
+Result<std::unique_ptr<ASTNode>> Parser::parse_match_branches(Token::Position pos, std::unique_ptr<ASTNode> value) {
+	Result<const Token*> leftBrace = expect(Token::LeftBrace, "Expected '{' after match expression");
 	if (!leftBrace.has_value()) {
 		return Err<std::unique_ptr<ASTNode>>(leftBrace.error());
 	}
 
 	std::vector<std::unique_ptr<MatchBranch>> branches;
-	while (peek().type != Token::RightBrace) {
+	while (peek_type() != Token::RightBrace) {
 		Token::Position patternPos = peek().position;
 		Result<std::unique_ptr<PatternNode>> parsedPattern = parse_pattern();
 		if (!parsedPattern.has_value()) {
@@ -1223,19 +845,19 @@ Result<std::unique_ptr<ASTNode>> Parser::parse_match_expression() {
 
 		// Parse optional guard condition (&&)
 		std::unique_ptr<ExpressionNode> condition = nullptr;
-		if (peek().type == Token::LogicalAnd) {
+		if (peek_type() == Token::LogicalAnd) {
 			this->is_match = true;
 			advance(); // consume &&
 			Result<std::unique_ptr<ASTNode>> guardExpr = parse_expression();
 			if (!guardExpr.has_value()) {
 				return Err<std::unique_ptr<ASTNode>>(guardExpr.error());
 			}
-			condition = dynamic_unique_cast<ExpressionNode>(std::move(guardExpr.value()));
+			condition = unique_node_cast<ExpressionNode>(std::move(guardExpr.value()));
 
 			this->is_match = false;
 		}
 
-		Result<Token> arrow = expect(Token::Arrow, "Expected '->' after pattern");
+		Result<const Token*> arrow = expect(Token::Arrow, "Expected '->' after pattern");
 		if (!arrow.has_value()) {
 			return Err<std::unique_ptr<ASTNode>>(arrow.error());
 		}
@@ -1248,79 +870,38 @@ Result<std::unique_ptr<ASTNode>> Parser::parse_match_expression() {
 
 		branches.push_back(std::make_unique<MatchBranch>(patternPos, std::move(parsedPattern.value()),
 		                                                 std::move(condition),
-		                                                 dynamic_unique_cast<ExpressionNode>(std::move(body.value()))));
+		                                                 unique_node_cast<ExpressionNode>(std::move(body.value()))));
 
-		if (peek().type == Token::RightBrace)
+		if (peek_type() == Token::RightBrace)
 			break;
 
-		Result<Token> comma = expect(Token::Comma, "Expected ',' or '}'");
+		Result<const Token*> comma = expect(Token::Comma, "Expected ',' or '}'");
 		if (!comma.has_value()) {
 			return Err<std::unique_ptr<ASTNode>>(comma.error());
 		}
 	}
 
-	Result<Token> rightBrace = expect(Token::RightBrace, "Expected '}' after match statement");
+	Result<const Token*> rightBrace = expect(Token::RightBrace, "Expected '}' after match statement");
 	if (!rightBrace.has_value()) {
 		return Err<std::unique_ptr<ASTNode>>(rightBrace.error());
 	}
 
-	return Ok(std::make_unique<MatchExpressionNode>(pos, dynamic_unique_cast<ExpressionNode>(std::move(value.value())),
+	return Ok(std::make_unique<MatchExpressionNode>(pos, unique_node_cast<ExpressionNode>(std::move(value)),
 	                                                std::move(branches)));
 }
 
 bool Parser::is_lambda_expression() {
-	if (peek().type != Token::LeftParen)
-		return false;
-
-	size_t startIndex = current;
-
-	Result<Token> leftParen = advance();
-	if (!leftParen.has_value()) {
-		current = startIndex;
-		return false;
-	}
-
-	while (peek().type != Token::RightParen) {
-		Result<Token> token = advance();
-		if (!token.has_value()) {
-			current = startIndex;
-			return false;
-		}
-	}
-
-	Result<Token> rightParen = advance();
-	if (!rightParen.has_value()) {
-		current = startIndex;
+	if (peek_type() != Token::LeftParen)
 		return false;
-	}
-
-	if (peek().type != Token::Arrow) {
-		current = startIndex;
-		return false;
-	}
 
-	current = startIndex;
-	return true;
+	// The token stream pairs parentheses as it tokenizes, so this looks at no token twice however deeply the
+	// parenthesised expressions nest
+	size_t closing = tokens.matching_paren(current);
+	return tokens.at(closing).type == Token::RightParen && tokens.at(closing + 1).type == Token::Arrow;
 }
 
 bool Parser::is_single_parameter_lambda() {
-	if (peek().type != Token::Identifier)
-		return false;
-
-	size_t startIndex = current;
-
-	// Skip the identifier
-	Result<Token> identifier = advance();
-	if (!identifier.has_value()) {
-		current = startIndex;
-		return false;
-	}
-
-	// Check if next token is arrow
-	bool isLambda = peek().type == Token::Arrow;
-
-	current = startIndex;
-	return isLambda;
+	return peek_type() == Token::Identifier && peek_type(1) == Token::Arrow;
 }
 
 Result<std::unique_ptr<ASTNode>> Parser::parse_lambda_expression() {
@@ -1330,15 +911,15 @@ Result<std::unique_ptr<ASTNode>> Parser::parse_lambda_expression() {
 	std::vector<std::unique_ptr<FunctionArgument>> args;
 	Token::Position start_pos = peek().position;
 
-	if (peek().type == Token::LeftParen) {
+	if (peek_type() == Token::LeftParen) {
 		// Handle (x) -> ... or (x, y) -> ... syntax
-		Result<Token> leftParen = advance();
+		Result<const Token*> leftParen = advance();
 		if (!leftParen.has_value()) {
 			return Err<std::unique_ptr<ASTNode>>(leftParen.error());
 		}
-		start_pos = leftParen.value().position;
+		start_pos = leftParen.value()->position;
 
-		while (peek().type != Token::RightParen) {
+		while (peek_type() != Token::RightParen) {
 			Token::Position argPos = peek().position;
 			Result<std::unique_ptr<FunctionArgument>> arg = parse_function_argument();
 			if (!arg.has_value()) {
@@ -1347,30 +928,31 @@ Result<std::unique_ptr<ASTNode>> Parser::parse_lambda_expression() {
 
 			args.push_back(std::move(arg.value()));
 
-			if (peek().type == Token::RightParen)
+			if (peek_type() == Token::RightParen)
 				break;
 
-			Result<Token> comma = expect(Token::Comma, "Expected ',' between arguments");
+			Result<const Token*> comma = expect(Token::Comma, "Expected ',' between arguments");
 			if (!comma.has_value())
 				return Err<std::unique_ptr<ASTNode>>(comma.error());
 		}
 
-		Result<Token> rightParen = expect(Token::RightParen, "Expected ')'");
+		Result<const Token*> rightParen = expect(Token::RightParen, "Expected ')'");
 		if (!rightParen.has_value())
 			return Err<std::unique_ptr<ASTNode>>(rightParen.error());
 	} else {
 		// Handle x -> ... syntax (single parameter without parentheses)
-		Result<Token> identifier = expect(Token::Identifier, "Expected parameter name");
+		Result<const Token*> identifier = expect(Token::Identifier, "Expected parameter name");
 		if (!identifier.has_value())
 			return Err<std::unique_ptr<ASTNode>>(identifier.error());
-		start_pos = identifier.value().position;
+		start_pos = identifier.value()->position;
 
 		auto arg =
-		    std::make_unique<FunctionArgument>(identifier.value().position, nullptr, nullptr, identifier.value().value);
+		    std::make_unique<FunctionArgument>(identifier.value()->position, nullptr, nullptr,
+		                                       std::string(identifier.value()->value));
 		args.push_back(std::move(arg));
 	}
 
-	Result<Token> arrow = expect(Token::Arrow, "Expected '->'");
+	Result<const Token*> arrow = expect(Token::Arrow, "Expected '->'");
 	if (!arrow.has_value()) {
 		return Err<std::unique_ptr<ASTNode>>(arrow.error());
 	}
@@ -1389,21 +971,21 @@ Result<std::unique_ptr<ASTNode>> Parser::parse_lambda_expression() {
 	return Ok(std::make_unique<LambdaExpressionNode>(
 	    start_pos, std::move(args),
 	    std::make_unique<ReturnStatementNode>(bodyPosition,
-	                                          dynamic_unique_cast<ExpressionNode>(std::move(body.value())), false)));
+	                                          unique_node_cast<ExpressionNode>(std::move(body.value())), false)));
 }
 
 // Pattern parsing implementations
 Result<std::unique_ptr<PatternNode>> Parser::parse_pattern() {
 	Token::Position pos = peek().position;
 
-	switch (peek().type) {
+	switch (peek_type()) {
 	case Token::Identifier:
 		// Could be identifier pattern, constructor pattern, or type pattern
-		if (peek(1).type == Token::LeftParen) {
+		if (peek_type(1) == Token::LeftParen) {
 			// Constructor pattern: Point(x, y)
 			return parse_constructor_pattern();
 			}
-			if (peek(1).type == Token::DoubleColon) {
+			if (peek_type(1) == Token::DoubleColon) {
 			// Enum constructor: Shape::Circle(r)
 			return parse_constructor_pattern();
 			}
@@ -1434,17 +1016,17 @@ Result<std::unique_ptr<PatternNode>> Parser::parse_pattern() {
 }
 
 Result<std::unique_ptr<PatternNode>> Parser::parse_wildcard_pattern() {
-	Result<Token> underscore = expect(Token::Identifier, "Expected '_'");
+	Result<const Token*> underscore = expect(Token::Identifier, "Expected '_'");
 	if (!underscore.has_value()) {
 		return Err<std::unique_ptr<PatternNode>>(underscore.error());
 	}
 
-	if (underscore.value().value != "_") {
+	if (underscore.value()->value != "_") {
 		return Err<std::unique_ptr<PatternNode>>(create_parse_error(
-		    ErrorType::UnexpectedToken, "Expected '_' for wildcard pattern", underscore.value().position));
+		    ErrorType::UnexpectedToken, "Expected '_' for wildcard pattern", underscore.value()->position));
 	}
 
-	return Ok(std::make_unique<WildcardPatternNode>(underscore.value().position));
+	return Ok(std::make_unique<WildcardPatternNode>(underscore.value()->position));
 }
 
 Result<std::unique_ptr<PatternNode>> Parser::parse_literal_pattern() {
@@ -1453,29 +1035,31 @@ Result<std::unique_ptr<PatternNode>> Parser::parse_literal_pattern() {
 		return Err<std::unique_ptr<PatternNode>>(literal.error());
 	}
 
-	// Check if this is a range pattern (literal to literal)
-	if (peek().type == Token::KeywordTo) {
-		current--; // Go back to re-parse as range
-		return parse_range_pattern();
+	// The expression parser already took "start to end" apart; it is a pattern of its own
+	Token::Position literalPos = literal.value()->position;
+	if (literal.value()->get_node_type() == ASTNodeType::ToExpression) {
+		auto range = unique_node_cast<ToExpressionNode>(std::move(literal.value()));
+		return Ok(std::make_unique<RangePatternNode>(literalPos, std::move(range->lowerBound),
+		                                             std::move(range->upperBound), range->isInclusive));
 	}
 
-	Token::Position literalPos = literal.value()->position;
 	return Ok(std::make_unique<LiteralPatternNode>(literalPos,
-	                                               dynamic_unique_cast<ExpressionNode>(std::move(literal.value()))));
+	                                               unique_node_cast<ExpressionNode>(std::move(literal.value()))));
 }
 
 Result<std::unique_ptr<PatternNode>> Parser::parse_identifier_pattern() {
-	Result<Token> identifier = expect(Token::Identifier, "Expected identifier");
+	Result<const Token*> identifier = expect(Token::Identifier, "Expected identifier");
 	if (!identifier.has_value()) {
 		return Err<std::unique_ptr<PatternNode>>(identifier.error());
 	}
 
-	return Ok(std::make_unique<IdentifierPatternNode>(identifier.value().position, identifier.value().value));
+	return Ok(std::make_unique<IdentifierPatternNode>(identifier.value()->position,
+	                                                  std::string(identifier.value()->value)));
 }
 
 Result<std::unique_ptr<PatternNode>> Parser::parse_array_pattern() {
 	Token::Position pos = peek().position;
-	Result<Token> left_bracket = expect(Token::LeftBracket, "Expected '['");
+	Result<const Token*> left_bracket = expect(Token::LeftBracket, "Expected '['");
 	if (!left_bracket.has_value()) {
 		return Err<std::unique_ptr<PatternNode>>(left_bracket.error());
 	}
@@ -1483,16 +1067,20 @@ Result<std::unique_ptr<PatternNode>> Parser::parse_array_pattern() {
 	std::vector<std::unique_ptr<PatternNode>> elements;
 	std::unique_ptr<PatternNode> rest = nullptr;
 
-	while (peek().type != Token::RightBracket) {
-		if (peek().type == Token::Ellipsis) {
+	while (peek_type() != Token::RightBracket) {
+		if (peek_type() == Token::Ellipsis) {
 			// Rest pattern: ...rest
+			Token::Position restPos = peek().position;
 			advance(); // consume ...
-			if (peek().type == Token::Identifier) {
+			if (peek_type() == Token::Identifier) {
 				Result<std::unique_ptr<PatternNode>> restPattern = parse_pattern();
 				if (!restPattern.has_value()) {
 					return Err<std::unique_ptr<PatternNode>>(restPattern.error());
 				}
 				rest = std::move(restPattern.value());
+			} else {
+				// An unnamed rest still lets the array be longer than its elements
+				rest = std::make_unique<WildcardPatternNode>(restPos);
 			}
 			break;
 		}
@@ -1503,16 +1091,16 @@ Result<std::unique_ptr<PatternNode>> Parser::parse_array_pattern() {
 		}
 		elements.push_back(std::move(element.value()));
 
-		if (peek().type == Token::RightBracket)
+		if (peek_type() == Token::RightBracket)
 			break;
 
-		Result<Token> comma = expect(Token::Comma, "Expected ',' or ']'");
+		Result<const Token*> comma = expect(Token::Comma, "Expected ',' or ']'");
 		if (!comma.has_value()) {
 			return Err<std::unique_ptr<PatternNode>>(comma.error());
 		}
 	}
 
-	Result<Token> right_bracket = expect(Token::RightBracket, "Expected ']'");
+	Result<const Token*> right_bracket = expect(Token::RightBracket, "Expected ']'");
 	if (!right_bracket.has_value()) {
 		return Err<std::unique_ptr<PatternNode>>(right_bracket.error());
 	}
@@ -1522,21 +1110,21 @@ Result<std::unique_ptr<PatternNode>> Parser::parse_array_pattern() {
 
 Result<std::unique_ptr<PatternNode>> Parser::parse_struct_pattern() {
 	Token::Position pos = peek().position;
-	Result<Token> leftBrace = expect(Token::LeftBrace, "Expected '{'");
+	Result<const Token*> leftBrace = expect(Token::LeftBrace, "Expected '{'");
 	if (!leftBrace.has_value()) {
 		return Err<std::unique_ptr<PatternNode>>(leftBrace.error());
 	}
 
 	std::vector<std::pair<std::string, std::unique_ptr<PatternNode>>> fields;
 
-	while (peek().type != Token::RightBrace) {
-		Result<Token> fieldName = expect(Token::Identifier, "Expected field name");
+	while (peek_type() != Token::RightBrace) {
+		Result<const Token*> fieldName = expect(Token::Identifier, "Expected field name");
 		if (!fieldName.has_value()) {
 			return Err<std::unique_ptr<PatternNode>>(fieldName.error());
 		}
 
 		std::unique_ptr<PatternNode> pattern;
-		if (peek().type == Token::Assign) {
+		if (peek_type() == Token::Assign) {
 			advance(); // consume :
 			Result<std::unique_ptr<PatternNode>> fieldPattern = parse_pattern();
 			if (!fieldPattern.has_value()) {
@@ -1545,21 +1133,22 @@ Result<std::unique_ptr<PatternNode>> Parser::parse_struct_pattern() {
 			pattern = std::move(fieldPattern.value());
 		} else {
 			// Shorthand: {x} is equivalent to {x: x}
-			pattern = std::make_unique<IdentifierPatternNode>(fieldName.value().position, fieldName.value().value);
+			pattern = std::make_unique<IdentifierPatternNode>(fieldName.value()->position,
+		                                                  std::string(fieldName.value()->value));
 		}
 
-		fields.emplace_back(fieldName.value().value, std::move(pattern));
+		fields.emplace_back(fieldName.value()->value, std::move(pattern));
 
-		if (peek().type == Token::RightBrace)
+		if (peek_type() == Token::RightBrace)
 			break;
 
-		Result<Token> comma = expect(Token::Comma, "Expected ',' or '}'");
+		Result<const Token*> comma = expect(Token::Comma, "Expected ',' or '}'");
 		if (!comma.has_value()) {
 			return Err<std::unique_ptr<PatternNode>>(comma.error());
 		}
 	}
 
-	Result<Token> rightBrace = expect(Token::RightBrace, "Expected '}'");
+	Result<const Token*> rightBrace = expect(Token::RightBrace, "Expected '}'");
 	if (!rightBrace.has_value()) {
 		return Err<std::unique_ptr<PatternNode>>(rightBrace.error());
 	}
@@ -1569,45 +1158,45 @@ Result<std::unique_ptr<PatternNode>> Parser::parse_struct_pattern() {
 
 Result<std::unique_ptr<PatternNode>> Parser::parse_constructor_pattern() {
 	Token::Position pos = peek().position;
-	Result<Token> name = expect(Token::Identifier, "Expected constructor name");
+	Result<const Token*> name = expect(Token::Identifier, "Expected constructor name");
 	if (!name.has_value()) {
 		return Err<std::unique_ptr<PatternNode>>(name.error());
 	}
 
-	std::string constructorName = name.value().value;
+	std::string constructorName(name.value()->value);
 
 	// Handle enum constructors: Shape::Circle
-	while (peek().type == Token::DoubleColon) {
+	while (peek_type() == Token::DoubleColon) {
 		advance(); // consume ::
-		Result<Token> enumName = expect(Token::Identifier, "Expected enum variant name");
+		Result<const Token*> enumName = expect(Token::Identifier, "Expected enum variant name");
 		if (!enumName.has_value()) {
 			return Err<std::unique_ptr<PatternNode>>(enumName.error());
 		}
-		constructorName += "::" + enumName.value().value;
+		constructorName += "::" + std::string(enumName.value()->value);
 	}
 
 	std::vector<std::unique_ptr<PatternNode>> arguments;
 
-	if (peek().type == Token::LeftBrace) {
+	if (peek_type() == Token::LeftBrace) {
 		advance(); // consume (
 
-		while (peek().type != Token::RightBrace) {
+		while (peek_type() != Token::RightBrace) {
 			Result<std::unique_ptr<PatternNode>> arg = parse_pattern();
 			if (!arg.has_value()) {
 				return Err<std::unique_ptr<PatternNode>>(arg.error());
 			}
 			arguments.push_back(std::move(arg.value()));
 
-			if (peek().type == Token::RightBrace)
+			if (peek_type() == Token::RightBrace)
 				break;
 
-			Result<Token> comma = expect(Token::Comma, "Expected ',' or ')'");
+			Result<const Token*> comma = expect(Token::Comma, "Expected ',' or ')'");
 			if (!comma.has_value()) {
 				return Err<std::unique_ptr<PatternNode>>(comma.error());
 			}
 		}
 
-		Result<Token> right_brace = expect(Token::RightBrace, "Expected ')'");
+		Result<const Token*> right_brace = expect(Token::RightBrace, "Expected ')'");
 		if (!right_brace.has_value()) {
 			return Err<std::unique_ptr<PatternNode>>(right_brace.error());
 		}
@@ -1634,9 +1223,9 @@ Result<std::unique_ptr<PatternNode>> Parser::parse_range_pattern() {
 	}
 
 	bool isInclusive = false;
-	if (peek().type == Token::KeywordTo) {
+	if (peek_type() == Token::KeywordTo) {
 		advance(); // consume 'to'
-		if (peek().type == Token::Assign) {
+		if (peek_type() == Token::Assign) {
 			advance(); // consume '='
 			isInclusive = true;
 		}
@@ -1650,7 +1239,7 @@ Result<std::unique_ptr<PatternNode>> Parser::parse_range_pattern() {
 		return Err<std::unique_ptr<PatternNode>>(end.error());
 	}
 
-	return Ok(std::make_unique<RangePatternNode>(pos, dynamic_unique_cast<ExpressionNode>(std::move(start.value())),
-	                                             dynamic_unique_cast<ExpressionNode>(std::move(end.value())),
+	return Ok(std::make_unique<RangePatternNode>(pos, unique_node_cast<ExpressionNode>(std::move(start.value())),
+	                                             unique_node_cast<ExpressionNode>(std::move(end.value())),
 	                                             isInclusive));
 }
@@ -7,58 +7,90 @@
 
 using namespace ArgonLang;
 
-Token Parser::peek() const {
-	return tokens[current];
+const Token& Parser::peek() const {
+	return tokens.at(current);
 }
 
-Token Parser::peek(int offset) const {
-	size_t index = current + offset;
-	if (index >= tokens.size()) {
-		return tokens.back(); // Return end token if out of bounds
-	}
-	return tokens[index];
+const Token& Parser::peek(int offset) const {
+	return tokens.at(current + offset); // End token if out of bounds
+}
+
+Token::Type Parser::peek_type() const {
+	return tokens.at(current).type;
+}
+
+Token::Type Parser::peek_type(int offset) const {
+	return tokens.at(current + offset).type;
 }
 
 bool Parser::eos() const {
-	return current >= tokens.size() - 1;
+	return !tokens.has(current + 1);
 }
 
-[[nodiscard]] Result<Token> Parser::advance() {
-	if (current < tokens.size()) {
-		return Ok(tokens[current++]);
+[[nodiscard]] Result<const Token*> Parser::advance() {
+	if (tokens.has(current)) {
+		return &tokens.at(current++);
 	}
-	Token endToken = peek();
+	const Token& endToken = peek();
 	Error error = create_parse_error(ErrorType::UnexpectedToken, "Unexpected end of input", endToken.position);
 	error.withExpected("more tokens").withActual("end of input");
-	return Err<Token>(error);
+	return Err<const Token*>(error);
 }
 
-[[nodiscard]] Result<Token> Parser::expect(Token::Type type, const std::string& errorMessage) {
-	if (current >= tokens.size() || tokens[current].type != type) {
+[[nodiscard]] Result<const Token*> Parser::expect(Token::Type type, const std::string& errorMessage) {
+	if (!tokens.has(current) || tokens.at(current).type != type) {
 		// Don't modify parser state on error - create error with current position info
-		Token errorToken = (current < tokens.size()) ? tokens[current] : tokens.back();
+		const Token& errorToken = tokens.at(current);
 		Position pos("", errorToken.position.line, errorToken.position.column);
 
 		Error error = create_parse_error(ErrorType::MissingToken, errorMessage, errorToken.position);
 		error.withExpected(Token::getTypeAsString(type))
-		    .withActual(errorToken.value)
+		    .withActual(std::string(errorToken.value))
 		    .withSuggestion("Check syntax near line " + std::to_string(errorToken.position.line) + ", column " +
 		                    std::to_string(errorToken.position.column));
-		return Err<Token>(error);
+		return Err<const Token*>(error);
 	}
 	return advance();
 }
 
+void Parser::release_consumed_tokens() {
+	// Called between top-level declarations: nothing of an earlier declaration is referenced or looked at again
+	tokens.release_before(current);
+}
+
+uint64_t Parser::hash_tokens(size_t begin, size_t end) const {
+	// 64-bit FNV-1a; the type and length of each token keep differently split spellings apart
+	uint64_t hash = 0xcbf29ce484222325ull;
+	auto mix = [&hash](uint64_t value) {
+		hash ^= value;
+		hash *= 0x100000001b3ull;
+	};
+	for (size_t index = begin; index < end; ++index) {
+		const Token& token = tokens.at(index);
+		mix(token.type);
+		mix(token.value.size());
+		for (char character : token.value) {
+			mix(static_cast<unsigned char>(character));
+		}
+	}
+	return hash;
+}
+
 int Parser::get_main_counter() const {
 	return main_counter;
 }
 
 Result<std::unique_ptr<ProgramNode>> Parser::parse() {
-	std::vector<std::unique_ptr<ASTNode>> statements;
+	// The program node stays on the heap, since it ends up owning the arena; declared after it so that the nodes
+	// of a failed parse are destroyed before their memory
+	auto arena = std::make_unique<ASTArena>();
+	auto program = std::make_unique<ProgramNode>(Token::Position(0, 0), std::vector<std::unique_ptr<ASTNode>>());
+	ASTArena::Scope scope(arena.get());
 	while (!eos()) {
 		Result<std::unique_ptr<ASTNode>> statement;
 		size_t start = current;
-		switch (peek().type) {
+		release_consumed_tokens();
+		switch (peek_type()) {
 		case Token::KeywordDef:
 			statement = parse_variable_declaration();
 			break;
@@ -87,11 +119,11 @@ Result<std::unique_ptr<ProgramNode>> Parser::parse() {
 			statement = parse_class_declaration();
 			break;
 		default:
-			Token currentToken = peek();
+			const Token& currentToken = peek();
 			Error error = create_parse_error(ErrorType::UnexpectedToken, "Invalid declaration at top level",
 			                                 currentToken.position);
 			error.withExpected("function, variable, module, import, type alias, enum, or class declaration")
-			    .withActual(currentToken.value)
+			    .withActual(std::string(currentToken.value))
 			    .with_note("Only declarations are allowed at the top level");
 			return Err<std::unique_ptr<ProgramNode>>(error);
 		}
@@ -102,14 +134,16 @@ Result<std::unique_ptr<ProgramNode>> Parser::parse() {
 			return Err<std::unique_ptr<ProgramNode>>(statement.error());
 		}
 
-		statements.push_back(std::move(statement.value()));
+		program->nodes.push_back(std::move(statement.value()));
+		program->declaration_hashes.push_back(hash_tokens(start, current));
 	}
-	return std::make_unique<ProgramNode>(Token::Position(0, 0), std::move(statements));
+	program->arena = std::move(arena);
+	return program;
 }
 
 void Parser::synchronize() {
 	while (!eos()) {
-		Token currentType = peek();
+		const Token& currentType = peek();
 
 		if (currentType.type == Token::Semicolon || currentType.type == Token::RightBrace) {
 			// Consume the synchronization token and return
@@ -7,14 +7,14 @@ ArgonLang::Result<std::unique_ptr<ArgonLang::TypeNode>> ArgonLang::Parser::parse
 }
 
 ArgonLang::Result<std::unique_ptr<ArgonLang::TypeNode>> ArgonLang::Parser::parse_identifier_type() {
-	Result<Token> left = advance();
+	Result<const Token*> left = advance();
 	if (!left.has_value()) {
 		return Err<std::unique_ptr<TypeNode>>(left.error());
 	}
 
-	if (left.value().type == Token::LeftParen) {
+	if (left.value()->type == Token::LeftParen) {
 		Result<std::unique_ptr<TypeNode>> type = parse_type();
-		Result<Token> token_error1 = expect(Token::RightParen, "Expected closing ')'");
+		Result<const Token*> token_error1 = expect(Token::RightParen, "Expected closing ')'");
 		if (!token_error1.has_value()) {
 			return Err<std::unique_ptr<TypeNode>>(token_error1.error());
 		}
@@ -22,31 +22,31 @@ ArgonLang::Result<std::unique_ptr<ArgonLang::TypeNode>> ArgonLang::Parser::parse
 	}
 
 	// Handle function types: func(i32, i32) i32 or func i32
-	if (left.value().type == Token::KeywordFunc) {
-		return parse_function_type(left.value().position);
+	if (left.value()->type == Token::KeywordFunc) {
+		return parse_function_type(left.value()->position);
 	}
 
 	// Handle variadic types: ...i32
-	if (left.value().type == Token::Ellipsis) {
-		return parse_variadic_type(left.value().position);
+	if (left.value()->type == Token::Ellipsis) {
+		return parse_variadic_type(left.value()->position);
 	}
 
-	if (left.value().type != Token::Identifier && left.value().type != Token::PrimitiveType) {
+	if (left.value()->type != Token::Identifier && left.value()->type != Token::PrimitiveType) {
 		return Err<std::unique_ptr<TypeNode>>(
-		    create_parse_error(ErrorType::UnexpectedToken, "Expected type", left.value().position));
+		    create_parse_error(ErrorType::UnexpectedToken, "Expected type", left.value()->position));
 	}
 
-	if (peek().type == Token::Identifier || peek().type == Token::PrimitiveType) {
+	if (peek_type() == Token::Identifier || peek_type() == Token::PrimitiveType) {
 		return Err<std::unique_ptr<TypeNode>>(
-		    create_parse_error(ErrorType::UnexpectedToken, "Expected '&' or '|' between types", left.value().position));
+		    create_parse_error(ErrorType::UnexpectedToken, "Expected '&' or '|' between types", left.value()->position));
 	}
 
-	return Ok(std::make_unique<IdentifierTypeNode>(left.value().position, left.value().value));
+	return Ok(std::make_unique<IdentifierTypeNode>(left.value()->position, left.value()->value));
 }
 
 ArgonLang::Result<std::unique_ptr<ArgonLang::TypeNode>> ArgonLang::Parser::parse_prefixed_type() {
 	PrefixedTypeNode::Prefix prefix;
-	switch (peek().type) {
+	switch (peek_type()) {
 	case Token::Multiply:
 		prefix = PrefixedTypeNode::Prefix::Pointer;
 		break;
@@ -63,7 +63,7 @@ ArgonLang::Result<std::unique_ptr<ArgonLang::TypeNode>> ArgonLang::Parser::parse
 		return parse_identifier_type();
 	}
 
-	Result<Token> pref = advance();
+	Result<const Token*> pref = advance();
 	if (!pref.has_value()) {
 		return Err<std::unique_ptr<TypeNode>>(pref.error());
 	}
@@ -84,15 +84,15 @@ ArgonLang::Result<std::unique_ptr<ArgonLang::TypeNode>> ArgonLang::Parser::parse
 	}
 
 	// Check for array type: i32[10]
-	if (peek().type == Token::LeftBracket) {
+	if (peek_type() == Token::LeftBracket) {
 		Token::Position pos = peek().position;
-		Result<Token> left_bracket = advance();
+		Result<const Token*> left_bracket = advance();
 		if (!left_bracket.has_value()) {
 			return Err<std::unique_ptr<TypeNode>>(left_bracket.error());
 		}
 
 		std::unique_ptr<ExpressionNode> size = nullptr;
-		if (peek().type != Token::RightBracket) {
+		if (peek_type() != Token::RightBracket) {
 			// Parse array size expression
 			auto size_result = parse_expression();
 			if (!size_result.has_value()) {
@@ -102,7 +102,7 @@ ArgonLang::Result<std::unique_ptr<ArgonLang::TypeNode>> ArgonLang::Parser::parse
 			size = std::unique_ptr<ExpressionNode>(static_cast<ExpressionNode*>(size_result.value().release()));
 		}
 
-		Result<Token> right_bracket = expect(Token::RightBracket, "Expected ']' after array size");
+		Result<const Token*> right_bracket = expect(Token::RightBracket, "Expected ']' after array size");
 		if (!right_bracket.has_value()) {
 			return Err<std::unique_ptr<TypeNode>>(right_bracket.error());
 		}
@@ -111,7 +111,7 @@ ArgonLang::Result<std::unique_ptr<ArgonLang::TypeNode>> ArgonLang::Parser::parse
 	}
 
 	// If not an array type, continue with generic type parsing
-	if (peek().type != Token::Less)
+	if (peek_type() != Token::Less)
 		return base;
 
 	return parse_generic_type_with_base(std::move(base.value()));
@@ -124,13 +124,13 @@ ArgonLang::Result<std::unique_ptr<ArgonLang::TypeNode>> ArgonLang::Parser::parse
 ArgonLang::Result<std::unique_ptr<ArgonLang::TypeNode>>
 ArgonLang::Parser::parse_generic_type_with_base(std::unique_ptr<TypeNode> base) {
 	Token::Position pos = peek().position;
-	Result<Token> less = advance();
+	Result<const Token*> less = advance();
 	if (!less.has_value()) {
 		return Err<std::unique_ptr<TypeNode>>(less.error());
 	}
 
 	std::vector<std::unique_ptr<TypeNode>> args;
-	while (peek().type != Token::Greater) {
+	while (peek_type() != Token::Greater) {
 		Token::Position pos = peek().position;
 		Result<std::unique_ptr<TypeNode>> arg = parse_type();
 		if (!arg.has_value()) {
@@ -139,16 +139,16 @@ ArgonLang::Parser::parse_generic_type_with_base(std::unique_ptr<TypeNode> base)
 
 		args.push_back(std::move(arg.value()));
 
-		if (peek().type == Token::Greater)
+		if (peek_type() == Token::Greater)
 			break;
 
-		Result<Token> comma = expect(Token::Comma, "Expected ',' or '>'");
+		Result<const Token*> comma = expect(Token::Comma, "Expected ',' or '>'");
 		if (!comma.has_value()) {
 			return Err<std::unique_ptr<TypeNode>>(comma.error());
 		}
 	}
 
-	Result<Token> greater = advance();
+	Result<const Token*> greater = advance();
 	if (!greater.has_value()) {
 		return Err<std::unique_ptr<TypeNode>>(greater.error());
 	}
@@ -162,13 +162,13 @@ ArgonLang::Result<std::unique_ptr<ArgonLang::TypeNode>> ArgonLang::Parser::parse
 	if (!left.has_value()) {
 		return Err<std::unique_ptr<TypeNode>>(left.error());
 	}
-	if (peek().type != Token::FilterRange)
+	if (peek_type() != Token::FilterRange)
 		return left;
 
 	std::vector<std::unique_ptr<TypeNode>> types;
 	types.push_back(std::move(left.value()));
-	while (peek().type == Token::FilterRange) {
-		Result<Token> or_token = advance();
+	while (peek_type() == Token::FilterRange) {
+		Result<const Token*> or_token = advance();
 		if (!or_token.has_value()) {
 			return Err<std::unique_ptr<TypeNode>>(or_token.error());
 		}
@@ -191,13 +191,13 @@ ArgonLang::Result<std::unique_ptr<ArgonLang::TypeNode>> ArgonLang::Parser::parse
 	if (!left.has_value()) {
 		return Err<std::unique_ptr<TypeNode>>(left.error());
 	}
-	if (peek().type != Token::MapRange)
+	if (peek_type() != Token::MapRange)
 		return left;
 
 	std::vector<std::unique_ptr<TypeNode>> types;
 	types.push_back(std::move(left.value()));
-	while (peek().type == Token::MapRange) {
-		Result<Token> and_token = advance();
+	while (peek_type() == Token::MapRange) {
+		Result<const Token*> and_token = advance();
 		if (!and_token.has_value()) {
 			return Err<std::unique_ptr<TypeNode>>(and_token.error());
 		}
@@ -222,38 +222,38 @@ ArgonLang::Result<std::unique_ptr<ArgonLang::TypeNode>> ArgonLang::Parser::parse
 	bool is_closure = false;
 
 	// Check if it's a closure (func i32) or regular function (func(i32, i32) i32)
-	if (peek().type == Token::LeftParen) {
+	if (peek_type() == Token::LeftParen) {
 		// Regular function type: func(i32, i32) i32
-		Result<Token> left_paren = advance();
+		Result<const Token*> left_paren = advance();
 		if (!left_paren.has_value()) {
 			return Err<std::unique_ptr<TypeNode>>(left_paren.error());
 		}
 
 		// Parse parameter types
-		while (peek().type != Token::RightParen) {
+		while (peek_type() != Token::RightParen) {
 			auto param_type = parse_type();
 			if (!param_type.has_value()) {
 				return Err<std::unique_ptr<TypeNode>>(param_type.error());
 			}
 			param_types.push_back(std::move(param_type.value()));
 
-			if (peek().type == Token::RightParen)
+			if (peek_type() == Token::RightParen)
 				break;
 
-			Result<Token> comma = expect(Token::Comma, "Expected ',' between parameter types");
+			Result<const Token*> comma = expect(Token::Comma, "Expected ',' between parameter types");
 			if (!comma.has_value()) {
 				return Err<std::unique_ptr<TypeNode>>(comma.error());
 			}
 		}
 
-		Result<Token> right_paren = expect(Token::RightParen, "Expected ')' after parameter types");
+		Result<const Token*> right_paren = expect(Token::RightParen, "Expected ')' after parameter types");
 		if (!right_paren.has_value()) {
 			return Err<std::unique_ptr<TypeNode>>(right_paren.error());
 		}
 
 		// Parse optional return type
-		if (peek().type != Token::Semicolon && peek().type != Token::Comma && peek().type != Token::RightParen &&
-		    peek().type != Token::RightBrace && peek().type != Token::FilterRange && peek().type != Token::MapRange) {
+		if (peek_type() != Token::Semicolon && peek_type() != Token::Comma && peek_type() != Token::RightParen &&
+		    peek_type() != Token::RightBrace && peek_type() != Token::FilterRange && peek_type() != Token::MapRange) {
 			auto ret_type = parse_type();
 			if (!ret_type.has_value()) {
 				return Err<std::unique_ptr<TypeNode>>(ret_type.error());
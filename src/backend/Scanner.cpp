@@ -0,0 +1,258 @@
+#include "backend/Scanner.h"
+
+#include <atomic>
+#include <bit>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64) || (defined(__i386__) && defined(__SSE2__))
+#define ARGON_SCANNER_X86 1
+#include <immintrin.h>
+#else
+#define ARGON_SCANNER_X86 0
+#endif
+
+// AVX2 kernels are compiled with a per-function target attribute and picked at runtime; compilers without it
+// only get them when the whole translation unit already targets AVX2.
+#if ARGON_SCANNER_X86 && (defined(__GNUC__) || defined(__clang__))
+#define ARGON_SCANNER_AVX2 1
+#define ARGON_TARGET_AVX2 __attribute__((target("avx2")))
+#elif ARGON_SCANNER_X86 && defined(__AVX2__)
+#define ARGON_SCANNER_AVX2 1
+#define ARGON_TARGET_AVX2
+#else
+#define ARGON_SCANNER_AVX2 0
+#endif
+
+namespace ArgonLang::Scanner {
+namespace {
+	struct Kernels {
+		std::size_t (*skip_blanks)(const char* data, std::size_t size, std::size_t from, std::size_t& tabs);
+		std::size_t (*find_identifier_end)(const char* data, std::size_t size, std::size_t from);
+		std::size_t (*find_either)(const char* data, std::size_t size, std::size_t from, char a, char b);
+	};
+
+	constexpr bool is_identifier_char(char c) {
+		return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+	}
+
+	// Scalar kernels; also finish the tail of the SIMD kernels
+	std::size_t skip_blanks_scalar(const char* data, std::size_t size, std::size_t from, std::size_t& tabs) {
+		for (; from < size && (data[from] == ' ' || data[from] == '\t'); ++from) {
+			tabs += data[from] == '\t';
+		}
+		return from;
+	}
+
+	std::size_t find_identifier_end_scalar(const char* data, std::size_t size, std::size_t from) {
+		while (from < size && is_identifier_char(data[from])) {
+			++from;
+		}
+		return from;
+	}
+
+	std::size_t find_either_scalar(const char* data, std::size_t size, std::size_t from, char a, char b) {
+		while (from < size && data[from] != a && data[from] != b) {
+			++from;
+		}
+		return from;
+	}
+
+#if ARGON_SCANNER_X86
+	// Bytes in [lo, hi]; bytes >= 0x80 compare as negative and never match the ASCII ranges used here
+	inline __m128i in_range_sse2(__m128i bytes, char lo, char hi) {
+		return _mm_and_si128(_mm_cmpgt_epi8(bytes, _mm_set1_epi8(static_cast<char>(lo - 1))),
+		                     _mm_cmplt_epi8(bytes, _mm_set1_epi8(static_cast<char>(hi + 1))));
+	}
+
+	std::size_t skip_blanks_sse2(const char* data, std::size_t size, std::size_t from, std::size_t& tabs) {
+		const __m128i space = _mm_set1_epi8(' ');
+		const __m128i tab = _mm_set1_epi8('\t');
+		for (; from + 16 <= size; from += 16) {
+			__m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + from));
+			__m128i is_tab = _mm_cmpeq_epi8(bytes, tab);
+			__m128i is_blank = _mm_or_si128(_mm_cmpeq_epi8(bytes, space), is_tab);
+			auto blank = static_cast<std::uint32_t>(_mm_movemask_epi8(is_blank));
+			auto tab_mask = static_cast<std::uint32_t>(_mm_movemask_epi8(is_tab));
+			if (blank != 0xFFFF) {
+				unsigned run = std::countr_one(blank);
+				tabs += std::popcount(tab_mask & ((1u << run) - 1));
+				return from + run;
+			}
+			tabs += std::popcount(tab_mask);
+		}
+		return skip_blanks_scalar(data, size, from, tabs);
+	}
+
+	std::size_t find_identifier_end_sse2(const char* data, std::size_t size, std::size_t from) {
+		const __m128i lower_case = _mm_set1_epi8(0x20);
+		const __m128i underscore = _mm_set1_epi8('_');
+		for (; from + 16 <= size; from += 16) {
+			__m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + from));
+			// Setting bit 5 folds 'A'-'Z' onto 'a'-'z' without moving digits or '_' into either range
+			__m128i letter = in_range_sse2(_mm_or_si128(bytes, lower_case), 'a', 'z');
+			__m128i digit = in_range_sse2(bytes, '0', '9');
+			__m128i identifier = _mm_or_si128(_mm_or_si128(letter, digit), _mm_cmpeq_epi8(bytes, underscore));
+			auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(identifier));
+			if (mask != 0xFFFF) {
+				return from + std::countr_one(mask);
+			}
+		}
+		return find_identifier_end_scalar(data, size, from);
+	}
+
+	std::size_t find_either_sse2(const char* data, std::size_t size, std::size_t from, char a, char b) {
+		const __m128i first = _mm_set1_epi8(a);
+		const __m128i second = _mm_set1_epi8(b);
+		for (; from + 16 <= size; from += 16) {
+			__m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + from));
+			__m128i found = _mm_or_si128(_mm_cmpeq_epi8(bytes, first), _mm_cmpeq_epi8(bytes, second));
+			auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(found));
+			if (mask != 0) {
+				return from + std::countr_zero(mask);
+			}
+		}
+		return find_either_scalar(data, size, from, a, b);
+	}
+#endif
+
+#if ARGON_SCANNER_AVX2
+	ARGON_TARGET_AVX2 inline __m256i in_range_avx2(__m256i bytes, char lo, char hi) {
+		return _mm256_and_si256(_mm256_cmpgt_epi8(bytes, _mm256_set1_epi8(static_cast<char>(lo - 1))),
+		                        _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(hi + 1)), bytes));
+	}
+
+	ARGON_TARGET_AVX2 std::size_t skip_blanks_avx2(const char* data, std::size_t size, std::size_t from,
+	                                               std::size_t& tabs) {
+		const __m256i space = _mm256_set1_epi8(' ');
+		const __m256i tab = _mm256_set1_epi8('\t');
+		for (; from + 32 <= size; from += 32) {
+			__m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + from));
+			__m256i is_tab = _mm256_cmpeq_epi8(bytes, tab);
+			auto blank = static_cast<std::uint32_t>(
+			    _mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(bytes, space), is_tab)));
+			auto tab_mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(is_tab));
+			if (blank != 0xFFFFFFFF) {
+				unsigned run = std::countr_one(blank);
+				tabs += std::popcount(tab_mask & ((std::uint64_t{1} << run) - 1));
+				return from + run;
+			}
+			tabs += std::popcount(tab_mask);
+		}
+		return skip_blanks_sse2(data, size, from, tabs);
+	}
+
+	ARGON_TARGET_AVX2 std::size_t find_identifier_end_avx2(const char* data, std::size_t size, std::size_t from) {
+		const __m256i lower_case = _mm256_set1_epi8(0x20);
+		const __m256i underscore = _mm256_set1_epi8('_');
+		for (; from + 32 <= size; from += 32) {
+			__m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + from));
+			__m256i letter = in_range_avx2(_mm256_or_si256(bytes, lower_case), 'a', 'z');
+			__m256i digit = in_range_avx2(bytes, '0', '9');
+			__m256i identifier = _mm256_or_si256(_mm256_or_si256(letter, digit), _mm256_cmpeq_epi8(bytes, underscore));
+			auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(identifier));
+			if (mask != 0xFFFFFFFF) {
+				return from + std::countr_one(mask);
+			}
+		}
+		return find_identifier_end_sse2(data, size, from);
+	}
+
+	ARGON_TARGET_AVX2 std::size_t find_either_avx2(const char* data, std::size_t size, std::size_t from, char a,
+	                                               char b) {
+		const __m256i first = _mm256_set1_epi8(a);
+		const __m256i second = _mm256_set1_epi8(b);
+		for (; from + 32 <= size; from += 32) {
+			__m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + from));
+			__m256i found = _mm256_or_si256(_mm256_cmpeq_epi8(bytes, first), _mm256_cmpeq_epi8(bytes, second));
+			auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(found));
+			if (mask != 0) {
+				return from + std::countr_zero(mask);
+			}
+		}
+		return find_either_sse2(data, size, from, a, b);
+	}
+#endif
+
+	constexpr Kernels SCALAR_KERNELS{skip_blanks_scalar, find_identifier_end_scalar, find_either_scalar};
+#if ARGON_SCANNER_X86
+	constexpr Kernels SSE2_KERNELS{skip_blanks_sse2, find_identifier_end_sse2, find_either_sse2};
+#endif
+#if ARGON_SCANNER_AVX2
+	constexpr Kernels AVX2_KERNELS{skip_blanks_avx2, find_identifier_end_avx2, find_either_avx2};
+#endif
+
+	InstructionSet detect_instruction_set() {
+#if ARGON_SCANNER_AVX2 && (defined(__GNUC__) || defined(__clang__))
+		if (__builtin_cpu_supports("avx2")) {
+			return InstructionSet::AVX2;
+		}
+#elif ARGON_SCANNER_AVX2
+		return InstructionSet::AVX2;
+#endif
+#if ARGON_SCANNER_X86
+		return InstructionSet::SSE2;
+#else
+		return InstructionSet::Scalar;
+#endif
+	}
+
+	const Kernels* kernels_for(InstructionSet set) {
+		switch (set) {
+#if ARGON_SCANNER_AVX2
+		case InstructionSet::AVX2:
+			return &AVX2_KERNELS;
+#endif
+#if ARGON_SCANNER_X86
+		case InstructionSet::SSE2:
+			return &SSE2_KERNELS;
+#endif
+		default:
+			return &SCALAR_KERNELS;
+		}
+	}
+
+	struct Dispatch {
+		InstructionSet best = detect_instruction_set();
+		std::atomic<InstructionSet> active{best};
+		std::atomic<const Kernels*> kernels{kernels_for(best)};
+	};
+
+	Dispatch& dispatch() {
+		static Dispatch instance;
+		return instance;
+	}
+
+	const Kernels& kernels() {
+		return *dispatch().kernels.load(std::memory_order_relaxed);
+	}
+} // namespace
+
+InstructionSet best_instruction_set() {
+	return dispatch().best;
+}
+
+InstructionSet active_instruction_set() {
+	return dispatch().active.load(std::memory_order_relaxed);
+}
+
+void set_instruction_set(InstructionSet set) {
+	Dispatch& state = dispatch();
+	if (static_cast<int>(set) > static_cast<int>(state.best)) {
+		set = state.best;
+	}
+	state.active.store(set, std::memory_order_relaxed);
+	state.kernels.store(kernels_for(set), std::memory_order_relaxed);
+}
+
+std::size_t skip_blanks(std::string_view input, std::size_t from, std::size_t& tabs) {
+	return kernels().skip_blanks(input.data(), input.size(), from, tabs);
+}
+
+std::size_t find_identifier_end(std::string_view input, std::size_t from) {
+	return kernels().find_identifier_end(input.data(), input.size(), from);
+}
+
+std::size_t find_either(std::string_view input, std::size_t from, char a, char b) {
+	return kernels().find_either(input.data(), input.size(), from, a, b);
+}
+} // namespace ArgonLang::Scanner
@@ -0,0 +1,129 @@
+#include "backend/SourceBuffer.h"
+
+#include <fstream>
+#include <iterator>
+#include <utility>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace ArgonLang;
+
+SourceBuffer::SourceBuffer(SourceBuffer&& other) noexcept
+    : data(std::exchange(other.data, nullptr)), size(std::exchange(other.size, 0)),
+      mapped(std::exchange(other.mapped, false)), owned(std::move(other.owned)) {}
+
+SourceBuffer& SourceBuffer::operator=(SourceBuffer&& other) noexcept {
+	if (this != &other) {
+		release();
+		data = std::exchange(other.data, nullptr);
+		size = std::exchange(other.size, 0);
+		mapped = std::exchange(other.mapped, false);
+		owned = std::move(other.owned);
+	}
+	return *this;
+}
+
+SourceBuffer::~SourceBuffer() {
+	release();
+}
+
+void SourceBuffer::release() {
+	if (!mapped) {
+		return;
+	}
+#if defined(_WIN32)
+	UnmapViewOfFile(data);
+#else
+	munmap(const_cast<char*>(data), size);
+#endif
+	data = nullptr;
+	size = 0;
+	mapped = false;
+}
+
+SourceBuffer SourceBuffer::from_string(std::string contents) {
+	SourceBuffer buffer;
+	buffer.owned = std::move(contents);
+	return buffer;
+}
+
+Result<SourceBuffer> SourceBuffer::open(const std::string& filename) {
+	auto not_readable = [&]() {
+		return Err<SourceBuffer>(ErrorType::SourceNotReadable, "Cannot read source file '" + filename + "'",
+		                         Position(filename, 0, 0));
+	};
+
+#if defined(_WIN32)
+	HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+	                          FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		return not_readable();
+	}
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize)) {
+		CloseHandle(file);
+		return not_readable();
+	}
+	if (fileSize.QuadPart == 0) {
+		CloseHandle(file);
+		return SourceBuffer(); // Empty files cannot be mapped
+	}
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(file);
+	if (mapping != nullptr) {
+		const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		CloseHandle(mapping); // The view keeps the mapping alive
+		if (view != nullptr) {
+			SourceBuffer buffer;
+			buffer.data = static_cast<const char*>(view);
+			buffer.size = static_cast<std::size_t>(fileSize.QuadPart);
+			buffer.mapped = true;
+			return buffer;
+		}
+	}
+#else
+	int fd = ::open(filename.c_str(), O_RDONLY);
+	if (fd < 0) {
+		return not_readable();
+	}
+	struct stat info {};
+	if (fstat(fd, &info) != 0) {
+		::close(fd);
+		return not_readable();
+	}
+	if (S_ISREG(info.st_mode) && info.st_size > 0) {
+		void* view = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+		::close(fd); // The mapping stays valid after the descriptor is closed
+		if (view != MAP_FAILED) {
+#if defined(POSIX_MADV_SEQUENTIAL)
+			posix_madvise(view, static_cast<std::size_t>(info.st_size), POSIX_MADV_SEQUENTIAL);
+#endif
+			SourceBuffer buffer;
+			buffer.data = static_cast<const char*>(view);
+			buffer.size = static_cast<std::size_t>(info.st_size);
+			buffer.mapped = true;
+			return buffer;
+		}
+	} else {
+		::close(fd);
+		if (S_ISREG(info.st_mode)) {
+			return SourceBuffer(); // Empty files cannot be mapped
+		}
+	}
+#endif
+
+	// Pipes, devices and failed mappings are read into memory instead
+	std::ifstream file(filename, std::ios::binary);
+	if (!file) {
+		return not_readable();
+	}
+	return from_string(std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()));
+}
@@ -0,0 +1,131 @@
+#include "backend/TokenStream.h"
+
+#include <stdexcept>
+
+namespace ArgonLang {
+namespace {
+// Tokens tokenized per pull; enough to amortise the call without reading far past the parser
+constexpr size_t BATCH_SIZE = 64;
+
+const std::string NO_ERROR;
+
+// closing entry of a '(' whose ')' has not been tokenized yet, and of every other token
+constexpr size_t UNMATCHED = static_cast<size_t>(-1);
+} // namespace
+
+TokenStream::TokenStream(std::string_view input) : lexer(std::in_place, input) {
+	batch.reserve(BATCH_SIZE + 1);
+}
+
+TokenStream::TokenStream(const std::vector<Token>& tokens) : source(&tokens) {
+	peak_window = tokens.size();
+}
+
+bool TokenStream::pull() {
+	if (lexer->is_finished()) {
+		return false;
+	}
+	batch.clear();
+	if (!lexer->lex(batch, BATCH_SIZE)) {
+		// The parser sees the input end where the error is; the caller reports the error itself
+		Token::Position position = lexer->get_error_position();
+		batch.emplace_back(Token::End, "END", size_t(position.line), size_t(position.column));
+	}
+
+	// Drop what the parser has released before growing the window
+	while (first < release_point && !window.empty()) {
+		window.pop_front();
+		closing.pop_front();
+		first++;
+	}
+	for (const Token& token : batch) {
+		match_parens(token, first + window.size());
+		window.push_back(token);
+	}
+	peak_window = std::max(peak_window, window.size());
+	return true;
+}
+
+bool TokenStream::has(size_t index) {
+	if (source) {
+		return index < source->size();
+	}
+	while (index >= first + window.size()) {
+		if (!pull()) {
+			return false;
+		}
+	}
+	return true;
+}
+
+const Token& TokenStream::at(size_t index) {
+	if (source) {
+		return index < source->size() ? (*source)[index] : source->back();
+	}
+	if (!has(index)) {
+		return window.back(); // The End token is never released
+	}
+	if (index < first) {
+		throw std::logic_error("Token " + std::to_string(index) + " was read after being released");
+	}
+	return window[index - first];
+}
+
+void TokenStream::match_parens(const Token& token, size_t index) {
+	closing.push_back(UNMATCHED);
+	if (token.type == Token::LeftParen) {
+		open_parens.push_back(index);
+	} else if (token.type == Token::RightParen && !open_parens.empty()) {
+		// A '(' released before its ')' arrived is never asked about again
+		if (open_parens.back() >= first) {
+			closing[open_parens.back() - first] = index;
+		}
+		open_parens.pop_back();
+	} else if (token.type == Token::End) {
+		for (size_t open : open_parens) {
+			if (open >= first) {
+				closing[open - first] = index;
+			}
+		}
+		open_parens.clear();
+	}
+}
+
+size_t TokenStream::matching_paren(size_t index) {
+	if (at(index).type != Token::LeftParen) {
+		throw std::logic_error("Token " + std::to_string(index) + " is not a '('");
+	}
+	if (source) {
+		// Paired up in one pass over the whole view on first use
+		if (closing.empty()) {
+			for (size_t i = 0; i < source->size(); ++i) {
+				match_parens((*source)[i], i);
+			}
+		}
+		return closing[index];
+	}
+	while (closing[index - first] == UNMATCHED && pull()) {
+	}
+	return closing[index - first];
+}
+
+void TokenStream::release_before(size_t index) {
+	if (source || index <= release_point) {
+		return;
+	}
+	release_point = index;
+	// Dropping is deferred to the next pull, so the End token and anything still in view stay put until then
+}
+
+const std::string& TokenStream::get_error_message() const {
+	return has_error() ? lexer->get_error_message() : NO_ERROR;
+}
+
+Token::Position TokenStream::get_error_position() const {
+	return has_error() ? lexer->get_error_position() : Token::Position{0, 0};
+}
+
+size_t TokenStream::get_token_count() const {
+	return source ? source->size() : first + window.size();
+}
+} // namespace ArgonLang
@@ -1,11 +1,22 @@
 #include "backend/Tokenizer.h"
 
 #include "Error/ErrorFormatter.h"
+#include "backend/Scanner.h"
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
 #include <sstream>
 
 namespace ArgonLang {
-const std::unordered_map<std::string, Token::Type> keywords = {
+namespace {
+struct Keyword {
+	std::string_view spelling;
+	Token::Type type;
+};
+
+constexpr Keyword KEYWORDS[] = {
     {"def", Token::KeywordDef},
     {"const", Token::KeywordDef},
     {"mut", Token::KeywordMut},
@@ -77,35 +88,112 @@ const std::unordered_map<std::string, Token::Type> keywords = {
     {"constraint", Token::KeywordConstraint},
 
     {"par", Token::KeywordPar},
-
 };
+
+// Keywords are looked up through a perfect hash: FNV-1a over the spelling with a seed that is searched for at
+// compile time so that every keyword lands in its own slot. A lookup hashes at most MAX_KEYWORD_LENGTH bytes
+// and does a single comparison, with no allocation.
+constexpr std::size_t KEYWORD_SLOTS = 512;
+constexpr std::uint8_t EMPTY_SLOT = 0xFF;
+static_assert(std::size(KEYWORDS) < EMPTY_SLOT);
+
+constexpr std::size_t MAX_KEYWORD_LENGTH = [] {
+	std::size_t length = 0;
+	for (const Keyword& keyword : KEYWORDS) {
+		length = std::max(length, keyword.spelling.size());
+	}
+	return length;
+}();
+
+constexpr std::size_t keyword_slot(std::string_view spelling, std::uint32_t seed) {
+	std::uint32_t hash = 2166136261u ^ seed;
+	for (char c : spelling) {
+		hash = (hash ^ static_cast<unsigned char>(c)) * 16777619u;
+	}
+	return (hash ^ (hash >> 15)) & (KEYWORD_SLOTS - 1);
 }
 
-ArgonLang::TokenizeResult ArgonLang::tokenize(const std::string& input) {
-	std::vector<Token> tokens;
+constexpr std::uint32_t KEYWORD_SEED = [] {
+	for (std::uint32_t seed = 0;; ++seed) {
+		std::array<bool, KEYWORD_SLOTS> used{};
+		bool collision = false;
+		for (const Keyword& keyword : KEYWORDS) {
+			std::size_t slot = keyword_slot(keyword.spelling, seed);
+			collision = collision || used[slot];
+			used[slot] = true;
+		}
+		if (!collision) {
+			return seed;
+		}
+	}
+}();
+
+constexpr std::array<std::uint8_t, KEYWORD_SLOTS> KEYWORD_TABLE = [] {
+	std::array<std::uint8_t, KEYWORD_SLOTS> table{};
+	table.fill(EMPTY_SLOT);
+	for (std::size_t i = 0; i < std::size(KEYWORDS); ++i) {
+		table[keyword_slot(KEYWORDS[i].spelling, KEYWORD_SEED)] = static_cast<std::uint8_t>(i);
+	}
+	return table;
+}();
+} // namespace
+
+Token::Type keyword_type(std::string_view identifier) {
+	if (identifier.size() > MAX_KEYWORD_LENGTH) {
+		return Token::Identifier;
+	}
+	std::uint8_t index = KEYWORD_TABLE[keyword_slot(identifier, KEYWORD_SEED)];
+	if (index == EMPTY_SLOT || KEYWORDS[index].spelling != identifier) {
+		return Token::Identifier;
+	}
+	return KEYWORDS[index].type;
+}
+}
+
+ArgonLang::Lexer::Lexer(std::string_view input) : input(input) {}
+
+bool ArgonLang::Lexer::fail(std::string message, Token::Position position) {
+	error_message = std::move(message);
+	error_position = position;
+	finished = true;
+	return false;
+}
+
+bool ArgonLang::Lexer::lex(std::vector<Token>& tokens, size_t count) {
+	if (finished) {
+		return !has_error();
+	}
+
+	std::deque<std::string>& ownedValues = owned_values;
 	size_t length = input.size();
-	size_t i = 0;
+	size_t target = tokens.size() + std::min(count, std::numeric_limits<size_t>::max() - tokens.size());
+	size_t i = position;
+
+	// Lookahead that reads as '\0' past the end; the input is not necessarily NUL-terminated (e.g. a mapped file)
+	auto peek = [&](size_t ahead) { return i + ahead < length ? input[i + ahead] : '\0'; };
 
-	size_t currentLine = 1;
-	size_t currentColumn = 1;
+	size_t currentLine = line;
+	size_t currentColumn = column;
 
-	while (i < length) {
+	while (i < length && tokens.size() < target) {
 		char c = input[i];
 		if (c == '\n') {
 			currentLine++;
 			currentColumn = 1;
 			i++;
 
-			while (input[i] == ' ' || input[i] == '\t') {
-				i++;
-			}
-
+			// Indentation does not count towards the column
+			size_t tabs = 0;
+			i = Scanner::skip_blanks(input, i, tabs);
 			continue;
 		}
 
-		if (c == '\t') {
-			currentColumn += 4;
-			i++;
+		if (c == ' ' || c == '\t') {
+			// Tabs count as four columns
+			size_t tabs = 0;
+			size_t end = Scanner::skip_blanks(input, i, tabs);
+			currentColumn += (end - i) + 3 * tabs;
+			i = end;
 			continue;
 		}
 
@@ -119,14 +207,23 @@ ArgonLang::TokenizeResult ArgonLang::tokenize(const std::string& input) {
 			char quoteType = c;
 			size_t start = i;
 			i++;
+
+			// Literals without escapes are a plain slice of the input; only the others are copied
+			size_t end = Scanner::find_either(input, i, quoteType, '\\');
+			std::string_view literalValue = input.substr(i, end - i);
+			bool hasEscapes = end < length && input[end] == '\\';
 			std::string stringLiteral;
+			if (hasEscapes) {
+				stringLiteral.assign(literalValue);
+			}
+			i = end;
 			while (i < length && input[i] != quoteType) {
 				if (input[i] == '\\') {
 					i++;
 					if (i >= length) {
-						return TokenizeResult(ErrorFormatter::formatTokenizerError(
-						                          "Unterminated escape sequence in string", currentLine, currentColumn),
-						                      {currentLine, currentColumn});
+						return fail(ErrorFormatter::formatTokenizerError("Unterminated escape sequence in string",
+						                                                 currentLine, currentColumn),
+						            {currentLine, currentColumn});
 					}
 					switch (input[i]) {
 					case 'n':
@@ -154,26 +251,32 @@ ArgonLang::TokenizeResult ArgonLang::tokenize(const std::string& input) {
 						stringLiteral += input[i];
 						break;
 					}
+					i++;
 				} else {
-					stringLiteral += input[i];
+					size_t next = Scanner::find_either(input, i, quoteType, '\\');
+					stringLiteral.append(input.substr(i, next - i));
+					i = next;
 				}
-				i++;
 			}
 			if (i >= length || input[i] != quoteType) {
-				return TokenizeResult(
+				return fail(
 				    ErrorFormatter::formatTokenizerError("Unterminated string literal", currentLine, currentColumn),
 				    {currentLine, currentColumn});
 			}
 			i++;
 
+			if (hasEscapes) {
+				literalValue = ownedValues.emplace_back(std::move(stringLiteral));
+			}
+
 			if (quoteType == '\"')
-				tokens.emplace_back(Token::StringLiteral, stringLiteral, currentLine, currentColumn);
-			else if (stringLiteral.size() != 1) {
-				return TokenizeResult(ErrorFormatter::formatTokenizerError("Multiple characters in char literal",
-				                                                           currentLine, currentColumn),
-				                      {currentLine, currentColumn});
+				tokens.emplace_back(Token::StringLiteral, literalValue, currentLine, currentColumn);
+			else if (literalValue.size() != 1) {
+				return fail(ErrorFormatter::formatTokenizerError("Multiple characters in char literal", currentLine,
+				                                                 currentColumn),
+				            {currentLine, currentColumn});
 			} else
-				tokens.emplace_back(Token::CharLiteral, stringLiteral, currentLine, currentColumn);
+				tokens.emplace_back(Token::CharLiteral, literalValue, currentLine, currentColumn);
 
 			currentColumn += (i - start);
 			continue;
@@ -188,13 +291,13 @@ ArgonLang::TokenizeResult ArgonLang::tokenize(const std::string& input) {
 			
 			// Check for hex (0x), binary (0b), octal (0o) prefixes
 			if (c == '0' && i + 1 < length) {
-				if (input[i + 1] == 'x' || input[i + 1] == 'X') {
+				if (peek(1) == 'x' || peek(1) == 'X') {
 					isHex = true;
 					i += 2; // Skip '0x'
-				} else if (input[i + 1] == 'b' || input[i + 1] == 'B') {
+				} else if (peek(1) == 'b' || peek(1) == 'B') {
 					isBinary = true;
 					i += 2; // Skip '0b'
-				} else if (input[i + 1] == 'o' || input[i + 1] == 'O') {
+				} else if (peek(1) == 'o' || peek(1) == 'O') {
 					isOctal = true;
 					i += 2; // Skip '0o'
 				}
@@ -218,10 +321,10 @@ ArgonLang::TokenizeResult ArgonLang::tokenize(const std::string& input) {
 				while (i < length && (std::isdigit(input[i]) || input[i] == '.' || input[i] == '`' || input[i] == 'e' || input[i] == 'E')) {
 					if (input[i] == '.') {
 						if (isDecimal) {
-							return TokenizeResult(
+							return fail(
 							    ErrorFormatter::formatTokenizerError("Invalid numeric literal: multiple decimal points",
 							                                         currentLine, currentColumn),
-							                      {currentLine, currentColumn});
+							    {currentLine, currentColumn});
 						}
 						isDecimal = true;
 					} else if (input[i] == 'e' || input[i] == 'E') {
@@ -239,18 +342,18 @@ ArgonLang::TokenizeResult ArgonLang::tokenize(const std::string& input) {
 
 			// Check for type suffixes
 			size_t numEnd = i;
-			std::string suffix;
+			std::string_view suffix;
 			if (!isDecimal) {
 				// Integer type suffixes: i128, u128, i64, u64, i32, u32, i16, u16, i8, u8
 				if (i + 4 <= length) {
-					std::string possibleSuffix = input.substr(i, 4);
+					std::string_view possibleSuffix = input.substr(i, 4);
 					if (possibleSuffix == "i128" || possibleSuffix == "u128") {
 						suffix = possibleSuffix;
 						i += 4;
 					}
 				}
 				if (suffix.empty() && i + 3 <= length) {
-					std::string possibleSuffix = input.substr(i, 3);
+					std::string_view possibleSuffix = input.substr(i, 3);
 					if (possibleSuffix == "i64" || possibleSuffix == "u64" || 
 					    possibleSuffix == "i32" || possibleSuffix == "u32" ||
 					    possibleSuffix == "i16" || possibleSuffix == "u16") {
@@ -259,7 +362,7 @@ ArgonLang::TokenizeResult ArgonLang::tokenize(const std::string& input) {
 					}
 				}
 				if (suffix.empty() && i + 2 <= length) {
-					std::string possibleSuffix = input.substr(i, 2);
+					std::string_view possibleSuffix = input.substr(i, 2);
 					if (possibleSuffix == "i8" || possibleSuffix == "u8") {
 						suffix = possibleSuffix;
 						i += 2;
@@ -268,14 +371,14 @@ ArgonLang::TokenizeResult ArgonLang::tokenize(const std::string& input) {
 			} else {
 				// Float type suffixes: f128, f64, f32, f16
 				if (i + 4 <= length) {
-					std::string possibleSuffix = input.substr(i, 4);
+					std::string_view possibleSuffix = input.substr(i, 4);
 					if (possibleSuffix == "f128") {
 						suffix = possibleSuffix;
 						i += 4;
 					}
 				}
 				if (suffix.empty() && i + 3 <= length) {
-					std::string possibleSuffix = input.substr(i, 3);
+					std::string_view possibleSuffix = input.substr(i, 3);
 					if (possibleSuffix == "f64" || possibleSuffix == "f32" || possibleSuffix == "f16") {
 						suffix = possibleSuffix;
 						i += 3;
@@ -283,9 +386,14 @@ ArgonLang::TokenizeResult ArgonLang::tokenize(const std::string& input) {
 				}
 			}
 
-			std::string numLiteral = input.substr(start, i - start);
+			std::string_view numLiteral = input.substr(start, i - start);
 
-			std::erase(numLiteral, '`');
+			// Digit separators are dropped, which needs a copy of the literal
+			if (numLiteral.find('`') != std::string_view::npos) {
+				std::string& withoutSeparators = ownedValues.emplace_back(numLiteral);
+				std::erase(withoutSeparators, '`');
+				numLiteral = withoutSeparators;
+			}
 
 			if (isDecimal) {
 				tokens.emplace_back(Token::FloatLiteral, numLiteral, currentLine, currentColumn);
@@ -298,31 +406,31 @@ ArgonLang::TokenizeResult ArgonLang::tokenize(const std::string& input) {
 		}
 		if (std::isalpha(c) || c == '_') {
 			size_t start = i;
-			while (i < length && (std::isalnum(input[i]) || input[i] == '_')) {
-				i++;
-				currentColumn++;
-			}
-			std::string identifier = input.substr(start, i - start);
-			auto it = keywords.find(identifier);
-			if (it != keywords.end()) {
-				tokens.emplace_back(it->second, it->first, currentLine, currentColumn);
-				continue;
-			}
-			tokens.emplace_back(Token::Identifier, identifier, currentLine, currentColumn);
+			i = Scanner::find_identifier_end(input, i);
+			currentColumn += i - start;
+			std::string_view identifier = input.substr(start, i - start);
+			tokens.emplace_back(keyword_type(identifier), identifier, currentLine, currentColumn);
 			continue;
-		} else if (c == '/' && input[i + 1] == '/') {
+		} else if (c == '/' && peek(1) == '/') {
 			// Skip single-line comments
-			while (i < length && input[i] != '\n') {
-				i++;
-				currentColumn++;
-			}
+			size_t end = Scanner::find_either(input, i, '\n', '\n');
+			currentColumn += end - i;
+			i = end;
 			continue;
-		} else if (c == '/' && input[i + 1] == '*') {
+		} else if (c == '/' && peek(1) == '*') {
 			// Skip multi-line comments
 			i += 2;
 			currentColumn += 2;
+			// The closing "*/" needs two bytes, so the last byte is never part of the scan
+			std::string_view body = input.substr(0, length - 1);
 			while (i < length - 1) {
-				if (input[i] == '*' && input[i + 1] == '/') {
+				size_t next = Scanner::find_either(body, i, '*', '\n');
+				currentColumn += next - i;
+				i = next;
+				if (i >= length - 1) {
+					break;
+				}
+				if (input[i] == '*' && peek(1) == '/') {
 					i += 2;
 					currentColumn += 2;
 					break;
@@ -336,49 +444,49 @@ ArgonLang::TokenizeResult ArgonLang::tokenize(const std::string& input) {
 				i++;
 			}
 			continue;
-		} else if (c == '=' && input[i + 1] == '=') {
+		} else if (c == '=' && peek(1) == '=') {
 			tokens.emplace_back(Token::Equal, "==", currentLine, currentColumn);
 			i += 2;
 			currentColumn += 2;
-		} else if (c == '!' && input[i + 1] == '=') {
+		} else if (c == '!' && peek(1) == '=') {
 			tokens.emplace_back(Token::NotEqual, "!=", currentLine, currentColumn);
 			i += 2;
 			currentColumn += 2;
-		} else if (c == '+' && input[i + 1] == '+') {
+		} else if (c == '+' && peek(1) == '+') {
 			tokens.emplace_back(Token::Increment, "++", currentLine, currentColumn);
 			i += 2;
 			currentColumn += 2;
-		} else if (c == '-' && input[i + 1] == '-') {
+		} else if (c == '-' && peek(1) == '-') {
 			tokens.emplace_back(Token::Decrement, "--", currentLine, currentColumn);
 			i += 2;
 			currentColumn += 2;
-		} else if (c == '+' && input[i + 1] == '=') {
+		} else if (c == '+' && peek(1) == '=') {
 			tokens.emplace_back(Token::PlusAssign, "+=", currentLine, currentColumn);
 			i += 2;
 			currentColumn += 2;
-		} else if (c == '-' && input[i + 1] == '=') {
+		} else if (c == '-' && peek(1) == '=') {
 			tokens.emplace_back(Token::MinusAssign, "-=", currentLine, currentColumn);
 			i += 2;
 			currentColumn += 2;
-		} else if (c == '*' && input[i + 1] == '=') {
+		} else if (c == '*' && peek(1) == '=') {
 			tokens.emplace_back(Token::MultiplyAssign, "*=", currentLine, currentColumn);
 			i += 2;
 			currentColumn += 2;
-		} else if (c == '/' && input[i + 1] == '=') {
+		} else if (c == '/' && peek(1) == '=') {
 			tokens.emplace_back(Token::DivideAssign, "/=", currentLine, currentColumn);
 			i += 2;
 			currentColumn += 2;
-		} else if (c == '%' && input[i + 1] == '=') {
+		} else if (c == '%' && peek(1) == '=') {
 			tokens.emplace_back(Token::ModuloAssign, "%=", currentLine, currentColumn);
 			i += 2;
 			currentColumn += 2;
-		} else if (c == '&' && input[i + 1] == '&') {
+		} else if (c == '&' && peek(1) == '&') {
 			tokens.emplace_back(Token::LogicalAnd, "&&", currentLine, currentColumn);
 			i += 2;
 			currentColumn += 2;
-		} else if (c == '|' && input[i + 1] == '|') {
-			if (input[i + 2] == '>') {
-				if (input[i + 3] == '=') {
+		} else if (c == '|' && peek(1) == '|') {
+			if (peek(2) == '>') {
+				if (peek(3) == '=') {
 					tokens.emplace_back(Token::MapPipeAssign, "||>=", currentLine, currentColumn);
 					i += 4;
 					currentColumn += 4;
@@ -392,8 +500,8 @@ ArgonLang::TokenizeResult ArgonLang::tokenize(const std::string& input) {
 			tokens.emplace_back(Token::LogicalOr, "||", currentLine, currentColumn);
 			i += 2;
 			currentColumn += 2;
-		} else if (c == '*' && input[i + 1] == '<') {
-			if (input[i + 2] == '=') {
+		} else if (c == '*' && peek(1) == '<') {
+			if (peek(2) == '=') {
 				tokens.emplace_back(Token::LeftShiftAssign, "*<=", currentLine, currentColumn);
 				i += 3;
 				currentColumn += 3;
@@ -403,8 +511,8 @@ ArgonLang::TokenizeResult ArgonLang::tokenize(const std::string& input) {
 			tokens.emplace_back(Token::LeftShift, "*<", currentLine, currentColumn);
 			i += 2;
 			currentColumn += 2;
-		} else if (c == '*' && input[i + 1] == '>') {
-			if (input[i + 2] == '=') {
+		} else if (c == '*' && peek(1) == '>') {
+			if (peek(2) == '=') {
 				tokens.emplace_back(Token::RightShiftAssign, "*>=", currentLine, currentColumn);
 				i += 3;
 				currentColumn += 3;
@@ -414,32 +522,32 @@ ArgonLang::TokenizeResult ArgonLang::tokenize(const std::string& input) {
 			tokens.emplace_back(Token::RightShift, "*>", currentLine, currentColumn);
 			i += 2;
 			currentColumn += 2;
-		} else if (c == '<' && input[i + 1] == '=') {
+		} else if (c == '<' && peek(1) == '=') {
 			tokens.emplace_back(Token::LessEqual, "<=", currentLine, currentColumn);
 			i += 2;
 			currentColumn += 2;
-		} else if (c == '>' && input[i + 1] == '=') {
+		} else if (c == '>' && peek(1) == '=') {
 			tokens.emplace_back(Token::GreaterEqual, ">=", currentLine, currentColumn);
 			i += 2;
 			currentColumn += 2;
-		} else if (c == '&' && input[i + 1] == '=') {
+		} else if (c == '&' && peek(1) == '=') {
 			tokens.emplace_back(Token::MapAssign, "&=", currentLine, currentColumn);
 			i += 2;
 			currentColumn += 2;
-		} else if (c == '?' && input[i + 1] == '?') {
+		} else if (c == '?' && peek(1) == '?') {
 			tokens.emplace_back(Token::DoubleQuestionMark, "??", currentLine, currentColumn);
 			i += 2;
 			currentColumn += 2;
-		} else if (c == '?' && input[i + 1] == '=') {
+		} else if (c == '?' && peek(1) == '=') {
 			tokens.emplace_back(Token::ReduceAssign, "?=", currentLine, currentColumn);
 			i += 2;
 			currentColumn += 2;
-		} else if (c == '|' && input[i + 1] == '=') {
+		} else if (c == '|' && peek(1) == '=') {
 			tokens.emplace_back(Token::FilterAssign, "|=", currentLine, currentColumn);
 			i += 2;
 			currentColumn += 2;
-		} else if (c == '|' && input[i + 1] == '|' && input[i + 2] == '>') {
-			if (input[i + 3] == '=') {
+		} else if (c == '|' && peek(1) == '|' && peek(2) == '>') {
+			if (peek(3) == '=') {
 				tokens.emplace_back(Token::MapPipeAssign, "||>=", currentLine, currentColumn);
 				i += 4;
 				currentColumn += 4;
@@ -448,8 +556,8 @@ ArgonLang::TokenizeResult ArgonLang::tokenize(const std::string& input) {
 			tokens.emplace_back(Token::MapPipe, "||>", currentLine, currentColumn);
 			i += 3;
 			currentColumn += 3;
-		} else if (c == '|' && input[i + 1] == '>') {
-			if (input[i + 2] == '=') {
+		} else if (c == '|' && peek(1) == '>') {
+			if (peek(2) == '=') {
 				tokens.emplace_back(Token::PipeAssign, "|>=", currentLine, currentColumn);
 				i += 3;
 				currentColumn += 3;
@@ -458,24 +566,24 @@ ArgonLang::TokenizeResult ArgonLang::tokenize(const std::string& input) {
 			tokens.emplace_back(Token::Pipe, "|>", currentLine, currentColumn);
 			i += 2;
 			currentColumn += 2;
-		} else if (c == '=' && input[i + 1] == '>') {
+		} else if (c == '=' && peek(1) == '>') {
 			tokens.emplace_back(Token::MatchArrow, "=>", currentLine, currentColumn);
 			i += 2;
 			currentColumn += 2;
-		} else if (c == '-' && input[i + 1] == '>') {
+		} else if (c == '-' && peek(1) == '>') {
 			tokens.emplace_back(Token::Arrow, "->", currentLine, currentColumn);
 			i += 2;
 			currentColumn += 2;
-		} else if (c == ':' && input[i + 1] == ':') {
+		} else if (c == ':' && peek(1) == ':') {
 			tokens.emplace_back(Token::DoubleColon, "::", currentLine, currentColumn);
 			i += 2;
 			currentColumn += 2;
-		} else if (c == '#' && input[i + 1] == '#') {
+		} else if (c == '#' && peek(1) == '#') {
 			tokens.emplace_back(Token::DoubleHash, "##", currentLine, currentColumn);
 			i += 2;
 			currentColumn += 2;
-		} else if (c == '*' && input[i + 1] == '&') {
-			if (input[i + 2] == '=') {
+		} else if (c == '*' && peek(1) == '&') {
+			if (peek(2) == '=') {
 				tokens.emplace_back(Token::BitwiseAndAssign, "*&=", currentLine, currentColumn);
 				i += 3;
 				currentColumn += 3;
@@ -484,8 +592,8 @@ ArgonLang::TokenizeResult ArgonLang::tokenize(const std::string& input) {
 			tokens.emplace_back(Token::BitwiseAnd, "*&", currentLine, currentColumn);
 			i += 2;
 			currentColumn += 2;
-		} else if (c == '*' && input[i + 1] == '|') {
-			if (input[i + 2] == '=') {
+		} else if (c == '*' && peek(1) == '|') {
+			if (peek(2) == '=') {
 				tokens.emplace_back(Token::BitwiseOrAssign, "*|=", currentLine, currentColumn);
 				i += 3;
 				currentColumn += 3;
@@ -494,8 +602,8 @@ ArgonLang::TokenizeResult ArgonLang::tokenize(const std::string& input) {
 			tokens.emplace_back(Token::BitwiseOr, "*|", currentLine, currentColumn);
 			i += 2;
 			currentColumn += 2;
-		} else if (c == '*' && input[i + 1] == '^') {
-			if (input[i + 2] == '=') {
+		} else if (c == '*' && peek(1) == '^') {
+			if (peek(2) == '=') {
 				tokens.emplace_back(Token::BitwiseXorAssign, "*^=", currentLine, currentColumn);
 				i += 3;
 				currentColumn += 3;
@@ -504,7 +612,7 @@ ArgonLang::TokenizeResult ArgonLang::tokenize(const std::string& input) {
 			tokens.emplace_back(Token::BitwiseXor, "*^", currentLine, currentColumn);
 			i += 2;
 			currentColumn += 2;
-		} else if (c == '*' && input[i + 1] == '~') {
+		} else if (c == '*' && peek(1) == '~') {
 			tokens.emplace_back(Token::BitwiseNot, "*~", currentLine, currentColumn);
 			i += 2;
 			currentColumn += 2;
@@ -575,7 +683,7 @@ ArgonLang::TokenizeResult ArgonLang::tokenize(const std::string& input) {
 				break;
 			case '.':
 				// Check for ellipsis (...)
-				if (i + 2 < input.size() && input[i + 1] == '.' && input[i + 2] == '.') {
+				if (i + 2 < input.size() && peek(1) == '.' && peek(2) == '.') {
 					tokens.emplace_back(Token::Ellipsis, "...", currentLine, currentColumn);
 					i += 2; // Skip the next two dots
 					currentColumn += 2;
@@ -593,17 +701,34 @@ ArgonLang::TokenizeResult ArgonLang::tokenize(const std::string& input) {
 				tokens.emplace_back(Token::Dollar, "$", currentLine, currentColumn);
 				break;
 			default:
-				return TokenizeResult(ErrorFormatter::formatTokenizerError("Unexpected character: " + std::string(1, c),
-				                                                           currentLine, currentColumn),
-				                      {currentLine, currentColumn});
+				return fail(ErrorFormatter::formatTokenizerError("Unexpected character: " + std::string(1, c),
+				                                                 currentLine, currentColumn),
+				            {currentLine, currentColumn});
 			}
 			i++;
 			currentColumn++;
 		}
 	}
 
-	tokens.emplace_back(Token::End, "END", currentLine, currentColumn);
-	return TokenizeResult(std::move(tokens));
+	position = i;
+	line = currentLine;
+	column = currentColumn;
+	if (i >= length) {
+		tokens.emplace_back(Token::End, "END", currentLine, currentColumn);
+		finished = true;
+	}
+	return true;
+}
+
+ArgonLang::TokenizeResult ArgonLang::tokenize(std::string_view input) {
+	Lexer lexer(input);
+	std::vector<Token> tokens;
+	// Typical sources average a token every four to eight bytes; reserving avoids regrowing a large vector
+	tokens.reserve(input.size() / 6 + 16);
+	if (!lexer.lex(tokens, std::numeric_limits<size_t>::max())) {
+		return TokenizeResult(lexer.get_error_message(), lexer.get_error_position());
+	}
+	return TokenizeResult(std::move(tokens), lexer.take_owned_values());
 }
 
 std::string ArgonLang::Token::getTypeAsString(Token::Type type) {
@@ -835,5 +960,5 @@ std::string ArgonLang::Token::getTypeAsString(Token::Type type) {
 	return "";
 }
 
-ArgonLang::Token::Token(Type t, std::string val, size_t line, size_t column)
-    : type(t), value(std::move(val)), position({line, column}) {}
\ No newline at end of file
+ArgonLang::Token::Token(Type t, std::string_view val, size_t line, size_t column)
+    : type(t), position(line, column), value(val) {}
\ No newline at end of file
@@ -14,11 +14,11 @@ using namespace ArgonLang;
 Result<bool> AnalysisVisitor::visit(const ASTNode& node) {
 	switch (node.get_node_group()) {
 	case ASTNodeGroup::Expression:
-		return visit(dynamic_cast<const ExpressionNode&>(node));
+		return visit(node_cast<ExpressionNode>(node));
 	case ASTNodeGroup::Statement:
-		return visit(dynamic_cast<const StatementNode&>(node));
+		return visit(node_cast<StatementNode>(node));
 	case ASTNodeGroup::Type:
-		return visit(dynamic_cast<const TypeNode&>(node));
+		return visit(node_cast<TypeNode>(node));
 	}
 	return false; // Default case
 }
@@ -26,47 +26,47 @@ Result<bool> AnalysisVisitor::visit(const ASTNode& node) {
 Result<bool> AnalysisVisitor::visit(const ExpressionNode& node) {
 	switch (node.get_node_type()) {
 	case ASTNodeType::IntegralLiteral:
-		return visit(dynamic_cast<const IntegralLiteralNode&>(node));
+		return visit(node_cast<IntegralLiteralNode>(node));
 	case ASTNodeType::FloatLiteral:
-		return visit(dynamic_cast<const FloatLiteralNode&>(node));
+		return visit(node_cast<FloatLiteralNode>(node));
 	case ASTNodeType::StringLiteral:
-		return visit(dynamic_cast<const StringLiteralNode&>(node));
+		return visit(node_cast<StringLiteralNode>(node));
 	case ASTNodeType::CharLiteral:
-		return visit(dynamic_cast<const CharLiteralNode&>(node));
+		return visit(node_cast<CharLiteralNode>(node));
 	case ASTNodeType::BooleanLiteral:
-		return visit(dynamic_cast<const BooleanLiteralNode&>(node));
+		return visit(node_cast<BooleanLiteralNode>(node));
 	case ASTNodeType::Identifier:
-		return visit(dynamic_cast<const IdentifierNode&>(node));
+		return visit(node_cast<IdentifierNode>(node));
 	case ASTNodeType::BinaryExpression:
-		return visit(dynamic_cast<const BinaryExpressionNode&>(node));
+		return visit(node_cast<BinaryExpressionNode>(node));
 	case ASTNodeType::UnaryExpression:
-		return visit(dynamic_cast<const UnaryExpressionNode&>(node));
+		return visit(node_cast<UnaryExpressionNode>(node));
 	case ASTNodeType::UnaryPostExpression:
-		return visit(dynamic_cast<const UnaryPostExpressionNode&>(node));
+		return visit(node_cast<UnaryPostExpressionNode>(node));
 	case ASTNodeType::FunctionCallExpression:
-		return visit(dynamic_cast<const FunctionCallExpressionNode&>(node));
+		return visit(node_cast<FunctionCallExpressionNode>(node));
 	case ASTNodeType::MemberAccessExpression:
-		return visit(dynamic_cast<const MemberAccessExpressionNode&>(node));
+		return visit(node_cast<MemberAccessExpressionNode>(node));
 	case ASTNodeType::ToExpression:
-		return visit(dynamic_cast<const ToExpressionNode&>(node));
+		return visit(node_cast<ToExpressionNode>(node));
 	case ASTNodeType::LambdaExpression:
-		return visit(dynamic_cast<const LambdaExpressionNode&>(node));
+		return visit(node_cast<LambdaExpressionNode>(node));
 	case ASTNodeType::ComparisonExpression:
-		return visit(dynamic_cast<const ComparisonExpressionNode&>(node));
+		return visit(node_cast<ComparisonExpressionNode>(node));
 	case ASTNodeType::AssignmentExpression:
-		return visit(dynamic_cast<const AssignmentExpressionNode&>(node));
+		return visit(node_cast<AssignmentExpressionNode>(node));
 	case ASTNodeType::IndexExpression:
-		return visit(dynamic_cast<const IndexExpressionNode&>(node));
+		return visit(node_cast<IndexExpressionNode>(node));
 	case ASTNodeType::MatchExpression:
-		return visit(dynamic_cast<const MatchExpressionNode&>(node));
+		return visit(node_cast<MatchExpressionNode>(node));
 	case ASTNodeType::TernaryExpression:
-		return visit(dynamic_cast<const TernaryExpressionNode&>(node));
+		return visit(node_cast<TernaryExpressionNode>(node));
 	case ASTNodeType::ParallelExpression:
-		return visit(dynamic_cast<const ParallelExpressionNode&>(node));
+		return visit(node_cast<ParallelExpressionNode>(node));
 	case ASTNodeType::StructExpression:
-		return visit(dynamic_cast<const StructExpressionNode&>(node));
+		return visit(node_cast<StructExpressionNode>(node));
 	case ASTNodeType::RangeExpression:
-		return visit(dynamic_cast<const RangeExpressionNode&>(node));
+		return visit(node_cast<RangeExpressionNode>(node));
 	default:
 		return Err<bool>(
 		    create_parse_error(ErrorType::UnexpectedToken, "Unexpected Expression", Token::Position{0, 0}));
@@ -76,45 +76,45 @@ Result<bool> AnalysisVisitor::visit(const ExpressionNode& node) {
 Result<bool> AnalysisVisitor::visit(const StatementNode& node) {
 	switch (node.get_node_type()) {
 	case ASTNodeType::ReturnStatement:
-		return visit(dynamic_cast<const ReturnStatementNode&>(node));
+		return visit(node_cast<ReturnStatementNode>(node));
 	case ASTNodeType::VariableDeclaration:
-		return visit(dynamic_cast<const VariableDeclarationNode&>(node));
+		return visit(node_cast<VariableDeclarationNode>(node));
 	case ASTNodeType::IfStatement:
-		return visit(dynamic_cast<const IfStatementNode&>(node));
+		return visit(node_cast<IfStatementNode>(node));
 	case ASTNodeType::ForStatement:
-		return visit(dynamic_cast<const ForStatementNode&>(node));
+		return visit(node_cast<ForStatementNode>(node));
 	case ASTNodeType::UnionDeclaration:
-		return visit(dynamic_cast<const UnionDeclarationNode&>(node));
+		return visit(node_cast<UnionDeclarationNode>(node));
 	case ASTNodeType::YieldStatement:
-		return visit(dynamic_cast<const YieldStatementNode&>(node));
+		return visit(node_cast<YieldStatementNode>(node));
 	case ASTNodeType::WhileStatement:
-		return visit(dynamic_cast<const WhileStatementNode&>(node));
+		return visit(node_cast<WhileStatementNode>(node));
 	case ASTNodeType::BreakStatement:
-		return visit(dynamic_cast<const BreakStatementNode&>(node));
+		return visit(node_cast<BreakStatementNode>(node));
 	case ASTNodeType::ContinueStatement:
-		return visit(dynamic_cast<const ContinueStatementNode&>(node));
+		return visit(node_cast<ContinueStatementNode>(node));
 	case ASTNodeType::Block:
-		return visit(dynamic_cast<const BlockNode&>(node));
+		return visit(node_cast<BlockNode>(node));
 	case ASTNodeType::TypeAlias:
-		return visit(dynamic_cast<const TypeAliasNode&>(node));
+		return visit(node_cast<TypeAliasNode>(node));
 	case ASTNodeType::ClassDeclaration:
-		return visit(dynamic_cast<const ClassDeclarationNode&>(node));
+		return visit(node_cast<ClassDeclarationNode>(node));
 	case ASTNodeType::FunctionDeclaration:
-		return visit(dynamic_cast<const FunctionDeclarationNode&>(node));
+		return visit(node_cast<FunctionDeclarationNode>(node));
 	case ASTNodeType::FunctionDefinition:
-		return visit(dynamic_cast<const FunctionDefinitionNode&>(node));
+		return visit(node_cast<FunctionDefinitionNode>(node));
 	case ASTNodeType::ConstructorStatement:
-		return visit(dynamic_cast<const ConstructorStatementNode&>(node));
+		return visit(node_cast<ConstructorStatementNode>(node));
 	case ASTNodeType::ImplStatement:
-		return visit(dynamic_cast<const ImplStatementNode&>(node));
+		return visit(node_cast<ImplStatementNode>(node));
 	case ASTNodeType::EnumDeclaration:
-		return visit(dynamic_cast<const EnumDeclarationNode&>(node));
+		return visit(node_cast<EnumDeclarationNode>(node));
 	case ASTNodeType::ConstraintDeclaration:
-		return visit(dynamic_cast<const ConstraintDeclarationNode&>(node));
+		return visit(node_cast<ConstraintDeclarationNode>(node));
 	case ASTNodeType::ModuleDeclaration:
-		return visit(dynamic_cast<const ModuleDeclarationNode&>(node));
+		return visit(node_cast<ModuleDeclarationNode>(node));
 	case ASTNodeType::ImportStatement:
-		return visit(dynamic_cast<const ImportStatementNode&>(node));
+		return visit(node_cast<ImportStatementNode>(node));
 	default:
 		return Err<bool>(create_parse_error(ErrorType::UnexpectedToken, "Unexpected Statement", Token::Position{0, 0}));
 	}
@@ -123,15 +123,15 @@ Result<bool> AnalysisVisitor::visit(const StatementNode& node) {
 Result<bool> AnalysisVisitor::visit(const TypeNode& node) {
 	switch (node.get_node_type()) {
 	case ASTNodeType::IntersectionType:
-		return visit(dynamic_cast<const IntersectionTypeNode&>(node));
+		return visit(node_cast<IntersectionTypeNode>(node));
 	case ASTNodeType::PrefixedType:
-		return visit(dynamic_cast<const PrefixedTypeNode&>(node));
+		return visit(node_cast<PrefixedTypeNode>(node));
 	case ASTNodeType::GenericType:
-		return visit(dynamic_cast<const GenericTypeNode&>(node));
+		return visit(node_cast<GenericTypeNode>(node));
 	case ASTNodeType::SumType:
-		return visit(dynamic_cast<const SumTypeNode&>(node));
+		return visit(node_cast<SumTypeNode>(node));
 	case ASTNodeType::IdentifierType:
-		return visit(dynamic_cast<const IdentifierTypeNode&>(node));
+		return visit(node_cast<IdentifierTypeNode>(node));
 	default:
 		return Err<bool>(create_parse_error(ErrorType::UnexpectedToken, "Unexpected Type", Token::Position{0, 0}));
 	}
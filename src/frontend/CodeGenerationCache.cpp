@@ -0,0 +1,71 @@
+#include "frontend/CodeGenerationCache.h"
+
+#include <cstdio>
+#include <fstream>
+#include <utility>
+
+namespace {
+// File layout: a header line, then per entry a "<key> <size>" line followed by size bytes of code and a newline
+constexpr const char* MAGIC = "ARGONCACHE";
+} // namespace
+
+ArgonLang::CodeGenerationCache ArgonLang::CodeGenerationCache::load(const std::string& path) {
+	CodeGenerationCache cache;
+	std::ifstream file(path, std::ios::binary);
+	std::string magic;
+	uint32_t version = 0;
+	if (!(file >> magic >> version) || magic != MAGIC || version != FORMAT_VERSION || file.get() != '\n') {
+		return cache;
+	}
+
+	uint64_t key;
+	std::size_t size;
+	while (file >> std::hex >> key >> std::dec >> size && file.get() == '\n') {
+		std::string code(size, '\0');
+		if (!file.read(code.data(), static_cast<std::streamsize>(size)) || file.get() != '\n') {
+			// Truncated file: nothing in it can be trusted
+			cache.previous.clear();
+			return cache;
+		}
+		cache.previous.emplace(key, std::move(code));
+	}
+	return cache;
+}
+
+bool ArgonLang::CodeGenerationCache::save(const std::string& path) const {
+	std::string temporary = path + ".tmp";
+	{
+		std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+		file << MAGIC << ' ' << FORMAT_VERSION << '\n';
+		for (const auto& [key, code] : current) {
+			file << std::hex << key << std::dec << ' ' << code.size() << '\n';
+			file.write(code.data(), static_cast<std::streamsize>(code.size()));
+			file << '\n';
+		}
+		if (!file.flush()) {
+			std::remove(temporary.c_str());
+			return false;
+		}
+	}
+	return std::rename(temporary.c_str(), path.c_str()) == 0;
+}
+
+const std::string* ArgonLang::CodeGenerationCache::find(uint64_t key) {
+	if (auto kept = current.find(key); kept != current.end()) {
+		++hit_count;
+		return &kept->second;
+	}
+	auto cached = previous.find(key);
+	if (cached == previous.end()) {
+		++miss_count;
+		return nullptr;
+	}
+	++hit_count;
+	auto [kept, inserted] = current.emplace(key, std::move(cached->second));
+	previous.erase(cached);
+	return &kept->second;
+}
+
+void ArgonLang::CodeGenerationCache::store(uint64_t key, std::string code) {
+	current.insert_or_assign(key, std::move(code));
+}
@@ -7,21 +7,799 @@
 #include "Error/Error.h"
 #include "Error/ErrorFormatter.h"
 #include "Error/Result.h"
+#include "runtime/ArgonParallel.h"
 
 #include <iostream>
 #include <algorithm>
 #include <cctype>
+#include <charconv>
+#include <limits>
+#include <optional>
 
 using namespace ArgonLang;
 
+namespace {
+// Declarations a chunk of the parallel path generates with one visitor, at most
+constexpr std::size_t DECLARATIONS_PER_CHUNK = 16;
+
+// Widest range pattern of a switch-lowered match that is spelled out as case labels; wider ones are compared in
+// the default label
+constexpr uint64_t MAX_RANGE_CASES = 32;
+
+// Enums with a payload on some variant, or declared as enum union, are generated as tagged unions
+bool is_tagged_union(const EnumDeclarationNode& node) {
+	return node.isUnion || std::any_of(node.variants.begin(), node.variants.end(),
+	                                   [](const auto& variant) { return !variant.fields.empty(); });
+}
+
+// Runtime class a generic type lowers to when it is ref<T> or weak<T>; null for any other generic type
+const char* ref_class(const GenericTypeNode& node) {
+	const auto* base = node_cast<IdentifierTypeNode>(node.base.get());
+	if (base == nullptr || node.params.size() != 1) {
+		return nullptr;
+	}
+	if (base->typeName == "ref") {
+		return "ArgonLang::Runtime::Ref";
+	}
+	if (base->typeName == "weak") {
+		return "ArgonLang::Runtime::Weak";
+	}
+	return nullptr;
+}
+
+// Name of the variable a statement declares and initializes with ref(...), whose value no other ref points to yet;
+// null for any other statement
+const std::string* fresh_ref_name(const ASTNode& statement) {
+	const auto* declaration = node_cast<VariableDeclarationNode>(&statement);
+	if (declaration == nullptr || declaration->pattern != nullptr || !declaration->compoundPatterns.empty()) {
+		return nullptr;
+	}
+	const auto* call = node_cast<FunctionCallExpressionNode>(declaration->value.get());
+	const auto* callee = call != nullptr ? node_cast<IdentifierNode>(call->function.get()) : nullptr;
+	if (callee == nullptr || callee->identifier != "ref") {
+		return nullptr;
+	}
+	if (declaration->type != nullptr) {
+		const auto* generic = node_cast<GenericTypeNode>(declaration->type.get());
+		const auto* base = generic != nullptr ? node_cast<IdentifierTypeNode>(generic->base.get()) : nullptr;
+		if (base == nullptr || base->typeName != "ref") {
+			return nullptr;
+		}
+	}
+	return &declaration->name;
+}
+
+// Code for a value that can outlive its expression: a lazy pipeline (| and &) references its source and the locals
+// its stages capture, so where it would be bound with a deduced type it is materialised into a vector instead
+std::string materialized(const ASTNode& value, std::string code) {
+	const auto* binary = node_cast<BinaryExpressionNode>(&value);
+	if (binary != nullptr && (binary->op.value == "|" || binary->op.value == "&")) {
+		return "(" + code + ").to_vector()";
+	}
+	return code;
+}
+
+// Value of an integer or character literal, possibly negated; nullopt for any other expression
+std::optional<int64_t> constant_integer(const ExpressionNode& node) {
+	switch (node.get_node_type()) {
+	case ASTNodeType::CharLiteral:
+		return node_cast<CharLiteralNode>(node).value;
+	case ASTNodeType::IntegralLiteral: {
+		const std::string& digits = node_cast<IntegralLiteralNode>(node).value;
+		const char* begin = digits.data();
+		int base = 10;
+		if (digits.size() > 2 && digits[0] == '0' && std::isalpha(static_cast<unsigned char>(digits[1]))) {
+			base = std::tolower(static_cast<unsigned char>(digits[1])) == 'x'   ? 16
+			       : std::tolower(static_cast<unsigned char>(digits[1])) == 'b' ? 2
+			                                                                    : 8;
+			begin += 2;
+		}
+		int64_t value = 0;
+		auto [end, error] = std::from_chars(begin, digits.data() + digits.size(), value, base);
+		if (error != std::errc() || end != digits.data() + digits.size()) {
+			return std::nullopt;
+		}
+		return value;
+	}
+	case ASTNodeType::UnaryExpression: {
+		const auto& unary = node_cast<UnaryExpressionNode>(node);
+		if (unary.op.value != "-") {
+			return std::nullopt;
+		}
+		std::optional<int64_t> operand = constant_integer(*unary.operand);
+		if (!operand || *operand == std::numeric_limits<int64_t>::min()) {
+			return std::nullopt;
+		}
+		return -*operand;
+	}
+	default:
+		return std::nullopt;
+	}
+}
+
+// An arm of a match lowered to a switch: the values low to high inclusive, an enumerator, or anything
+struct SwitchArm {
+	enum class Kind { Values, Enumerator, Default } kind = Kind::Default;
+	int64_t low = 0;
+	int64_t high = 0;
+	// Literal of a single-value arm, spelled as generated elsewhere
+	const ExpressionNode* literal = nullptr;
+	std::string enumerator;
+	// Name an identifier pattern binds the value to
+	std::string binding;
+};
+
+std::optional<SwitchArm> switch_arm_bounds(const ExpressionNode& start, const ExpressionNode& end, bool inclusive) {
+	std::optional<int64_t> low = constant_integer(start);
+	std::optional<int64_t> high = constant_integer(end);
+	if (!low || !high || (!inclusive && *high == std::numeric_limits<int64_t>::min())) {
+		return std::nullopt;
+	}
+	SwitchArm arm;
+	arm.kind = SwitchArm::Kind::Values;
+	arm.low = *low;
+	arm.high = inclusive ? *high : *high - 1;
+	return arm;
+}
+
+// What a pattern tests when it is a switch label, or nullopt when a switch cannot test it
+std::optional<SwitchArm> switch_pattern(const PatternNode& pattern, const MatchEnums& enums) {
+	switch (pattern.get_node_type()) {
+	case ASTNodeType::WildcardPattern:
+		return SwitchArm();
+	case ASTNodeType::IdentifierPattern: {
+		SwitchArm arm;
+		arm.binding = node_cast<IdentifierPatternNode>(pattern).name;
+		return arm;
+	}
+	case ASTNodeType::LiteralPattern: {
+		const ExpressionNode& literal = *node_cast<LiteralPatternNode>(pattern).literal;
+		std::optional<int64_t> value = constant_integer(literal);
+		if (!value) {
+			return std::nullopt;
+		}
+		SwitchArm arm;
+		arm.kind = SwitchArm::Kind::Values;
+		arm.low = arm.high = *value;
+		arm.literal = &literal;
+		return arm;
+	}
+	case ASTNodeType::RangePattern: {
+		const auto& range = node_cast<RangePatternNode>(pattern);
+		return switch_arm_bounds(*range.start, *range.end, range.isInclusive);
+	}
+	case ASTNodeType::ConstructorPattern: {
+		const auto& constructor = node_cast<ConstructorPatternNode>(pattern);
+		std::size_t separator = constructor.constructorName.rfind("::");
+		if (!constructor.arguments.empty() || separator == std::string::npos ||
+		    !enums.simple.contains(constructor.constructorName.substr(0, separator))) {
+			return std::nullopt;
+		}
+		SwitchArm arm;
+		arm.kind = SwitchArm::Kind::Enumerator;
+		arm.enumerator = constructor.constructorName;
+		return arm;
+	}
+	default:
+		return std::nullopt;
+	}
+}
+
+// The arm a branch becomes in a switch, or nullopt when it has a guard or a pattern the switch cannot test
+std::optional<SwitchArm> switch_arm(const MatchBranch& branch, const MatchEnums& enums) {
+	if (branch.condition || !branch.pattern) {
+		return std::nullopt;
+	}
+	return switch_pattern(*branch.pattern, enums);
+}
+
+// An integer constant as C++ source; the lowest int64_t has no literal of its own, as its negation overflows
+std::string integer_constant(int64_t value) {
+	if (value == std::numeric_limits<int64_t>::min()) {
+		return "(" + std::to_string(value + 1) + " - 1)";
+	}
+	return std::to_string(value);
+}
+
+// Tests occurrence against constant inclusive bounds; the runtime folds the range to a single unsigned comparison
+std::string constant_range_test(const std::string& occurrence, int64_t low, int64_t high) {
+	if (high < low) {
+		return "false";
+	}
+	if (low == high) {
+		return "(" + occurrence + " == " + integer_constant(low) + ")";
+	}
+	return "ArgonLang::Runtime::match_constant_range<" + integer_constant(low) + ", " + integer_constant(high) + ">(" +
+	       occurrence + ")";
+}
+
+// Tests occurrence against a range pattern, comparing inline against bounds that are not constants
+Result<std::string> range_test(CodeGenerationVisitor& visitor, const RangePatternNode& range,
+                               const std::string& occurrence) {
+	if (std::optional<SwitchArm> bounds = switch_arm_bounds(*range.start, *range.end, range.isInclusive)) {
+		return Ok(constant_range_test(occurrence, bounds->low, bounds->high));
+	}
+	auto start = visitor.visit(*range.start);
+	if (!start.has_value()) {
+		return Err<std::string>(start.error());
+	}
+	auto end = visitor.visit(*range.end);
+	if (!end.has_value()) {
+		return Err<std::string>(end.error());
+	}
+	return Ok("(" + occurrence + " >= " + start.value() + " && " + occurrence + (range.isInclusive ? " <= " : " < ") +
+	          end.value() + ")");
+}
+
+// A row of the clause matrix a structural match is compiled from: a pattern per column, null standing for a
+// wildcard, the names bound by the parts of the value already taken apart, and the arm the row selects
+struct MatchRow {
+	std::vector<const PatternNode*> patterns;
+	std::vector<std::pair<std::string, std::string>> bindings;
+	std::size_t arm = 0;
+};
+
+// Generated guard and body of a match arm; the body leaves the match
+struct MatchArmCode {
+	std::string guard;
+	std::string body;
+};
+
+bool is_irrefutable(const PatternNode* pattern) {
+	return pattern == nullptr || pattern->get_node_type() == ASTNodeType::WildcardPattern ||
+	       pattern->get_node_type() == ASTNodeType::IdentifierPattern;
+}
+
+// Binds the value at occurrence when pattern names it
+void bind_name(MatchRow& row, const PatternNode* pattern, const std::string& occurrence) {
+	if (pattern != nullptr && pattern->get_node_type() == ASTNodeType::IdentifierPattern) {
+		row.bindings.emplace_back(node_cast<IdentifierPatternNode>(*pattern).name, occurrence);
+	}
+}
+
+// Replaces the pattern in column by one per part, or drops it when there are none
+void expand_row(MatchRow& row, std::size_t column, const std::vector<const PatternNode*>& parts) {
+	row.patterns.erase(row.patterns.begin() + static_cast<std::ptrdiff_t>(column));
+	row.patterns.insert(row.patterns.begin() + static_cast<std::ptrdiff_t>(column), parts.begin(), parts.end());
+}
+
+std::vector<std::string> expand_columns(const std::vector<std::string>& columns, std::size_t column,
+                                        const std::vector<std::string>& parts) {
+	std::vector<std::string> expanded(columns.begin(), columns.begin() + static_cast<std::ptrdiff_t>(column));
+	expanded.insert(expanded.end(), parts.begin(), parts.end());
+	expanded.insert(expanded.end(), columns.begin() + static_cast<std::ptrdiff_t>(column) + 1, columns.end());
+	return expanded;
+}
+
+// How a refutable pattern tests the value in its column; the rows testing a column the same way are dispatched
+// together
+enum class ColumnTest { Length, Fields, Variant, Switch, Equality, Range };
+
+std::optional<ColumnTest> column_test(const PatternNode& pattern, const MatchEnums& enums) {
+	switch (pattern.get_node_type()) {
+	case ASTNodeType::ArrayPattern:
+		return ColumnTest::Length;
+	case ASTNodeType::StructPattern:
+		return ColumnTest::Fields;
+	case ASTNodeType::ConstructorPattern:
+		if (enums.tagged.contains(node_cast<ConstructorPatternNode>(pattern).constructorName)) {
+			return ColumnTest::Variant;
+		}
+		break;
+	default:
+		break;
+	}
+	if (std::optional<SwitchArm> arm = switch_pattern(pattern, enums)) {
+		if (arm->kind == SwitchArm::Kind::Values &&
+		    static_cast<uint64_t>(arm->high) - static_cast<uint64_t>(arm->low) >= MAX_RANGE_CASES) {
+			return ColumnTest::Range;
+		}
+		return ColumnTest::Switch;
+	}
+	if (pattern.get_node_type() == ASTNodeType::RangePattern) {
+		return ColumnTest::Range;
+	}
+	if (pattern.get_node_type() == ASTNodeType::LiteralPattern) {
+		return ColumnTest::Equality;
+	}
+	return std::nullopt;
+}
+
+// Whether the decision tree can test pattern; structured is set when it takes an array, struct or tagged union
+// apart
+bool is_tree_pattern(const PatternNode& pattern, const MatchEnums& enums, bool& structured) {
+	if (is_irrefutable(&pattern)) {
+		return true;
+	}
+	if (pattern.get_node_type() == ASTNodeType::ArrayPattern) {
+		structured = true;
+		const auto& array = node_cast<ArrayPatternNode>(pattern);
+		return (array.rest == nullptr || is_irrefutable(array.rest.get())) &&
+		       std::all_of(array.elements.begin(), array.elements.end(), [&](const auto& element) {
+			       return is_tree_pattern(*element, enums, structured);
+		       });
+	}
+	if (pattern.get_node_type() == ASTNodeType::StructPattern) {
+		structured = true;
+		const auto& fields = node_cast<StructPatternNode>(pattern).fields;
+		return std::all_of(fields.begin(), fields.end(), [&](const auto& field) {
+			return is_tree_pattern(*field.second, enums, structured);
+		});
+	}
+	if (column_test(pattern, enums) == ColumnTest::Variant) {
+		structured = true;
+		const auto& constructor = node_cast<ConstructorPatternNode>(pattern);
+		return constructor.arguments.size() <= enums.tagged.at(constructor.constructorName).size() &&
+		       std::all_of(constructor.arguments.begin(), constructor.arguments.end(), [&](const auto& argument) {
+			       return is_tree_pattern(*argument, enums, structured);
+		       });
+	}
+	return column_test(pattern, enums).has_value();
+}
+
+// Compiles the clause matrix of a match into nested switches and ifs (Maranget, "Compiling pattern matching to good
+// decision trees"), so that each array length, field and constant is tested once however many arms look at it.
+// Rows a dispatch cannot share are tried after it: every arm body leaves the match, so falling out of a dispatch
+// means none of its rows matched
+class DecisionTree {
+public:
+	DecisionTree(CodeGenerationVisitor& visitor, const MatchEnums& enums, const std::vector<MatchArmCode>& arms)
+	    : visitor(visitor), enums(enums), arms(arms) {}
+
+	// Appends code running the arm of the first row that matches the values at columns
+	Result<void> emit(std::vector<MatchRow> rows, const std::vector<std::string>& columns, std::string& out) {
+		while (!rows.empty()) {
+			MatchRow& first = rows.front();
+			auto refutable = std::find_if_not(first.patterns.begin(), first.patterns.end(), is_irrefutable);
+			if (refutable == first.patterns.end()) {
+				for (std::size_t column = 0; column < columns.size(); ++column) {
+					bind_name(first, first.patterns[column], columns[column]);
+				}
+				out += "{";
+				for (const auto& [name, occurrence] : first.bindings) {
+					out += "auto " + name + " = " + occurrence + ";";
+				}
+				const MatchArmCode& arm = arms[first.arm];
+				if (arm.guard.empty()) {
+					// Every later row is unreachable
+					out += arm.body + "}";
+					return Ok();
+				}
+				out += "if(" + arm.guard + ") {" + arm.body + "}}";
+				rows.erase(rows.begin());
+				continue;
+			}
+
+			// The rows up to the first one that tests this column differently share its dispatch
+			std::size_t column = static_cast<std::size_t>(refutable - first.patterns.begin());
+			ColumnTest test = *column_test(**refutable, enums);
+			std::size_t end = 1;
+			while (test != ColumnTest::Range && end < rows.size() &&
+			       (is_irrefutable(rows[end].patterns[column]) ||
+			        column_test(*rows[end].patterns[column], enums) == test)) {
+				++end;
+			}
+			std::vector<MatchRow> group(std::make_move_iterator(rows.begin()),
+			                            std::make_move_iterator(rows.begin() + static_cast<std::ptrdiff_t>(end)));
+			rows.erase(rows.begin(), rows.begin() + static_cast<std::ptrdiff_t>(end));
+
+			bool exhaustive = std::any_of(group.begin(), group.end(), [this](const MatchRow& row) {
+				return arms[row.arm].guard.empty() &&
+				       std::all_of(row.patterns.begin(), row.patterns.end(), is_irrefutable);
+			});
+			Result<void> result = Ok();
+			switch (test) {
+			case ColumnTest::Length:
+				result = emit_lengths(std::move(group), columns, column, out);
+				break;
+			case ColumnTest::Fields:
+				result = emit_fields(std::move(group), columns, column, out);
+				break;
+			case ColumnTest::Variant:
+				result = emit_variants(std::move(group), columns, column, out);
+				break;
+			case ColumnTest::Switch:
+				result = emit_switch(std::move(group), columns, column, out);
+				break;
+			case ColumnTest::Equality:
+				result = emit_equality(std::move(group), columns, column, out);
+				break;
+			case ColumnTest::Range:
+				result = emit_range(std::move(group), columns, column, out);
+				break;
+			}
+			if (!result.has_value() || exhaustive) {
+				return result;
+			}
+		}
+		return Ok();
+	}
+
+private:
+	CodeGenerationVisitor& visitor;
+	const MatchEnums& enums;
+	const std::vector<MatchArmCode>& arms;
+
+	// Rows whose pattern in column accepts the value, given which refutable patterns do, with the column dropped
+	static std::vector<MatchRow> select(const std::vector<MatchRow>& group, const std::vector<bool>& accepts,
+	                                    std::size_t column, const std::string& occurrence) {
+		std::vector<MatchRow> rows;
+		for (std::size_t index = 0; index < group.size(); ++index) {
+			const PatternNode* pattern = group[index].patterns[column];
+			if (!is_irrefutable(pattern) && !accepts[index]) {
+				continue;
+			}
+			MatchRow row = group[index];
+			bind_name(row, pattern, occurrence);
+			expand_row(row, column, {});
+			rows.push_back(std::move(row));
+		}
+		return rows;
+	}
+
+	// Arrays are dispatched on their length: a switch over the lengths some row requires exactly, then for other
+	// lengths the rows with a rest element, from the longest prefix down
+	Result<void> emit_lengths(std::vector<MatchRow> group, const std::vector<std::string>& columns,
+	                          std::size_t column, std::string& out) {
+		const std::string occurrence = columns[column];
+		std::vector<std::size_t> lengths;
+		std::vector<std::size_t> prefixes;
+		for (const MatchRow& row : group) {
+			if (const auto* array = node_cast<ArrayPatternNode>(row.patterns[column])) {
+				std::vector<std::size_t>& seen = array->rest ? prefixes : lengths;
+				if (std::find(seen.begin(), seen.end(), array->elements.size()) == seen.end()) {
+					seen.push_back(array->elements.size());
+				}
+			}
+		}
+		std::sort(prefixes.rbegin(), prefixes.rend());
+
+		// The rows for arrays of at least width elements, or exactly width when exact
+		auto emit_width = [&](std::size_t width, bool exact, std::string& code) {
+			std::vector<MatchRow> rows;
+			for (const MatchRow& row : group) {
+				const PatternNode* pattern = row.patterns[column];
+				MatchRow expanded = row;
+				std::vector<const PatternNode*> elements(width, nullptr);
+				if (is_irrefutable(pattern)) {
+					bind_name(expanded, pattern, occurrence);
+				} else {
+					const auto& array = node_cast<ArrayPatternNode>(*pattern);
+					std::size_t count = array.elements.size();
+					if (array.rest ? count > width : !exact || count != width) {
+						continue;
+					}
+					for (std::size_t index = 0; index < count; ++index) {
+						elements[index] = array.elements[index].get();
+					}
+					if (array.rest) {
+						bind_name(expanded, array.rest.get(),
+						     "std::vector(" + occurrence + ".begin() + " + std::to_string(count) + ", " +
+						         occurrence + ".end())");
+					}
+				}
+				expand_row(expanded, column, elements);
+				rows.push_back(std::move(expanded));
+			}
+			std::vector<std::string> parts;
+			for (std::size_t index = 0; index < width; ++index) {
+				parts.push_back(occurrence + "[" + std::to_string(index) + "]");
+			}
+			return emit(std::move(rows), expand_columns(columns, column, parts), code);
+		};
+
+		std::string others;
+		for (std::size_t prefix : prefixes) {
+			others += std::string(others.empty() ? "" : "else ") + "if(" + occurrence +
+			          ".size() >= " + std::to_string(prefix) + ") {";
+			if (auto result = emit_width(prefix, false, others); !result.has_value()) {
+				return result;
+			}
+			others += "}";
+		}
+		if (prefixes.empty() || prefixes.back() != 0) {
+			std::string shorter;
+			if (auto result = emit_width(0, false, shorter); !result.has_value()) {
+				return result;
+			}
+			others += shorter.empty() || prefixes.empty() ? shorter : "else {" + shorter + "}";
+		}
+
+		if (lengths.empty()) {
+			out += others;
+			return Ok();
+		}
+		out += "switch(" + occurrence + ".size()) {";
+		for (std::size_t length : lengths) {
+			out += "case " + std::to_string(length) + ": {";
+			if (auto result = emit_width(length, true, out); !result.has_value()) {
+				return result;
+			}
+			out += "} break;";
+		}
+		if (!others.empty()) {
+			out += "default: {" + others + "}";
+		}
+		out += "}";
+		return Ok();
+	}
+
+	// Structs need no test: their fields become columns of their own
+	Result<void> emit_fields(std::vector<MatchRow> group, const std::vector<std::string>& columns,
+	                         std::size_t column, std::string& out) {
+		const std::string occurrence = columns[column];
+		std::vector<std::string> fields;
+		for (const MatchRow& row : group) {
+			if (const auto* pattern = node_cast<StructPatternNode>(row.patterns[column])) {
+				for (const auto& field : pattern->fields) {
+					if (std::find(fields.begin(), fields.end(), field.first) == fields.end()) {
+						fields.push_back(field.first);
+					}
+				}
+			}
+		}
+
+		std::vector<MatchRow> rows;
+		for (MatchRow& row : group) {
+			std::vector<const PatternNode*> parts(fields.size(), nullptr);
+			if (const auto* pattern = node_cast<StructPatternNode>(row.patterns[column])) {
+				for (const auto& field : pattern->fields) {
+					auto index = std::find(fields.begin(), fields.end(), field.first) - fields.begin();
+					parts[static_cast<std::size_t>(index)] = field.second.get();
+				}
+			} else {
+				bind_name(row, row.patterns[column], occurrence);
+			}
+			expand_row(row, column, parts);
+			rows.push_back(std::move(row));
+		}
+		for (std::string& field : fields) {
+			field = occurrence + "." + field;
+		}
+		return emit(std::move(rows), expand_columns(columns, column, fields), out);
+	}
+
+	// Tagged unions are dispatched on their tag: a case per variant some row names, the fields of the variant
+	// becoming columns of their own
+	Result<void> emit_variants(std::vector<MatchRow> group, const std::vector<std::string>& columns,
+	                           std::size_t column, std::string& out) {
+		const std::string occurrence = columns[column];
+		std::vector<std::string> variants;
+		for (const MatchRow& row : group) {
+			if (const auto* constructor = node_cast<ConstructorPatternNode>(row.patterns[column])) {
+				if (std::find(variants.begin(), variants.end(), constructor->constructorName) == variants.end()) {
+					variants.push_back(constructor->constructorName);
+				}
+			}
+		}
+
+		std::string others;
+		if (auto result = emit(select(group, std::vector<bool>(group.size(), false), column, occurrence),
+		                       expand_columns(columns, column, {}), others);
+		    !result.has_value()) {
+			return result;
+		}
+		out += "switch(" + occurrence + ".tag()) {";
+		for (const std::string& variant : variants) {
+			const std::vector<std::string>& fields = enums.tagged.at(variant);
+			std::vector<MatchRow> rows;
+			for (const MatchRow& row : group) {
+				const PatternNode* pattern = row.patterns[column];
+				MatchRow expanded = row;
+				std::vector<const PatternNode*> parts(fields.size(), nullptr);
+				if (is_irrefutable(pattern)) {
+					bind_name(expanded, pattern, occurrence);
+				} else {
+					const auto& constructor = node_cast<ConstructorPatternNode>(*pattern);
+					if (constructor.constructorName != variant) {
+						continue;
+					}
+					for (std::size_t index = 0; index < constructor.arguments.size(); ++index) {
+						parts[index] = constructor.arguments[index].get();
+					}
+				}
+				expand_row(expanded, column, parts);
+				rows.push_back(std::move(expanded));
+			}
+
+			std::size_t separator = variant.rfind("::");
+			std::string name = variant.substr(separator + 2);
+			std::vector<std::string> occurrences;
+			for (const std::string& field : fields) {
+				occurrences.push_back(occurrence + ".as_" + name + "()." + field);
+			}
+			std::string code;
+			if (auto result = emit(std::move(rows), expand_columns(columns, column, occurrences), code);
+			    !result.has_value()) {
+				return result;
+			}
+			if (code != others) {
+				out += "case " + variant.substr(0, separator) + "::Tag::" + name + ": {" + code + "} break;";
+			}
+		}
+		if (!others.empty()) {
+			out += "default: {" + others + "}";
+		}
+		out += "}";
+		return Ok();
+	}
+
+	// Integer, character and enumerator constants: one switch, where values accepted by the same rows share a case
+	Result<void> emit_switch(std::vector<MatchRow> group, const std::vector<std::string>& columns,
+	                         std::size_t column, std::string& out) {
+		const std::string occurrence = columns[column];
+		std::vector<std::optional<SwitchArm>> heads;
+		for (const MatchRow& row : group) {
+			const PatternNode* pattern = row.patterns[column];
+			heads.push_back(is_irrefutable(pattern) ? std::nullopt : switch_pattern(*pattern, enums));
+		}
+		auto accepts = [](const SwitchArm& head, const SwitchArm& key) {
+			return head.kind == SwitchArm::Kind::Enumerator
+			           ? head.enumerator == key.enumerator
+			           : head.kind == SwitchArm::Kind::Values && head.low <= key.low && key.low <= head.high;
+		};
+
+		// Every value some row names, in order of first appearance, spelled as in that row when it is a literal
+		std::vector<std::pair<SwitchArm, std::string>> keys;
+		for (const auto& head : heads) {
+			if (!head) {
+				continue;
+			}
+			if (head->kind == SwitchArm::Kind::Enumerator) {
+				if (std::none_of(keys.begin(), keys.end(), [&](const auto& key) { return accepts(*head, key.first); })) {
+					keys.emplace_back(*head, head->enumerator);
+				}
+				continue;
+			}
+			if (head->high < head->low) {
+				continue;
+			}
+			for (int64_t v = head->low;; ++v) {
+				SwitchArm key;
+				key.kind = SwitchArm::Kind::Values;
+				key.low = key.high = v;
+				if (std::none_of(keys.begin(), keys.end(), [&](const auto& seen) { return seen.first.low == v; })) {
+					std::string label = std::to_string(v);
+					if (head->literal) {
+						auto literal = visitor.visit(*head->literal);
+						if (!literal.has_value()) {
+							return Err<void>(literal.error());
+						}
+						label = literal.value();
+					}
+					keys.emplace_back(key, label);
+				}
+				if (v == head->high) {
+					break;
+				}
+			}
+		}
+
+		// Cases in order of their first value
+		std::vector<std::vector<bool>> signatures;
+		std::vector<std::string> labels;
+		for (const auto& [key, label] : keys) {
+			std::vector<bool> signature;
+			for (const auto& head : heads) {
+				signature.push_back(head && accepts(*head, key));
+			}
+			auto existing = std::find(signatures.begin(), signatures.end(), signature);
+			if (existing == signatures.end()) {
+				signatures.push_back(std::move(signature));
+				labels.push_back("case " + label + ":");
+			} else {
+				labels[static_cast<std::size_t>(existing - signatures.begin())] += "case " + label + ":";
+			}
+		}
+
+		std::string others;
+		if (auto result = emit(select(group, std::vector<bool>(group.size(), false), column, occurrence),
+		                       expand_columns(columns, column, {}), others);
+		    !result.has_value()) {
+			return result;
+		}
+		out += "switch(" + occurrence + ") {";
+		for (std::size_t index = 0; index < signatures.size(); ++index) {
+			std::string code;
+			if (auto result = emit(select(group, signatures[index], column, occurrence),
+			                       expand_columns(columns, column, {}), code);
+			    !result.has_value()) {
+				return result;
+			}
+			// Values whose rows end up deciding the same as the default need no case
+			if (code != others) {
+				out += labels[index] + "{" + code + "} break;";
+			}
+		}
+		if (!others.empty()) {
+			out += "default: {" + others + "}";
+		}
+		out += "}";
+		return Ok();
+	}
+
+	// Other literals, such as strings, are compared one distinct literal at a time
+	Result<void> emit_equality(std::vector<MatchRow> group, const std::vector<std::string>& columns,
+	                           std::size_t column, std::string& out) {
+		const std::string occurrence = columns[column];
+		std::vector<std::string> literals;
+		for (const MatchRow& row : group) {
+			const PatternNode* pattern = row.patterns[column];
+			if (is_irrefutable(pattern)) {
+				literals.emplace_back();
+				continue;
+			}
+			auto literal = visitor.visit(*node_cast<LiteralPatternNode>(*pattern).literal);
+			if (!literal.has_value()) {
+				return Err<void>(literal.error());
+			}
+			literals.push_back(literal.value());
+		}
+
+		std::vector<std::string> compared;
+		for (const std::string& literal : literals) {
+			if (literal.empty() || std::find(compared.begin(), compared.end(), literal) != compared.end()) {
+				continue;
+			}
+			std::vector<bool> accepts;
+			for (const std::string& other : literals) {
+				accepts.push_back(other == literal);
+			}
+			out += std::string(compared.empty() ? "" : "else ") + "if(" + occurrence + " == " + literal + ") {";
+			if (auto result = emit(select(group, accepts, column, occurrence), expand_columns(columns, column, {}),
+			                       out);
+			    !result.has_value()) {
+				return result;
+			}
+			out += "}";
+			compared.push_back(literal);
+		}
+		std::string others;
+		if (auto result = emit(select(group, std::vector<bool>(group.size(), false), column, occurrence),
+		                       expand_columns(columns, column, {}), others);
+		    !result.has_value()) {
+			return result;
+		}
+		if (!others.empty()) {
+			out += "else {" + others + "}";
+		}
+		return Ok();
+	}
+
+	// A range too wide for case labels is a comparison of its own, for its row alone
+	Result<void> emit_range(std::vector<MatchRow> group, const std::vector<std::string>& columns,
+	                        std::size_t column, std::string& out) {
+		const std::string occurrence = columns[column];
+		const PatternNode& pattern = *group.front().patterns[column];
+		std::string test;
+		if (std::optional<SwitchArm> bounds = switch_pattern(pattern, enums)) {
+			test = constant_range_test(occurrence, bounds->low, bounds->high);
+		} else {
+			auto rangeTest = range_test(visitor, node_cast<RangePatternNode>(pattern), occurrence);
+			if (!rangeTest.has_value()) {
+				return Err<void>(rangeTest.error());
+			}
+			test = rangeTest.value();
+		}
+		out += "if(" + test + ") {";
+		if (auto result = emit(select(group, {true}, column, occurrence), expand_columns(columns, column, {}), out);
+		    !result.has_value()) {
+			return result;
+		}
+		out += "}";
+		return Ok();
+	}
+};
+} // namespace
+
 Result<std::string> CodeGenerationVisitor::visit(const ASTNode& node) {
 	switch (node.get_node_group()) {
 	case ASTNodeGroup::Expression:
-		return visit(dynamic_cast<const ExpressionNode&>(node));
+		return visit(node_cast<ExpressionNode>(node));
 	case ASTNodeGroup::Statement:
-		return visit(dynamic_cast<const StatementNode&>(node));
+		return visit(node_cast<StatementNode>(node));
 	case ASTNodeGroup::Type:
-		return visit(dynamic_cast<const TypeNode&>(node));
+		return visit(node_cast<TypeNode>(node));
 	}
 	return Err<std::string>(create_parse_error(ErrorType::InvalidCodeGeneration, "Unknown node group", node.position));
 }
@@ -29,69 +807,69 @@ Result<std::string> CodeGenerationVisitor::visit(const ASTNode& node) {
 Result<std::string> CodeGenerationVisitor::visit(const ExpressionNode& node) {
 	switch (node.get_node_type()) {
 	case ASTNodeType::IntegralLiteral:
-		return visit(dynamic_cast<const IntegralLiteralNode&>(node));
+		return visit(node_cast<IntegralLiteralNode>(node));
 	case ASTNodeType::FloatLiteral:
-		return visit(dynamic_cast<const FloatLiteralNode&>(node));
+		return visit(node_cast<FloatLiteralNode>(node));
 	case ASTNodeType::StringLiteral:
-		return visit(dynamic_cast<const StringLiteralNode&>(node));
+		return visit(node_cast<StringLiteralNode>(node));
 	case ASTNodeType::CharLiteral:
-		return visit(dynamic_cast<const CharLiteralNode&>(node));
+		return visit(node_cast<CharLiteralNode>(node));
 	case ASTNodeType::BooleanLiteral:
-		return visit(dynamic_cast<const BooleanLiteralNode&>(node));
+		return visit(node_cast<BooleanLiteralNode>(node));
 	case ASTNodeType::Identifier:
-		return visit(dynamic_cast<const IdentifierNode&>(node));
+		return visit(node_cast<IdentifierNode>(node));
 	case ASTNodeType::BinaryExpression:
-		return visit(dynamic_cast<const BinaryExpressionNode&>(node));
+		return visit(node_cast<BinaryExpressionNode>(node));
 	case ASTNodeType::UnaryExpression:
-		return visit(dynamic_cast<const UnaryExpressionNode&>(node));
+		return visit(node_cast<UnaryExpressionNode>(node));
 	case ASTNodeType::UnaryPostExpression:
-		return visit(dynamic_cast<const UnaryPostExpressionNode&>(node));
+		return visit(node_cast<UnaryPostExpressionNode>(node));
 	case ASTNodeType::FunctionCallExpression:
-		return visit(dynamic_cast<const FunctionCallExpressionNode&>(node));
+		return visit(node_cast<FunctionCallExpressionNode>(node));
 	case ASTNodeType::MemberAccessExpression:
-		return visit(dynamic_cast<const MemberAccessExpressionNode&>(node));
+		return visit(node_cast<MemberAccessExpressionNode>(node));
 	case ASTNodeType::ToExpression:
-		return visit(dynamic_cast<const ToExpressionNode&>(node));
+		return visit(node_cast<ToExpressionNode>(node));
 	case ASTNodeType::LambdaExpression:
-		return visit(dynamic_cast<const LambdaExpressionNode&>(node));
+		return visit(node_cast<LambdaExpressionNode>(node));
 	case ASTNodeType::ComparisonExpression:
-		return visit(dynamic_cast<const ComparisonExpressionNode&>(node));
+		return visit(node_cast<ComparisonExpressionNode>(node));
 	case ASTNodeType::AssignmentExpression:
-		return visit(dynamic_cast<const AssignmentExpressionNode&>(node));
+		return visit(node_cast<AssignmentExpressionNode>(node));
 	case ASTNodeType::IndexExpression:
-		return visit(dynamic_cast<const IndexExpressionNode&>(node));
+		return visit(node_cast<IndexExpressionNode>(node));
 	case ASTNodeType::SliceExpression:
-		return visit(dynamic_cast<const SliceExpressionNode&>(node));
+		return visit(node_cast<SliceExpressionNode>(node));
 	case ASTNodeType::MultipleIndexExpression:
-		return visit(dynamic_cast<const MultipleIndexExpressionNode&>(node));
+		return visit(node_cast<MultipleIndexExpressionNode>(node));
 	case ASTNodeType::MatchExpression:
-		return visit(dynamic_cast<const MatchExpressionNode&>(node));
+		return visit(node_cast<MatchExpressionNode>(node));
 	case ASTNodeType::TernaryExpression:
-		return visit(dynamic_cast<const TernaryExpressionNode&>(node));
+		return visit(node_cast<TernaryExpressionNode>(node));
 	case ASTNodeType::ParallelExpression:
-		return visit(dynamic_cast<const ParallelExpressionNode&>(node));
+		return visit(node_cast<ParallelExpressionNode>(node));
 	case ASTNodeType::StructExpression:
-		return visit(dynamic_cast<const StructExpressionNode&>(node));
+		return visit(node_cast<StructExpressionNode>(node));
 	case ASTNodeType::RangeExpression:
-		return visit(dynamic_cast<const RangeExpressionNode&>(node));
+		return visit(node_cast<RangeExpressionNode>(node));
 
 	// Pattern node cases
 	case ASTNodeType::WildcardPattern:
-		return visit(dynamic_cast<const WildcardPatternNode&>(node));
+		return visit(node_cast<WildcardPatternNode>(node));
 	case ASTNodeType::LiteralPattern:
-		return visit(dynamic_cast<const LiteralPatternNode&>(node));
+		return visit(node_cast<LiteralPatternNode>(node));
 	case ASTNodeType::IdentifierPattern:
-		return visit(dynamic_cast<const IdentifierPatternNode&>(node));
+		return visit(node_cast<IdentifierPatternNode>(node));
 	case ASTNodeType::ArrayPattern:
-		return visit(dynamic_cast<const ArrayPatternNode&>(node));
+		return visit(node_cast<ArrayPatternNode>(node));
 	case ASTNodeType::StructPattern:
-		return visit(dynamic_cast<const StructPatternNode&>(node));
+		return visit(node_cast<StructPatternNode>(node));
 	case ASTNodeType::ConstructorPattern:
-		return visit(dynamic_cast<const ConstructorPatternNode&>(node));
+		return visit(node_cast<ConstructorPatternNode>(node));
 	case ASTNodeType::TypePattern:
-		return visit(dynamic_cast<const TypePatternNode&>(node));
+		return visit(node_cast<TypePatternNode>(node));
 	case ASTNodeType::RangePattern:
-		return visit(dynamic_cast<const RangePatternNode&>(node));
+		return visit(node_cast<RangePatternNode>(node));
 
 	default:
 		return Err<std::string>(
@@ -102,45 +880,45 @@ Result<std::string> CodeGenerationVisitor::visit(const ExpressionNode& node) {
 Result<std::string> CodeGenerationVisitor::visit(const StatementNode& node) {
 	switch (node.get_node_type()) {
 	case ASTNodeType::ReturnStatement:
-		return visit(dynamic_cast<const ReturnStatementNode&>(node));
+		return visit(node_cast<ReturnStatementNode>(node));
 	case ASTNodeType::VariableDeclaration:
-		return visit(dynamic_cast<const VariableDeclarationNode&>(node));
+		return visit(node_cast<VariableDeclarationNode>(node));
 	case ASTNodeType::IfStatement:
-		return visit(dynamic_cast<const IfStatementNode&>(node));
+		return visit(node_cast<IfStatementNode>(node));
 	case ASTNodeType::ForStatement:
-		return visit(dynamic_cast<const ForStatementNode&>(node));
+		return visit(node_cast<ForStatementNode>(node));
 	case ASTNodeType::UnionDeclaration:
-		return visit(dynamic_cast<const UnionDeclarationNode&>(node));
+		return visit(node_cast<UnionDeclarationNode>(node));
 	case ASTNodeType::YieldStatement:
-		return visit(dynamic_cast<const YieldStatementNode&>(node));
+		return visit(node_cast<YieldStatementNode>(node));
 	case ASTNodeType::WhileStatement:
-		return visit(dynamic_cast<const WhileStatementNode&>(node));
+		return visit(node_cast<WhileStatementNode>(node));
 	case ASTNodeType::BreakStatement:
-		return visit(dynamic_cast<const BreakStatementNode&>(node));
+		return visit(node_cast<BreakStatementNode>(node));
 	case ASTNodeType::ContinueStatement:
-		return visit(dynamic_cast<const ContinueStatementNode&>(node));
+		return visit(node_cast<ContinueStatementNode>(node));
 	case ASTNodeType::Block:
-		return visit(dynamic_cast<const BlockNode&>(node));
+		return visit(node_cast<BlockNode>(node));
 	case ASTNodeType::TypeAlias:
-		return visit(dynamic_cast<const TypeAliasNode&>(node));
+		return visit(node_cast<TypeAliasNode>(node));
 	case ASTNodeType::ClassDeclaration:
-		return visit(dynamic_cast<const ClassDeclarationNode&>(node));
+		return visit(node_cast<ClassDeclarationNode>(node));
 	case ASTNodeType::FunctionDeclaration:
-		return visit(dynamic_cast<const FunctionDeclarationNode&>(node));
+		return visit(node_cast<FunctionDeclarationNode>(node));
 	case ASTNodeType::FunctionDefinition:
-		return visit(dynamic_cast<const FunctionDefinitionNode&>(node));
+		return visit(node_cast<FunctionDefinitionNode>(node));
 	case ASTNodeType::ConstructorStatement:
-		return visit(dynamic_cast<const ConstructorStatementNode&>(node));
+		return visit(node_cast<ConstructorStatementNode>(node));
 	case ASTNodeType::ImplStatement:
-		return visit(dynamic_cast<const ImplStatementNode&>(node));
+		return visit(node_cast<ImplStatementNode>(node));
 	case ASTNodeType::EnumDeclaration:
-		return visit(dynamic_cast<const EnumDeclarationNode&>(node));
+		return visit(node_cast<EnumDeclarationNode>(node));
 	case ASTNodeType::ConstraintDeclaration:
-		return visit(dynamic_cast<const ConstraintDeclarationNode&>(node));
+		return visit(node_cast<ConstraintDeclarationNode>(node));
 	case ASTNodeType::ModuleDeclaration:
-		return visit(dynamic_cast<const ModuleDeclarationNode&>(node));
+		return visit(node_cast<ModuleDeclarationNode>(node));
 	case ASTNodeType::ImportStatement:
-		return visit(dynamic_cast<const ImportStatementNode&>(node));
+		return visit(node_cast<ImportStatementNode>(node));
 	default:
 		return Err<std::string>(
 		    create_parse_error(ErrorType::InvalidCodeGeneration, "Unexpected statement type", node.position));
@@ -150,39 +928,224 @@ Result<std::string> CodeGenerationVisitor::visit(const StatementNode& node) {
 Result<std::string> CodeGenerationVisitor::visit(const TypeNode& node) {
 	switch (node.get_node_type()) {
 	case ASTNodeType::IntersectionType:
-		return visit(dynamic_cast<const IntersectionTypeNode&>(node));
+		return visit(node_cast<IntersectionTypeNode>(node));
 	case ASTNodeType::PrefixedType:
-		return visit(dynamic_cast<const PrefixedTypeNode&>(node));
+		return visit(node_cast<PrefixedTypeNode>(node));
 	case ASTNodeType::GenericType:
-		return visit(dynamic_cast<const GenericTypeNode&>(node));
+		return visit(node_cast<GenericTypeNode>(node));
 	case ASTNodeType::SumType:
-		return visit(dynamic_cast<const SumTypeNode&>(node));
+		return visit(node_cast<SumTypeNode>(node));
 	case ASTNodeType::IdentifierType:
-		return visit(dynamic_cast<const IdentifierTypeNode&>(node));
+		return visit(node_cast<IdentifierTypeNode>(node));
 	case ASTNodeType::FunctionType:
-		return visit(dynamic_cast<const FunctionTypeNode&>(node));
+		return visit(node_cast<FunctionTypeNode>(node));
 	case ASTNodeType::ArrayType:
-		return visit(dynamic_cast<const ArrayTypeNode&>(node));
+		return visit(node_cast<ArrayTypeNode>(node));
 	case ASTNodeType::VariadicType:
-		return visit(dynamic_cast<const VariadicTypeNode&>(node));
+		return visit(node_cast<VariadicTypeNode>(node));
 	default:
 		return Err<std::string>(create_parse_error(ErrorType::InvalidCodeGeneration, "Unexpected type", node.position));
 	}
 }
 
 Result<std::string> CodeGenerationVisitor::visit(const ProgramNode& node) {
-	std::string code = "#include <cstdint>\n";
-	code += "#include \"runtime/ArgonRuntime.h\"\n";
-	code += "\n";
+	CodeSink code;
+	auto result = generate(node, code);
+	if (!result.has_value()) {
+		return Err<std::string>(result.error());
+	}
+	return Ok(code.take());
+}
+
+Result<void> CodeGenerationVisitor::generate(const ProgramNode& node, CodeSink& out, bool parallel) {
+	out.write("#include <cstdint>\n");
+	out.write("#include \"runtime/ArgonRuntime.h\"\n");
+	out.write("\n");
 
 	for (const auto& child : node.nodes) {
-		auto result = visit(*child);
+		if (child->get_node_type() == ASTNodeType::EnumDeclaration) {
+			const auto& declaration = node_cast<EnumDeclarationNode>(*child);
+			if (!is_tagged_union(declaration)) {
+				enums.simple.insert(declaration.enumName);
+				continue;
+			}
+			for (const auto& variant : declaration.variants) {
+				std::vector<std::string>& fields = enums.tagged[declaration.enumName + "::" + variant.name];
+				for (const auto& field : variant.fields) {
+					fields.push_back(field.name);
+				}
+			}
+			continue;
+		}
+		if (child->get_node_type() != ASTNodeType::FunctionDefinition) {
+			continue;
+		}
+		const auto& prototype = node_cast<FunctionDefinitionNode>(*child);
+		if (auto* name = node_cast<IdentifierNode>(prototype.name.get())) {
+			prototypedFunctions.insert(name->identifier);
+		}
+	}
+
+	// FNV-1a rather than std::hash, since the cache outlives the process; the separator keeps names apart
+	enumsHash = 0;
+	auto mix = [this](const std::string& text) {
+		for (char character : text + ";") {
+			enumsHash = (enumsHash ^ static_cast<unsigned char>(character)) * 0x100000001b3ull;
+		}
+	};
+	for (const std::string& name : enums.simple) {
+		mix(name);
+	}
+	for (const auto& [variant, fields] : enums.tagged) {
+		mix("|" + variant);
+		for (const std::string& field : fields) {
+			mix(field);
+		}
+	}
+
+	if (parallel) {
+		return generate_parallel(node, out);
+	}
+
+	// One buffer reused for every declaration, handed to the sink as soon as the declaration is complete
+	std::string code;
+	for (std::size_t i = 0; i < node.nodes.size(); ++i) {
+		if (const std::string* cached = find_cached(node, i)) {
+			out.write(*cached);
+			continue;
+		}
+		code.clear();
+		auto result = emit_declaration(node, i, code);
 		if (!result.has_value()) {
-			return Err<std::string>(result.error());
+			return Err<void>(result.error());
 		}
-		code += result.value();
+		out.write(code);
+		store_cached(node, i, code);
 	}
-	return Ok(code);
+	return Ok();
+}
+
+const std::string* CodeGenerationVisitor::find_cached(const ProgramNode& node, std::size_t index) {
+	if (cache == nullptr || node.declaration_hashes.size() != node.nodes.size()) {
+		return nullptr;
+	}
+	return cache->find(declaration_key(node, index));
+}
+
+void CodeGenerationVisitor::store_cached(const ProgramNode& node, std::size_t index, std::string code) {
+	if (cache != nullptr && node.declaration_hashes.size() == node.nodes.size()) {
+		cache->store(declaration_key(node, index), std::move(code));
+	}
+}
+
+uint64_t CodeGenerationVisitor::declaration_key(const ProgramNode& node, std::size_t index) const {
+	// Besides its own tokens, a declaration's code only depends on whether it is a function with a prototype
+	// elsewhere in the program, which keeps its std::function parameters, and on how the enums are laid out. Where
+	// it is in the file is not part of the key, so the names generated for it must not depend on that either
+	uint64_t key = node.declaration_hashes[index] ^ enumsHash;
+	const ASTNode& declaration = *node.nodes[index];
+	if (declaration.get_node_type() == ASTNodeType::FunctionDeclaration) {
+		const auto* name = node_cast<IdentifierNode>(node_cast<FunctionDeclarationNode>(declaration).name.get());
+		if (name != nullptr && prototypedFunctions.contains(name->identifier)) {
+			key ^= 0x9e3779b97f4a7c15ull;
+		}
+	}
+	return key;
+}
+
+Result<void> CodeGenerationVisitor::generate_parallel(const ProgramNode& node, CodeSink& out) {
+	Runtime::Scheduler& scheduler = Runtime::Scheduler::instance();
+	std::size_t max_chunks = scheduler.worker_count() * Runtime::detail::CHUNKS_PER_WORKER;
+	// Bounds the code held before it reaches the sink, as the sequential path does with one declaration
+	std::size_t window = max_chunks * DECLARATIONS_PER_CHUNK;
+
+	std::vector<std::string> codes;
+	std::vector<std::optional<Error>> errors;
+	std::vector<const std::string*> cached;
+	for (std::size_t first = 0; first < node.nodes.size(); first += window) {
+		std::size_t count = std::min(window, node.nodes.size() - first);
+		codes.assign(count, std::string());
+		errors.assign(count, std::nullopt);
+		// The cache is not thread-safe, so it is consulted up front
+		cached.assign(count, nullptr);
+		for (std::size_t i = 0; i < count; ++i) {
+			cached[i] = find_cached(node, first + i);
+		}
+
+		// Top-level declarations only share the prototype set, so each chunk gets a visitor of its own
+		auto generate_chunk = [&](std::size_t, std::size_t begin, std::size_t end) {
+			CodeGenerationVisitor visitor;
+			visitor.prototypedFunctions = prototypedFunctions;
+			visitor.enums = enums;
+			for (std::size_t i = begin; i < end; ++i) {
+				if (cached[i] != nullptr) {
+					continue;
+				}
+				auto result = visitor.emit_declaration(node, first + i, codes[i]);
+				if (!result.has_value()) {
+					errors[i] = result.error();
+					break;
+				}
+			}
+		};
+		Runtime::detail::parallel_chunks(count, std::min(count, max_chunks), generate_chunk);
+
+		// The first error in source order is the one the sequential path would have stopped at
+		for (std::size_t i = 0; i < count; ++i) {
+			if (errors[i]) {
+				return Err<void>(*errors[i]);
+			}
+			if (cached[i] != nullptr) {
+				out.write(*cached[i]);
+				continue;
+			}
+			out.write(codes[i]);
+			store_cached(node, first + i, std::move(codes[i]));
+		}
+	}
+	return Ok();
+}
+
+Result<void> CodeGenerationVisitor::emit_declaration(const ProgramNode& node, std::size_t index, std::string& out) {
+	// Names count up from 0 in every declaration, so that its code only depends on its own tokens. Within a
+	// function the number keeps them apart; the temporaries of a global variable share the global scope with those
+	// of the other globals, so they also carry the hash of its tokens
+	generatedNames = 0;
+	generatedNameTag.clear();
+	if (node.nodes[index]->get_node_type() == ASTNodeType::VariableDeclaration) {
+		uint64_t hash = index < node.declaration_hashes.size() ? node.declaration_hashes[index] : index;
+		char digits[16];
+		generatedNameTag = "_" + std::string(digits, std::to_chars(digits, digits + sizeof(digits), hash, 16).ptr);
+	}
+	return emit(*node.nodes[index], out);
+}
+
+std::string CodeGenerationVisitor::generated_name(const std::string& base) {
+	return base + generatedNameTag + "_" + std::to_string(generatedNames++);
+}
+
+Result<void> CodeGenerationVisitor::emit(const ASTNode& node, std::string& out) {
+	switch (node.get_node_type()) {
+	case ASTNodeType::Block:
+		return emit(node_cast<BlockNode>(node), out);
+	case ASTNodeType::IfStatement:
+		return emit(node_cast<IfStatementNode>(node), out);
+	case ASTNodeType::WhileStatement:
+		return emit(node_cast<WhileStatementNode>(node), out);
+	case ASTNodeType::ForStatement:
+		return emit(node_cast<ForStatementNode>(node), out);
+	case ASTNodeType::FunctionDeclaration:
+		return emit(node_cast<FunctionDeclarationNode>(node), out);
+	default:
+		break;
+	}
+
+	Result<std::string> code = visit(node);
+	if (!code.has_value()) {
+		return Err<void>(code.error());
+	}
+	out += code.value();
+	return Ok();
 }
 
 Result<std::string> CodeGenerationVisitor::visit(const IntegralLiteralNode& node) {
@@ -267,9 +1230,22 @@ Result<std::string> CodeGenerationVisitor::visit(const BooleanLiteralNode& node)
 }
 
 Result<std::string> CodeGenerationVisitor::visit(const IdentifierNode& node) {
+	if (!isCalleeContext) {
+		escapingIdentifiers.insert(node.identifier);
+	}
+	if (!isRefAccessContext) {
+		copiedIdentifiers.insert(node.identifier);
+	}
 	return Ok(node.identifier);
 }
 
+std::string CodeGenerationVisitor::functionalPolicy() const {
+	// Lambdas capture by reference and may update the locals they capture, so they only run on several threads
+	// where the code opted in with par
+	return isParallelContext ? "ArgonLang::Runtime::ExecutionPolicy::Parallel"
+	                         : "ArgonLang::Runtime::ExecutionPolicy::Sequential";
+}
+
 Result<std::string> CodeGenerationVisitor::visit(const BinaryExpressionNode& node) {
 	Result<std::string> left = visit(*node.left);
 	if (!left.has_value()) {
@@ -287,25 +1263,25 @@ Result<std::string> CodeGenerationVisitor::visit(const BinaryExpressionNode& nod
 		return Ok(right.value() + "(" + left.value() + ")");
 	} else if (node.op.value == "||>") {
 		// Map pipe: left ||> right becomes ArgonLang::Runtime::map_pipe
-		return Ok("ArgonLang::Runtime::map_pipe(" + left.value() + ", " + right.value() + ")" +
-		          (is_statement_context ? ";" : ""));
+		return Ok("ArgonLang::Runtime::map_pipe(" + functionalPolicy() + ", " + left.value() + ", " + right.value() +
+		          ")" + (is_statement_context ? ";" : ""));
 	} else if (node.op.value == "|") {
-		// Filter operator: left | right becomes ArgonLang::Runtime::filter
-		return Ok("ArgonLang::Runtime::filter(" + left.value() + ", " + right.value() + ")" +
-		          (is_statement_context ? ";" : ""));
+		// Filter operator: left | right becomes a lazy pipeline stage, fused with neighbouring | and &
+		return Ok("ArgonLang::Runtime::lazy_filter(" + functionalPolicy() + ", " + left.value() + ", " + right.value() +
+		          ")" + (is_statement_context ? ";" : ""));
 	} else if (node.op.value == "&") {
 		// In constraint context, & is bitwise AND; otherwise it's the map operator
 		if (isConstraintContext) {
 			return Ok("(" + left.value() + " & " + right.value() + ")");
 		} else {
-			// Map operator: left & right becomes ArgonLang::Runtime::map
-			return Ok("ArgonLang::Runtime::map(" + left.value() + ", " + right.value() + ")" +
-			          (is_statement_context ? ";" : ""));
+			// Map operator: left & right becomes a lazy pipeline stage
+			return Ok("ArgonLang::Runtime::lazy_map(" + functionalPolicy() + ", " + left.value() + ", " + right.value() +
+			          ")" + (is_statement_context ? ";" : ""));
 		}
 	} else if (node.op.value == "?") {
-		// Reduce operator: left ? right becomes ArgonLang::Runtime::reduce
-		return Ok("ArgonLang::Runtime::reduce(" + left.value() + ", " + right.value() + ")" +
-		          (is_statement_context ? ";" : ""));
+		// Reduce operator: left ? right becomes ArgonLang::Runtime::reduce (materialises a pipeline)
+		return Ok("ArgonLang::Runtime::reduce(" + functionalPolicy() + ", " + left.value() + ", " + right.value() +
+		          ")" + (is_statement_context ? ";" : ""));
 	} else if (node.op.value == "to") {
 		// Range operator: handled by ToExpressionNode, but if it appears here as binary op
 		return Ok("std::ranges::iota_view(" + left.value() + ", " + right.value() + ")" +
@@ -327,12 +1303,17 @@ Result<std::string> CodeGenerationVisitor::visit(const BinaryExpressionNode& nod
 		return Ok(left.value() + "|" + right.value());
 	} else {
 		// Regular binary operators
-		return Ok("(" + left.value() + " " + node.op.value + " " + right.value() + ")");
+		return Ok("(" + left.value() + " " + std::string(node.op.value) + " " + right.value() + ")");
 	}
 }
 
 Result<std::string> CodeGenerationVisitor::visit(const UnaryExpressionNode& node) {
-	Result<std::string> operand = visit(*node.operand);
+	Result<std::string> operand = [&]() {
+		// Neither does dereferencing it
+		ScopedStatementContext scoped(this->isRefAccessContext,
+		                              node.op.value == "*" && node.operand->get_node_type() == ASTNodeType::Identifier);
+		return visit(*node.operand);
+	}();
 	if (!operand.has_value()) {
 		return Err<std::string>(operand.error());
 	}
@@ -357,7 +1338,7 @@ Result<std::string> CodeGenerationVisitor::visit(const UnaryExpressionNode& node
 		return Ok("~" + operand.value());
 	} else {
 		// Regular unary operators
-		return Ok(node.op.value + operand.value());
+		return Ok(std::string(node.op.value) + operand.value());
 	}
 }
 
@@ -367,18 +1348,31 @@ Result<std::string> CodeGenerationVisitor::visit(const UnaryPostExpressionNode&
 		return Err<std::string>(operand.error());
 	}
 
-	return Ok(operand.value() + node.op.value);
+	return Ok(operand.value() + std::string(node.op.value));
 
 }
 
 Result<std::string> CodeGenerationVisitor::visit(const FunctionCallExpressionNode& node) {
-	Result<std::string> functionName = visit(*node.function);
+	Result<std::string> functionName = [&]() {
+		// Calling a parameter directly does not let it escape
+		ScopedStatementContext scoped_callee(this->isCalleeContext,
+		                                     node.function->get_node_type() == ASTNodeType::Identifier);
+		return visit(*node.function);
+	}();
 	if (!functionName.has_value()) {
 		return Err<std::string>(functionName.error());
 	}
 
 	std::string code = functionName.value();
 
+	// ref(args...) allocates the value and its counts together, as the type the declaration gives it if any
+	if (code == "ref" && node.function->get_node_type() == ASTNodeType::Identifier) {
+		code = "ArgonLang::Runtime::make_ref";
+		if (!refValueType.empty()) {
+			code += "<" + std::exchange(refValueType, std::string()) + ">";
+		}
+	}
+
 	// Add generic type arguments if present: func<Type1, Type2>
 	if (!node.genericTypeArgs.empty()) {
 		code += "<";
@@ -418,7 +1412,11 @@ Result<std::string> CodeGenerationVisitor::visit(const FunctionCallExpressionNod
 }
 
 Result<std::string> CodeGenerationVisitor::visit(const MemberAccessExpressionNode& node) {
-	Result<std::string> parent = visit(*node.parent);
+	Result<std::string> parent = [&]() {
+		// Reaching a member through a ref does not copy it
+		ScopedStatementContext scoped(this->isRefAccessContext, node.parent->get_node_type() == ASTNodeType::Identifier);
+		return visit(*node.parent);
+	}();
 	if (!parent.has_value()) {
 		return Err<std::string>(parent.error());
 	}
@@ -427,7 +1425,7 @@ Result<std::string> CodeGenerationVisitor::visit(const MemberAccessExpressionNod
 		return Err<std::string>(member.error());
 	}
 
-	return Ok(parent.value() + node.accessType.value + member.value());
+	return Ok(parent.value() + std::string(node.accessType.value) + member.value());
 }
 
 Result<std::string> CodeGenerationVisitor::visit(const ToExpressionNode& node) {
@@ -473,6 +1471,7 @@ Result<std::string> CodeGenerationVisitor::visit(const LambdaExpressionNode& nod
 		code.pop_back();
 	code += ")";
 
+	ScopedStatementContext scoped_return(this->isDeducedReturnContext, true);
 	Result<std::string> body = visit(*node.body);
 	if (!body.has_value()) {
 		return Err<std::string>(body.error());
@@ -497,7 +1496,7 @@ Result<std::string> CodeGenerationVisitor::visit(const ComparisonExpressionNode&
 		return Err<std::string>(right.error());
 	}
 
-	return Ok(left.value() + node.op.value + right.value());
+	return Ok(left.value() + std::string(node.op.value) + right.value());
 }
 
 Result<std::string> CodeGenerationVisitor::visit(const AssignmentExpressionNode& node) {
@@ -639,15 +1638,6 @@ Result<std::string> CodeGenerationVisitor::visit(const MultipleIndexExpressionNo
 }
 
 Result<std::string> CodeGenerationVisitor::visit(const MatchBranch& node) {
-	std::string pattern;
-	if (node.pattern) {
-		auto p = visit(*node.pattern);
-		if (!p.has_value()) {
-			return Err<std::string>(p.error());
-		}
-		pattern = p.value();
-	}
-
 	auto body = visit(*node.body);
 	if (!body.has_value()) {
 		return Err<std::string>(body.error());
@@ -666,42 +1656,28 @@ Result<std::string> CodeGenerationVisitor::visit(const MatchBranch& node) {
 	std::string code;
 	std::string patternCondition;
 
-	// Generate pattern matching condition using runtime utilities
-	if (pattern == "_") {
+	// The condition follows the kind of pattern; a range is tested against its bounds inline
+	ASTNodeType patternType = node.pattern ? node.pattern->get_node_type() : ASTNodeType::WildcardPattern;
+	if (patternType == ASTNodeType::WildcardPattern || patternType == ASTNodeType::IdentifierPattern) {
+		// Identifier patterns always match and capture the value
 		patternCondition = "ArgonLang::Runtime::match_wildcard(__match_val)";
-	} else if (pattern.find("to") != std::string::npos && pattern.find("=") != std::string::npos) {
-		// Handle range patterns like "1 to= 10"
-		size_t toPos = pattern.find(" to");
-		if (toPos != std::string::npos) {
-			std::string start = pattern.substr(0, toPos);
-			std::string end = pattern.substr(toPos + 4); // Skip " to="
-			patternCondition = "ArgonLang::Runtime::match_range(__match_val, " + start + ", " + end + ", true)";
-		} else {
-			patternCondition = "ArgonLang::Runtime::match_value(__match_val, " + pattern + ")";
-		}
-	} else if (pattern.find("to") != std::string::npos) {
-		// Handle exclusive range patterns like "1 to 10"
-		size_t toPos = pattern.find(" to ");
-		if (toPos != std::string::npos) {
-			std::string start = pattern.substr(0, toPos);
-			std::string end = pattern.substr(toPos + 4);
-			patternCondition = "ArgonLang::Runtime::match_range(__match_val, " + start + ", " + end + ", false)";
-		} else {
-			patternCondition = "ArgonLang::Runtime::match_value(__match_val, " + pattern + ")";
+	} else if (patternType == ASTNodeType::RangePattern) {
+		auto range = range_test(*this, node_cast<RangePatternNode>(*node.pattern), "__match_val");
+		if (!range.has_value()) {
+			return Err<std::string>(range.error());
 		}
+		patternCondition = range.value();
 	} else {
-		// Check if this is an identifier pattern (should capture, not compare)
-		// Identifier patterns should always match and capture the value
-		if (node.pattern && node.pattern->get_node_type() == ASTNodeType::IdentifierPattern) {
-			patternCondition = "ArgonLang::Runtime::match_wildcard(__match_val)"; // Always matches
-		} else {
-			patternCondition = "ArgonLang::Runtime::match_value(__match_val, " + pattern + ")";
+		auto pattern = visit(*node.pattern);
+		if (!pattern.has_value()) {
+			return Err<std::string>(pattern.error());
 		}
+		patternCondition = "ArgonLang::Runtime::match_value(__match_val, " + pattern.value() + ")";
 	}
 
 	// Handle variable binding for identifier patterns in guard conditions
 	if (node.pattern && node.pattern->get_node_type() == ASTNodeType::IdentifierPattern && !guardCondition.empty()) {
-		const IdentifierPatternNode* identifierPattern = dynamic_cast<const IdentifierPatternNode*>(node.pattern.get());
+		const IdentifierPatternNode* identifierPattern = node_cast<IdentifierPatternNode>(node.pattern.get());
 		if (identifierPattern) {
 			// Use C++17 structured binding in if statement: if(auto var = value; condition)
 			code = "if(auto " + identifierPattern->name + " = __match_val; " + guardCondition + ") {";
@@ -730,7 +1706,23 @@ Result<std::string> CodeGenerationVisitor::visit(const MatchExpressionNode& node
 		return Err<std::string>(value.error());
 	}
 
-	std::string code = "([&]() { auto __match_val = " + value.value() + ";";
+	std::string code;
+	auto lowered = emit_switch_match(node, value.value(), code);
+	if (!lowered.has_value()) {
+		return Err<std::string>(lowered.error());
+	}
+	if (lowered.value()) {
+		return Ok(code);
+	}
+	lowered = emit_decision_tree_match(node, value.value(), code);
+	if (!lowered.has_value()) {
+		return Err<std::string>(lowered.error());
+	}
+	if (lowered.value()) {
+		return Ok(code);
+	}
+
+	code = "([&]() { auto __match_val = " + value.value() + ";";
 	bool first = true;
 	for (const auto& branch : node.branches) {
 		auto branchCode = visit(*branch);
@@ -746,6 +1738,165 @@ Result<std::string> CodeGenerationVisitor::visit(const MatchExpressionNode& node
 	return Ok(code);
 }
 
+Result<bool> CodeGenerationVisitor::emit_switch_match(const MatchExpressionNode& node, const std::string& value,
+                                                      std::string& out) {
+	std::vector<std::pair<SwitchArm, const MatchBranch*>> arms;
+	bool has_values = false;
+	bool has_enumerators = false;
+	for (const auto& branch : node.branches) {
+		std::optional<SwitchArm> arm = switch_arm(*branch, enums);
+		if (!arm) {
+			return Ok(false);
+		}
+		has_values |= arm->kind == SwitchArm::Kind::Values;
+		has_enumerators |= arm->kind == SwitchArm::Kind::Enumerator;
+		arms.emplace_back(std::move(*arm), branch.get());
+		if (arms.back().first.kind == SwitchArm::Kind::Default) {
+			// Nothing after an irrefutable arm is reachable
+			break;
+		}
+	}
+	if (has_values == has_enumerators) {
+		return Ok(false);
+	}
+
+	// The first arm matching a value takes it, so each value only gets a case label in the earliest arm that covers
+	// it; wide ranges are compared in the default label, where they come after every case label
+	std::vector<std::pair<int64_t, int64_t>> covered;
+	std::set<std::string> coveredEnumerators;
+	auto is_covered = [&covered](int64_t v) {
+		return std::any_of(covered.begin(), covered.end(), [v](const auto& range) {
+			return range.first <= v && v <= range.second;
+		});
+	};
+
+	std::string cases;
+	std::string wide_ranges;
+	std::string fallback;
+	// The same arms as an if-chain, for scrutinees such as floats and I128 that a switch cannot take
+	std::string chain;
+	auto add_to_chain = [&chain](const std::string& test, const std::string& code) {
+		chain += (chain.empty() ? "" : " else ") + (test.empty() ? "" : "if(" + test + ") ") + "{" + code + "}";
+	};
+	for (const auto& [arm, branch] : arms) {
+		auto body = visit(*branch->body);
+		if (!body.has_value()) {
+			return Err<bool>(body.error());
+		}
+		// Statement bodies are followed by a break, as reaching the end of an if-chain branch leaves the match
+		bool expression = branch->body->get_node_group() == ASTNodeGroup::Expression;
+		std::string chainCode = expression ? "return " + body.value() + ";" : "{" + body.value() + "}";
+		std::string armCode = expression ? chainCode : chainCode + " break;";
+
+		switch (arm.kind) {
+		case SwitchArm::Kind::Values: {
+			if (arm.high < arm.low) {
+				break;
+			}
+			add_to_chain(constant_range_test("__match_val", arm.low, arm.high), chainCode);
+			if (static_cast<uint64_t>(arm.high) - static_cast<uint64_t>(arm.low) >= MAX_RANGE_CASES) {
+				wide_ranges += "if(" + constant_range_test("__match_val", arm.low, arm.high) + ") {" + armCode + "}";
+				covered.emplace_back(arm.low, arm.high);
+				break;
+			}
+			std::string labels;
+			for (int64_t v = arm.low;; ++v) {
+				if (!is_covered(v)) {
+					std::string label = std::to_string(v);
+					if (arm.literal) {
+						auto literal = visit(*arm.literal);
+						if (!literal.has_value()) {
+							return Err<bool>(literal.error());
+						}
+						label = literal.value();
+					}
+					labels += "case " + label + ":";
+				}
+				if (v == arm.high) {
+					break;
+				}
+			}
+			covered.emplace_back(arm.low, arm.high);
+			if (!labels.empty()) {
+				cases += labels + armCode;
+			}
+			break;
+		}
+		case SwitchArm::Kind::Enumerator:
+			add_to_chain("__match_val == " + arm.enumerator, chainCode);
+			if (coveredEnumerators.insert(arm.enumerator).second) {
+				cases += "case " + arm.enumerator + ":" + armCode;
+			}
+			break;
+		case SwitchArm::Kind::Default: {
+			std::string binding = arm.binding.empty() ? "" : "auto " + arm.binding + " = __match_val;";
+			fallback = binding + armCode;
+			add_to_chain("", binding + chainCode);
+			break;
+		}
+		}
+	}
+
+	// The scrutinee is bound by reference and evaluated once. Its type is only known to the C++ compiler, so the
+	// lambda is generic and the form that does not apply to it is discarded
+	out += "([&](auto&& __match_val) { if constexpr (ArgonLang::Runtime::is_switchable_v<decltype(__match_val)>) {"
+	       "switch(__match_val) {" +
+	       cases;
+	if (!wide_ranges.empty() || !fallback.empty()) {
+		out += "default: {" + wide_ranges + fallback + "}";
+	}
+	out += "}} else {" + chain + "}})(" + value + ")";
+	return Ok(true);
+}
+
+Result<bool> CodeGenerationVisitor::emit_decision_tree_match(const MatchExpressionNode& node, const std::string& value,
+                                                             std::string& out) {
+	bool structured = false;
+	for (const auto& branch : node.branches) {
+		if (!branch->pattern || !is_tree_pattern(*branch->pattern, enums, structured)) {
+			return Ok(false);
+		}
+	}
+	if (!structured) {
+		return Ok(false);
+	}
+
+	std::vector<MatchArmCode> arms;
+	std::vector<MatchRow> rows;
+	bool has_statement_arms = false;
+	for (const auto& branch : node.branches) {
+		MatchArmCode arm;
+		if (branch->condition) {
+			auto guard = visit(*branch->condition);
+			if (!guard.has_value()) {
+				return Err<bool>(guard.error());
+			}
+			arm.guard = guard.value();
+		}
+		auto body = visit(*branch->body);
+		if (!body.has_value()) {
+			return Err<bool>(body.error());
+		}
+		// An arm may be reached from several places in the tree, so statement bodies leave it with a jump
+		if (branch->body->get_node_group() == ASTNodeGroup::Expression) {
+			arm.body = "return " + body.value() + ";";
+		} else {
+			arm.body = "{" + body.value() + "} goto __match_end;";
+			has_statement_arms = true;
+		}
+		rows.push_back(MatchRow{{branch->pattern.get()}, {}, arms.size()});
+		arms.push_back(std::move(arm));
+	}
+
+	std::string tree;
+	auto result = DecisionTree(*this, enums, arms).emit(std::move(rows), {"__match_val"}, tree);
+	if (!result.has_value()) {
+		return Err<bool>(result.error());
+	}
+	out += "([&]() { auto&& __match_val = " + value + ";" + tree + (has_statement_arms ? "__match_end:;" : "") + "})()";
+	return Ok(true);
+}
+
 Result<std::string> CodeGenerationVisitor::visit(const TernaryExpressionNode& node) {
 	auto cond = visit(*node.condition);
 	if (!cond.has_value()) {
@@ -767,10 +1918,13 @@ Result<std::string> CodeGenerationVisitor::visit(const ParallelExpressionNode& n
 	// Temporarily disable statement context to avoid extra semicolons
 	bool originalContext = this->is_statement_context;
 	ScopedStatementContext scoped(this->is_statement_context, false);
+	// Functional operators inside a par body always use the parallel runtime paths
+	ScopedStatementContext scoped_parallel(this->isParallelContext, true);
 	auto expr = visit(*node.statementNode);
 	if (!expr.has_value()) {
 		return Err<std::string>(expr.error());
 	}
+	this->block_contains_par = true;
 
 	// Use ArgonLang runtime library for parallel execution
 	if (node.statementNode->get_node_group() == ASTNodeGroup::Statement) {
@@ -778,7 +1932,8 @@ Result<std::string> CodeGenerationVisitor::visit(const ParallelExpressionNode& n
 		return {"ArgonLang::Runtime::par([&]() { " + expr.value() + "; return 0; })" + (originalContext ? ";" : "")};
 	} else {
 		// For expressions, wrap in lambda that returns the expression value
-		return {"ArgonLang::Runtime::par([&]() { return " + expr.value() + "; })" + (originalContext ? ";" : "")};
+		return {"ArgonLang::Runtime::par([&]() { return " + materialized(*node.statementNode, expr.value()) + "; })" +
+		        (originalContext ? ";" : "")};
 	}
 }
 
@@ -804,9 +1959,7 @@ Result<std::string> CodeGenerationVisitor::visit(const StructField& node) {
 }
 
 Result<std::string> CodeGenerationVisitor::visit(const StructExpressionNode& node) {
-	// Generate a unique struct name based on position
-	std::string structName =
-	    "AnonymousStruct_" + std::to_string(node.position.line) + "_" + std::to_string(node.position.column);
+	std::string structName = generated_name("AnonymousStruct");
 
 	// Generate an immediately invoked lambda that creates and returns the struct
 	std::string code = "([&]() {";
@@ -893,10 +2046,8 @@ Result<std::string> CodeGenerationVisitor::visit(const VariableDeclarationNode&
 			return Err<std::string>(value.error());
 		}
 
-		// Generate unique temporary variable for the value using position
-		std::string tempVar =
-		    "__compound_temp_" + std::to_string(node.position.line) + "_" + std::to_string(node.position.column);
-		code += "auto " + tempVar + " = " + value.value() + ";";
+		std::string tempVar = generated_name("__compound_temp");
+		code += "auto " + tempVar + " = " + materialized(*node.value, value.value()) + ";";
 
 		// Generate compound destructuring assignments
 		Result<std::string> compoundDestructuring = generateCompoundDestructuring(node.compoundPatterns, tempVar);
@@ -921,10 +2072,8 @@ Result<std::string> CodeGenerationVisitor::visit(const VariableDeclarationNode&
 			return Err<std::string>(value.error());
 		}
 
-		// Generate unique temporary variable for the value using position
-		std::string tempVar =
-		    "__destructure_temp_" + std::to_string(node.position.line) + "_" + std::to_string(node.position.column);
-		code += "auto " + tempVar + " = " + value.value() + ";";
+		std::string tempVar = generated_name("__destructure_temp");
+		code += "auto " + tempVar + " = " + materialized(*node.value, value.value()) + ";";
 
 		// Generate destructuring assignments
 		Result<std::string> destructuring = generateDestructuring(node.pattern.get(), tempVar);
@@ -950,11 +2099,24 @@ Result<std::string> CodeGenerationVisitor::visit(const VariableDeclarationNode&
 
 	if (node.value) {
 		ScopedStatementContext scoped(this->is_statement_context, false);
+		// def x: ref<T> = ref(args...) constructs a T from args, which need not be a T themselves
+		const auto* generic = node_cast<GenericTypeNode>(node.type.get());
+		const auto* call = node_cast<FunctionCallExpressionNode>(node.value.get());
+		const auto* callee = call != nullptr ? node_cast<IdentifierNode>(call->function.get()) : nullptr;
+		if (generic != nullptr && ref_class(*generic) != nullptr && callee != nullptr && callee->identifier == "ref") {
+			Result<std::string> valueType = visit(*generic->params[0]);
+			if (!valueType.has_value()) {
+				return Err<std::string>(valueType.error());
+			}
+			refValueType = valueType.value();
+		}
 		Result<std::string> value = visit(*node.value);
+		refValueType.clear();
 		if (!value.has_value()) {
 			return Err<std::string>(value.error());
 		}
-		code += " = " + value.value();
+		// A typed binding converts a pipeline itself
+		code += " = " + (node.type ? value.value() : materialized(*node.value, value.value()));
 	}
 
 	code += ";";
@@ -963,11 +2125,20 @@ Result<std::string> CodeGenerationVisitor::visit(const VariableDeclarationNode&
 }
 
 Result<std::string> CodeGenerationVisitor::visit(const FunctionDeclarationNode& node) {
+	std::string code;
+	auto result = emit(node, code);
+	if (!result.has_value()) {
+		return Err<std::string>(result.error());
+	}
+	return Ok(code);
+}
+
+Result<void> CodeGenerationVisitor::emit(const FunctionDeclarationNode& node, std::string& out) {
 	ScopedStatementContext scoped(this->is_statement_context, true);
 
 	auto nameResult = visit(*node.name);
 	if (!nameResult.has_value()) {
-		return Err<std::string>(nameResult.error());
+		return Err<void>(nameResult.error());
 	}
 	std::string functionName = nameResult.value();
 
@@ -975,50 +2146,62 @@ Result<std::string> CodeGenerationVisitor::visit(const FunctionDeclarationNode&
 	if (node.returnType) {
 		auto returnTypeResult = visit(*node.returnType);
 		if (!returnTypeResult.has_value()) {
-			return Err<std::string>(returnTypeResult.error());
+			return Err<void>(returnTypeResult.error());
 		}
 		returnType = returnTypeResult.value();
 	}
 
-	std::string code;
-
 	// Generate template parameters if present
 	auto genericResult = generateGenericParameters(node.genericParams);
 	if (!genericResult.has_value()) {
-		return Err<std::string>(genericResult.error());
+		return Err<void>(genericResult.error());
 	}
-	code += genericResult.value();
 
-	code += returnType + " " + functionName + "(";
+	// The body is generated before the parameters so that escape information for them is known
+	std::set<std::string> outerEscaping = std::move(escapingIdentifiers);
+	escapingIdentifiers.clear();
+	bool deducedReturn = returnType == "auto";
+	ScopedStatementContext scoped_return(this->isDeducedReturnContext, deducedReturn);
+	std::string body;
+	auto bodyResult = emit(*node.body, body);
+	if (!bodyResult.has_value()) {
+		return Err<void>(bodyResult.error());
+	}
+	std::set<std::string> bodyEscaping = std::move(escapingIdentifiers);
+	escapingIdentifiers = std::move(outerEscaping);
+	escapingIdentifiers.insert(bodyEscaping.begin(), bodyEscaping.end());
+
+	bool canBorrowCallables = !prototypedFunctions.contains(functionName);
 
+	out += genericResult.value();
+	out += returnType + " " + functionName + "(";
+
+	bool first = true;
 	for (const auto& arg : node.args) {
+		// Function-typed parameters that are only ever called are borrowed instead of copied into std::function
+		bool borrow = canBorrowCallables && arg->type && arg->type->get_node_type() == ASTNodeType::FunctionType &&
+		              !bodyEscaping.contains(arg->name);
+		ScopedStatementContext scoped_ref(this->lowerFunctionTypeAsRef, borrow);
 		auto argResult = visit(*arg);
 		if (!argResult.has_value()) {
-			return Err<std::string>(argResult.error());
+			return Err<void>(argResult.error());
 		}
-		code += argResult.value() + ",";
-	}
-	if (!node.args.empty()) {
-		code.pop_back();
+		if (!first) {
+			out += ",";
+		}
+		out += argResult.value();
+		first = false;
 	}
 
-	code += ")";
+	out += ")";
 
 	if (node.body->get_node_type() != ASTNodeType::Block) {
-		auto bodyResult = visit(*node.body);
-		if (!bodyResult.has_value()) {
-			return Err<std::string>(bodyResult.error());
-		}
-		code += " { return " + bodyResult.value() + "; }";
+		out += " { return " + (deducedReturn ? materialized(*node.body, body) : body) + "; }";
 	} else {
-		auto bodyResult = visit(*node.body);
-		if (!bodyResult.has_value()) {
-			return Err<std::string>(bodyResult.error());
-		}
-		code += bodyResult.value();
+		out += body;
 	}
 
-	return code;
+	return Ok();
 }
 
 Result<std::string> CodeGenerationVisitor::visit(const FunctionDefinitionNode& node) {
@@ -1071,6 +2254,9 @@ Result<std::string> CodeGenerationVisitor::visit(const ReturnStatementNode& node
 		return Err<std::string>(returnValue.error());
 	}
 
+	if (isDeducedReturnContext) {
+		return Ok("return " + materialized(*node.returnExpression, returnValue.value()) + ";");
+	}
 	return Ok("return " + returnValue.value() + ";");
 }
 
@@ -1224,194 +2410,147 @@ Result<std::string> CodeGenerationVisitor::visit(const UnionDeclarationNode& nod
 }
 
 Result<std::string> CodeGenerationVisitor::visit(const IfStatementNode& node) {
-	ScopedStatementContext scoped(this->is_statement_context, true);
+	std::string code;
+	auto result = emit(node, code);
+	if (!result.has_value()) {
+		return Err<std::string>(result.error());
+	}
+	return Ok(code);
+}
 
-	std::string code = "if(";
+Result<void> CodeGenerationVisitor::emit(const IfStatementNode& node, std::string& out) {
+	ScopedStatementContext scoped(this->is_statement_context, true);
 
 	Result<std::string> condition = visit(*node.condition);
 	if (!condition.has_value()) {
-		return Err<std::string>(condition.error());
+		return Err<void>(condition.error());
 	}
 
-	code += condition.value();
-
-	code += ")";
-	Result<std::string> body = visit(*node.body);
+	out += "if(";
+	out += condition.value();
+	out += ")";
+	Result<void> body = emit(*node.body, out);
 	if (!body.has_value()) {
-		return Err<std::string>(body.error());
+		return Err<void>(body.error());
 	}
 
-	code += body.value();
-
 	// Handle else branch if present
 	if (node.elseBranch != nullptr) {
-		code += "else";
-		Result<std::string> elseBranch = visit(*node.elseBranch);
+		out += "else";
+		Result<void> elseBranch = emit(*node.elseBranch, out);
 		if (!elseBranch.has_value()) {
-			return Err<std::string>(elseBranch.error());
+			return Err<void>(elseBranch.error());
 		}
-		code += elseBranch.value();
 	}
 
-	return Ok(code);
+	return Ok();
 }
 
 Result<std::string> CodeGenerationVisitor::visit(const ForStatementNode& node) {
+	std::string code;
+	auto result = emit(node, code);
+	if (!result.has_value()) {
+		return Err<std::string>(result.error());
+	}
+	return Ok(code);
+}
+
+Result<void> CodeGenerationVisitor::emit(const ForStatementNode& node, std::string& out) {
 	ScopedStatementContext scoped(this->is_statement_context, true);
 
 	Result<std::string> iterator = visit(*node.iterator);
 	if (!iterator.has_value()) {
-		return Err<std::string>(iterator.error());
+		return Err<void>(iterator.error());
 	}
 
-	std::string iteratorCode = iterator.value();
-	std::string code;
-
-	// Check if this is a range expression (contains "std::ranges::iota_view")
-	if (iteratorCode.find("std::ranges::iota_view") != std::string::npos) {
-		// Range-based for loop: for(i -> 0 to 10)
-		if (node.variableType) {
-			Result<std::string> type = visit(*node.variableType);
-			if (!type.has_value()) {
-				return Err<std::string>(type.error());
-			}
-			code += "for(" + type.value() + " " + node.variableName + " : " + iteratorCode + ")";
-		} else {
-			code += "for(auto " + node.variableName + " : " + iteratorCode + ")";
+	const std::string& iteratorCode = iterator.value();
+	std::string variableType = "auto";
+	if (node.variableType) {
+		Result<std::string> type = visit(*node.variableType);
+		if (!type.has_value()) {
+			return Err<void>(type.error());
 		}
+		variableType = type.value();
 	}
-	// Check if this is an iterator syntax ($array) or iterator pair variable
-	else if (iteratorCode.find("begin()") != std::string::npos && iteratorCode.find("end()") != std::string::npos) {
-		// Direct iterator syntax: for(i -> $arr)
-		std::string containerVar =
-		    "__for_container_" + std::to_string(node.position.line) + "_" + std::to_string(node.position.column);
-		code += "auto " + containerVar + " = " + iteratorCode + ";";
-
-		if (node.variableType) {
-			Result<std::string> type = visit(*node.variableType);
-			if (!type.has_value()) {
-				return Err<std::string>(type.error());
-			}
-			code += "for(auto __it = " + containerVar + ".first; __it != " + containerVar + ".second; ++__it) {";
-			code += type.value() + " " + node.variableName + " = *__it;";
-		} else {
-			code += "for(auto __it = " + containerVar + ".first; __it != " + containerVar + ".second; ++__it) {";
-			code += "auto " + node.variableName + " = *__it;";
-		}
 
-		Result<std::string> body = visit(*node.body);
-		if (!body.has_value()) {
-			return Err<std::string>(body.error());
-		}
+	// Check if this is a range expression (contains "std::ranges::iota_view"), or otherwise a collection
+	bool isRange = iteratorCode.find("std::ranges::iota_view") != std::string::npos;
+	// Direct iterator syntax: for(i -> $arr)
+	bool isIteratorSyntax = !isRange && iteratorCode.find("begin()") != std::string::npos &&
+	                        iteratorCode.find("end()") != std::string::npos;
+	// Iterator pair variable: for(i -> iterator)
+	bool isIteratorPair = !isRange && !isIteratorSyntax &&
+	                      (iteratorCode.find("std::make_pair") != std::string::npos ||
+	                       (iteratorCode.find('.') == std::string::npos && iteratorCode.find('[') == std::string::npos &&
+	                        iteratorCode.find('(') == std::string::npos));
 
-		// Handle body - if it's a block, extract its content, otherwise wrap it
-		std::string bodyCode = body.value();
-		if (bodyCode.front() == '{' && bodyCode.back() == '}') {
-			// Remove outer braces and add the content
-			code += bodyCode.substr(1, bodyCode.length() - 2);
-		} else {
-			code += bodyCode;
-		}
-		code += "}";
-
-		return Ok(code);
+	if (!isIteratorSyntax && !isIteratorPair) {
+		// Range-based for loop: for(i -> 0 to 10), or collection-based: for(i -> collection)
+		out += "for(" + variableType + " " + node.variableName + " : " + iteratorCode + ")";
+		return emit(*node.body, out);
 	}
-	// Check if this might be an iterator pair variable
-	else if (iteratorCode.find("std::make_pair") != std::string::npos ||
-	         (iteratorCode.find('.') == std::string::npos && iteratorCode.find('[') == std::string::npos &&
-	          iteratorCode.find('(') == std::string::npos)) {
-		// Iterator pair variable: for(i -> iterator)
-		if (node.variableType) {
-			Result<std::string> type = visit(*node.variableType);
-			if (!type.has_value()) {
-				return Err<std::string>(type.error());
-			}
-			code += "for(auto __it = " + iteratorCode + ".first; __it != " + iteratorCode + ".second; ++__it) {";
-			code += type.value() + " " + node.variableName + " = *__it;";
-		} else {
-			code += "for(auto __it = " + iteratorCode + ".first; __it != " + iteratorCode + ".second; ++__it) {";
-			code += "auto " + node.variableName + " = *__it;";
-		}
-
-		Result<std::string> body = visit(*node.body);
-		if (!body.has_value()) {
-			return Err<std::string>(body.error());
-		}
-
-		// Handle body - if it's a block, extract its content, otherwise wrap it
-		std::string bodyCode = body.value();
-		if (bodyCode.front() == '{' && bodyCode.back() == '}') {
-			// Remove outer braces and add the content
-			code += bodyCode.substr(1, bodyCode.length() - 2);
-		} else {
-			code += bodyCode;
-		}
-		code += "}";
 
-		return Ok(code);
-	} else {
-		// Collection-based for loop: for(i -> collection)
-		if (node.variableType) {
-			Result<std::string> type = visit(*node.variableType);
-			if (!type.has_value()) {
-				return Err<std::string>(type.error());
-			}
-			code += "for(" + type.value() + " " + node.variableName + " : " + iteratorCode + ")";
-		} else {
-			code += "for(auto " + node.variableName + " : " + iteratorCode + ")";
-		}
+	std::string pairCode = iteratorCode;
+	if (isIteratorSyntax) {
+		std::string containerVar = generated_name("__for_container");
+		out += "auto " + containerVar + " = " + iteratorCode + ";";
+		pairCode = containerVar;
 	}
+	out += "for(auto __it = " + pairCode + ".first; __it != " + pairCode + ".second; ++__it) {";
+	out += variableType + " " + node.variableName + " = *__it;";
 
-	Result<std::string> body = visit(*node.body);
+	size_t bodyStart = out.size();
+	Result<void> body = emit(*node.body, out);
 	if (!body.has_value()) {
-		return Err<std::string>(body.error());
+		return Err<void>(body.error());
 	}
 
-	code += body.value();
+	// Handle body - if it's a block, splice in its content, otherwise keep it as is
+	if (out.size() > bodyStart && out[bodyStart] == '{' && out.back() == '}') {
+		out.pop_back();
+		out.erase(bodyStart, 1);
+	}
+	out += "}";
 
-	return Ok(code);
+	return Ok();
 }
 
 Result<std::string> CodeGenerationVisitor::visit(const WhileStatementNode& node) {
-	ScopedStatementContext scoped(this->is_statement_context, true);
-
 	std::string code;
+	auto result = emit(node, code);
+	if (!result.has_value()) {
+		return Err<std::string>(result.error());
+	}
+	return Ok(code);
+}
+
+Result<void> CodeGenerationVisitor::emit(const WhileStatementNode& node, std::string& out) {
+	ScopedStatementContext scoped(this->is_statement_context, true);
 
 	if (node.isDoWhile) {
-		code += "do";
-		Result<std::string> body = visit(*node.body);
+		out += "do";
+		Result<void> body = emit(*node.body, out);
 		if (!body.has_value()) {
-			return Err<std::string>(body.error());
+			return Err<void>(body.error());
 		}
 
-		code += body.value();
-
 		Result<std::string> condition = visit(*node.condition);
 		if (!condition.has_value()) {
-			return Err<std::string>(condition.error());
+			return Err<void>(condition.error());
 		}
-		code += "while(" + condition.value() + ");";
-		return Ok(code);
+		out += "while(" + condition.value() + ");";
+		return Ok();
 	}
 
-	code += "while(";
-
 	Result<std::string> condition = visit(*node.condition);
 	if (!condition.has_value()) {
-		return Err<std::string>(condition.error());
+		return Err<void>(condition.error());
 	}
 
-	code += condition.value();
-
-	code += ")";
-	Result<std::string> body = visit(*node.body);
-	if (!body.has_value()) {
-		return Err<std::string>(body.error());
-	}
-
-	code += body.value();
-
-	return Ok(code);
+	out += "while(";
+	out += condition.value();
+	out += ")";
+	return emit(*node.body, out);
 }
 
 Result<std::string> CodeGenerationVisitor::visit(const BreakStatementNode& node) {
@@ -1435,23 +2574,52 @@ Result<std::string> CodeGenerationVisitor::visit(const TypeAliasNode& node) {
 }
 
 Result<std::string> CodeGenerationVisitor::visit(const BlockNode& node) {
-	ScopedStatementContext scoped(this->is_statement_context, true);
+	std::string code;
+	auto result = emit(node, code);
+	if (!result.has_value()) {
+		return Err<std::string>(result.error());
+	}
+	return Ok(code);
+}
 
-	std::string code = "{";
+Result<void> CodeGenerationVisitor::emit(const BlockNode& node, std::string& out) {
+	ScopedStatementContext scoped(this->is_statement_context, true);
 
-	// Add scope management for parallel execution
-	code += "ARGON_SCOPE_BEGIN();";
+	ScopedStatementContext scoped_par(this->block_contains_par, false);
 
+	out += "{";
+	size_t bodyStart = out.size();
+	std::set<std::string> outerCopied = std::move(copiedIdentifiers);
+	copiedIdentifiers.clear();
+	// Refs made by the declarations of this block, with where their code starts
+	std::vector<std::pair<std::string, size_t>> freshRefs;
 	for (const auto& statement : node.body) {
-		Result<std::string> statementCode = visit(*statement);
+		if (const std::string* name = fresh_ref_name(*statement)) {
+			freshRefs.emplace_back(*name, out.size());
+		}
+		Result<void> statementCode = emit(*statement, out);
 		if (!statementCode.has_value()) {
-			return Err<std::string>(statementCode.error());
+			return Err<void>(statementCode.error());
 		}
-		code += statementCode.value();
 	}
 
-	code += "}";
-	return code;
+	// A ref the block never copies has no other reference that could reach another thread, so it gets local counts;
+	// patched from the back so that the earlier positions stay valid
+	static constexpr std::string_view makeRef = "ArgonLang::Runtime::make_ref";
+	for (auto fresh = freshRefs.rbegin(); fresh != freshRefs.rend(); ++fresh) {
+		size_t call = out.find(makeRef, fresh->second);
+		if (!copiedIdentifiers.contains(fresh->first) && call != std::string::npos) {
+			out.replace(call, makeRef.size(), "ArgonLang::Runtime::make_local_ref");
+		}
+	}
+	copiedIdentifiers.insert(outerCopied.begin(), outerCopied.end());
+
+	// Only blocks that lexically start a par need a scope to wait for it
+	if (this->block_contains_par) {
+		out.insert(bodyStart, "ARGON_SCOPE_BEGIN();");
+	}
+	out += "}";
+	return Ok();
 }
 
 Result<std::string> CodeGenerationVisitor::visit(const IdentifierTypeNode& node) {
@@ -1473,6 +2641,8 @@ Result<std::string> CodeGenerationVisitor::visit(const IdentifierTypeNode& node)
 		code += "STR";
 	else if (node.typeName == "chr")
 		code += "char";
+	else if (node.typeName == "vec")
+		code += "std::vector";
 	else
 		code += node.typeName;
 
@@ -1484,7 +2654,8 @@ Result<std::string> CodeGenerationVisitor::visit(const GenericTypeNode& node) {
 	if (!base.has_value()) {
 		return Err<std::string>(base.error());
 	}
-	std::string code = base.value() + "<";
+	const char* refClass = ref_class(node);
+	std::string code = (refClass != nullptr ? refClass : base.value()) + "<";
 	for (const auto& p : node.params) {
 		auto pCode = visit(*p);
 		if (!pCode.has_value()) {
@@ -1543,10 +2714,10 @@ Result<std::string> CodeGenerationVisitor::visit(const PrefixedTypeNode& node) {
 		code = "std::unique_ptr<" + base.value() + ">";
 		break;
 	case PrefixedTypeNode::SharedRef:
-		code = "std::shared_ptr<" + base.value() + ">";
+		code = "ArgonLang::Runtime::Ref<" + base.value() + ">";
 		break;
 	case PrefixedTypeNode::WeakRef:
-		code = "std::weak_ptr<" + base.value() + ">";
+		code = "ArgonLang::Runtime::Weak<" + base.value() + ">";
 		break;
 	case PrefixedTypeNode::ImmutableRef:
 		code = "const " + base.value() + "&";
@@ -1564,9 +2735,12 @@ Result<std::string> CodeGenerationVisitor::visit(const PrefixedTypeNode& node) {
 Result<std::string> CodeGenerationVisitor::visit(const EnumDeclarationNode& node) {
 	std::string code;
 
-	if (node.isUnion) {
-		// Generate tagged union using std::variant
-		code = "enum class " + node.enumName + "Type { ";
+	if (is_tagged_union(node)) {
+		// A tag and the payload of each variant overlaid in one union: the tag names the live member, so the
+		// constructors, destructor and visit are each a switch over it
+		const std::string& name = node.enumName;
+		code = "class " + name + " {\npublic:\n";
+		code += std::string("    enum class Tag : ") + (node.variants.size() <= 256 ? "uint8_t" : "uint16_t") + " { ";
 		for (const auto& variant : node.variants) {
 			code += variant.name + ", ";
 		}
@@ -1574,31 +2748,81 @@ Result<std::string> CodeGenerationVisitor::visit(const EnumDeclarationNode& node
 			code.pop_back(), code.pop_back();
 		code += " };\n";
 
-		code += "class " + node.enumName + " {\npublic:\n";
-		code += "    " + node.enumName + "Type type;\n";
-		code += "    std::variant<";
-
+		// Payloads, and a factory per variant named after it, so that Enum::Variant(fields...) constructs one
+		std::string factories;
+		std::string copies;
+		std::string moves;
+		std::string destructors;
+		std::string visits;
+		std::string accessors;
+		std::string members;
 		for (const auto& variant : node.variants) {
+			const std::string payload = variant.name + "Fields";
+			const std::string member = "payload." + variant.name;
+			code += "    struct " + payload + " {";
+			std::string parameters;
+			std::string arguments;
+			for (const auto& field : variant.fields) {
+				auto fieldResult = visit(*field.type);
+				if (!fieldResult.has_value()) {
+					return Err<std::string>(fieldResult.error());
+				}
+				code += " " + fieldResult.value() + " " + field.name + ";";
+				parameters += (parameters.empty() ? "" : ", ") + fieldResult.value() + " " + field.name;
+				arguments += (arguments.empty() ? "std::move(" : ", std::move(") + field.name + ")";
+			}
+			code += variant.fields.empty() ? "};\n" : " };\n";
+
 			if (variant.fields.empty()) {
-				code += "std::monostate, ";
+				factories += "    static const " + name + " " + variant.name + ";\n";
 			} else {
-				code += "std::tuple<";
-				for (const auto& field : variant.fields) {
-					auto fieldResult = visit(*field.type);
-					if (!fieldResult.has_value()) {
-						return Err<std::string>(fieldResult.error());
-					}
-					code += fieldResult.value() + ", ";
-				}
-				if (!variant.fields.empty())
-					code.pop_back(), code.pop_back();
-				code += ">, ";
+				factories += "    static " + name + " " + variant.name + "(" + parameters + ") { return " + name +
+				             "(" + payload + "{" + arguments + "}); }\n";
 			}
-		}
-		if (!node.variants.empty())
-			code.pop_back(), code.pop_back();
-		code += "> data;\n";
+			factories += "    explicit " + name + "(" + payload + " fields) : currentTag(Tag::" + variant.name +
+			             ") { ::new (&" + member + ") " + payload + "(std::move(fields)); }\n";
+			const std::string label = "        case Tag::" + variant.name + ": ";
+			copies += label + "::new (&" + member + ") " + payload + "(other." + member + "); break;\n";
+			moves += label + "::new (&" + member + ") " + payload + "(std::move(other." + member + ")); break;\n";
+			destructors += label + member + ".~" + payload + "(); break;\n";
+			visits += label + "return std::forward<Visitor>(visitor)(" + member + ");\n";
+			accessors += "    const " + payload + "& as_" + variant.name + "() const { return " + member + "; }\n";
+			members += "        " + payload + " " + variant.name + ";\n";
+		}
+		code += factories;
+
+		// A default value is the first variant with its fields value-initialized
+		if (!node.variants.empty()) {
+			code += "    " + name + "() : " + name + "(" + node.variants.front().name + "Fields{}) {}\n";
+		}
+		code += "    " + name + "(const " + name + "& other) : currentTag(other.currentTag) {\n";
+		code += "        switch (currentTag) {\n" + copies + "        }\n    }\n";
+		code += "    " + name + "(" + name + "&& other) noexcept : currentTag(other.currentTag) {\n";
+		code += "        switch (currentTag) {\n" + moves + "        }\n    }\n";
+		code += "    " + name + "& operator=(" + name + " other) noexcept {\n";
+		code += "        this->~" + name + "();\n";
+		code += "        ::new (this) " + name + "(std::move(other));\n";
+		code += "        return *this;\n    }\n";
+		code += "    ~" + name + "() {\n";
+		code += "        switch (currentTag) {\n" + destructors + "        }\n    }\n";
+		code += "    Tag tag() const { return currentTag; }\n";
+		code += accessors;
+
+		// Every tag has a case, so the switch compiles to a jump table with no bounds check
+		code += "    template<typename Visitor> decltype(auto) visit(Visitor&& visitor) const {\n";
+		code += "        switch (currentTag) {\n" + visits + "        }\n";
+		code += "        std::unreachable();\n    }\n";
+
+		code += "private:\n";
+		code += "    union Payload {\n        Payload() {}\n        ~Payload() {}\n" + members + "    } payload;\n";
+		code += "    Tag currentTag;\n";
 		code += "};\n";
+		for (const auto& variant : node.variants) {
+			if (variant.fields.empty()) {
+				code += "inline const " + name + " " + name + "::" + variant.name + " = " + name + "(" + name +
+				        "::" + variant.name + "Fields{});\n";
+			}
+		}
 	} else {
 		// Generate simple enum
 		code = "enum class " + node.enumName + " { ";
@@ -1682,10 +2906,13 @@ Result<std::string> CodeGenerationVisitor::visit(const ImportStatementNode& node
 
 Result<std::string> CodeGenerationVisitor::visit(const FunctionTypeNode& node) {
 	std::string code;
+	std::string wrapper = lowerFunctionTypeAsRef ? "ArgonLang::Runtime::FunctionRef<" : "std::function<";
+	// Only the outermost function type of a borrowed parameter is a reference
+	ScopedStatementContext scoped_ref(this->lowerFunctionTypeAsRef, false);
 
 	if (node.isClosure) {
 		// Closure type: func i32 -> std::function<i32()>
-		code += "std::function<";
+		code += wrapper;
 		if (node.returnType) {
 			auto retType = visit(*node.returnType);
 			if (!retType.has_value()) {
@@ -1698,7 +2925,7 @@ Result<std::string> CodeGenerationVisitor::visit(const FunctionTypeNode& node) {
 		code += "()>";
 	} else {
 		// Function type: func(i32, i32) i32 -> std::function<i32(i32, i32)>
-		code += "std::function<";
+		code += wrapper;
 		if (node.returnType) {
 			auto retType = visit(*node.returnType);
 			if (!retType.has_value()) {
@@ -1765,21 +2992,21 @@ Result<std::string> CodeGenerationVisitor::visit(const PatternNode& node) {
 	// Dispatch to specific pattern types
 	switch (node.get_node_type()) {
 	case ASTNodeType::WildcardPattern:
-		return visit(dynamic_cast<const WildcardPatternNode&>(node));
+		return visit(node_cast<WildcardPatternNode>(node));
 	case ASTNodeType::LiteralPattern:
-		return visit(dynamic_cast<const LiteralPatternNode&>(node));
+		return visit(node_cast<LiteralPatternNode>(node));
 	case ASTNodeType::IdentifierPattern:
-		return visit(dynamic_cast<const IdentifierPatternNode&>(node));
+		return visit(node_cast<IdentifierPatternNode>(node));
 	case ASTNodeType::ArrayPattern:
-		return visit(dynamic_cast<const ArrayPatternNode&>(node));
+		return visit(node_cast<ArrayPatternNode>(node));
 	case ASTNodeType::StructPattern:
-		return visit(dynamic_cast<const StructPatternNode&>(node));
+		return visit(node_cast<StructPatternNode>(node));
 	case ASTNodeType::ConstructorPattern:
-		return visit(dynamic_cast<const ConstructorPatternNode&>(node));
+		return visit(node_cast<ConstructorPatternNode>(node));
 	case ASTNodeType::TypePattern:
-		return visit(dynamic_cast<const TypePatternNode&>(node));
+		return visit(node_cast<TypePatternNode>(node));
 	case ASTNodeType::RangePattern:
-		return visit(dynamic_cast<const RangePatternNode&>(node));
+		return visit(node_cast<RangePatternNode>(node));
 	default:
 		return Err<std::string>(
 		    create_parse_error(ErrorType::InvalidCodeGeneration, "Unknown pattern type", node.position));
@@ -1888,7 +3115,7 @@ Result<std::string> CodeGenerationVisitor::generateDestructuring(const PatternNo
 
 	switch (pattern->get_node_type()) {
 	case ASTNodeType::ArrayPattern: {
-		const ArrayPatternNode* arrayPattern = dynamic_cast<const ArrayPatternNode*>(pattern);
+		const ArrayPatternNode* arrayPattern = node_cast<ArrayPatternNode>(pattern);
 		if (!arrayPattern) {
 			return Err<std::string>(create_parse_error(ErrorType::InvalidCodeGeneration,
 			                                           "Failed to cast to ArrayPatternNode", pattern->position));
@@ -1899,15 +3126,14 @@ Result<std::string> CodeGenerationVisitor::generateDestructuring(const PatternNo
 			const PatternNode* element = arrayPattern->elements[i].get();
 
 			if (element->get_node_type() == ASTNodeType::IdentifierPattern) {
-				const IdentifierPatternNode* identifierPattern = dynamic_cast<const IdentifierPatternNode*>(element);
+				const IdentifierPatternNode* identifierPattern = node_cast<IdentifierPatternNode>(element);
 				if (identifierPattern) {
 					code += "auto " + identifierPattern->name + " = ArgonLang::Runtime::destructure_array_element(" +
 					        sourceVar + ", " + std::to_string(i) + ");";
 				}
 			} else {
 				// Nested destructuring - create a unique temporary variable for the element
-				std::string elementVar = "__destructure_elem_" + std::to_string(element->position.line) + "_" +
-				                         std::to_string(element->position.column) + "_" + std::to_string(i);
+				std::string elementVar = generated_name("__destructure_elem");
 				code += "auto " + elementVar + " = ArgonLang::Runtime::destructure_array_element(" + sourceVar + ", " +
 				        std::to_string(i) + ");";
 
@@ -1923,7 +3149,7 @@ Result<std::string> CodeGenerationVisitor::generateDestructuring(const PatternNo
 		if (arrayPattern->rest) {
 			if (arrayPattern->rest->get_node_type() == ASTNodeType::IdentifierPattern) {
 				const IdentifierPatternNode* restPattern =
-				    dynamic_cast<const IdentifierPatternNode*>(arrayPattern->rest.get());
+				    node_cast<IdentifierPatternNode>(arrayPattern->rest.get());
 				if (restPattern) {
 					// Generate code to slice the remaining elements using runtime utility
 					code += "auto " + restPattern->name + " = ArgonLang::Runtime::destructure_array_rest(" + sourceVar +
@@ -1935,7 +3161,7 @@ Result<std::string> CodeGenerationVisitor::generateDestructuring(const PatternNo
 	}
 
 	case ASTNodeType::StructPattern: {
-		const StructPatternNode* structPattern = dynamic_cast<const StructPatternNode*>(pattern);
+		const StructPatternNode* structPattern = node_cast<StructPatternNode>(pattern);
 		if (!structPattern) {
 			return Err<std::string>(create_parse_error(ErrorType::InvalidCodeGeneration,
 			                                           "Failed to cast to StructPatternNode", pattern->position));
@@ -1948,14 +3174,13 @@ Result<std::string> CodeGenerationVisitor::generateDestructuring(const PatternNo
 
 			if (fieldPattern->get_node_type() == ASTNodeType::IdentifierPattern) {
 				const IdentifierPatternNode* identifierPattern =
-				    dynamic_cast<const IdentifierPatternNode*>(fieldPattern);
+				    node_cast<IdentifierPatternNode>(fieldPattern);
 				if (identifierPattern) {
 					code += "auto " + identifierPattern->name + " = " + sourceVar + "." + fieldName + ";";
 				}
 			} else {
 				// Nested destructuring - create a unique temporary variable for the field
-				std::string fieldVar = "__destructure_field_" + std::to_string(fieldPattern->position.line) + "_" +
-				                       std::to_string(fieldPattern->position.column) + "_" + fieldName;
+				std::string fieldVar = generated_name("__destructure_field");
 				code += "auto " + fieldVar + " = " + sourceVar + "." + fieldName + ";";
 
 				Result<std::string> nestedDestructuring = generateDestructuring(fieldPattern, fieldVar);
@@ -1969,7 +3194,7 @@ Result<std::string> CodeGenerationVisitor::generateDestructuring(const PatternNo
 	}
 
 	case ASTNodeType::IdentifierPattern: {
-		const IdentifierPatternNode* identifierPattern = dynamic_cast<const IdentifierPatternNode*>(pattern);
+		const IdentifierPatternNode* identifierPattern = node_cast<IdentifierPatternNode>(pattern);
 		if (identifierPattern) {
 			code += "auto " + identifierPattern->name + " = " + sourceVar + ";";
 		}
@@ -2017,7 +3242,7 @@ CodeGenerationVisitor::generateCompoundDestructuring(const std::vector<std::uniq
 		                                           patterns[0]->position));
 	}
 
-	const ArrayPatternNode* arrayPattern = dynamic_cast<const ArrayPatternNode*>(patterns[arrayPatternIndex].get());
+	const ArrayPatternNode* arrayPattern = node_cast<ArrayPatternNode>(patterns[arrayPatternIndex].get());
 	if (!arrayPattern) {
 		return Err<std::string>(create_parse_error(ErrorType::InvalidCodeGeneration,
 		                                           "Failed to cast to ArrayPatternNode",
@@ -2033,7 +3258,7 @@ CodeGenerationVisitor::generateCompoundDestructuring(const std::vector<std::uniq
 		for (size_t i = 0; i < arrayElementCount; ++i) {
 			const PatternNode* element = arrayPattern->elements[i].get();
 			if (element->get_node_type() == ASTNodeType::IdentifierPattern) {
-				const IdentifierPatternNode* identifierPattern = dynamic_cast<const IdentifierPatternNode*>(element);
+				const IdentifierPatternNode* identifierPattern = node_cast<IdentifierPatternNode>(element);
 				if (identifierPattern) {
 					code += "auto " + identifierPattern->name + " = " + sourceVar + "[" + std::to_string(i) + "];";
 				}
@@ -2043,7 +3268,7 @@ CodeGenerationVisitor::generateCompoundDestructuring(const std::vector<std::uniq
 		// Generate rest variables (everything after the array elements)
 		for (int restIndex : identifierIndices) {
 			const IdentifierPatternNode* restPattern =
-			    dynamic_cast<const IdentifierPatternNode*>(patterns[restIndex].get());
+			    node_cast<IdentifierPatternNode>(patterns[restIndex].get());
 			if (restPattern) {
 				code += "auto " + restPattern->name + " = std::vector<decltype(" + sourceVar + "[0])>(" + sourceVar +
 				        ".begin() + " + std::to_string(arrayElementCount) + ", " + sourceVar + ".end());";
@@ -2053,7 +3278,7 @@ CodeGenerationVisitor::generateCompoundDestructuring(const std::vector<std::uniq
 		// Pattern: rest, [last] = arr or rest1, rest2, [last] = arr
 		// Generate rest variables first (everything except the last N elements)
 		for (int i = 0; i < arrayPatternIndex; ++i) {
-			const IdentifierPatternNode* restPattern = dynamic_cast<const IdentifierPatternNode*>(patterns[i].get());
+			const IdentifierPatternNode* restPattern = node_cast<IdentifierPatternNode>(patterns[i].get());
 			if (restPattern) {
 				if (i == arrayPatternIndex - 1) {
 					// Last rest pattern gets everything except the array elements at the end
@@ -2072,7 +3297,7 @@ CodeGenerationVisitor::generateCompoundDestructuring(const std::vector<std::uniq
 		for (size_t i = 0; i < arrayElementCount; ++i) {
 			const PatternNode* element = arrayPattern->elements[i].get();
 			if (element->get_node_type() == ASTNodeType::IdentifierPattern) {
-				const IdentifierPatternNode* identifierPattern = dynamic_cast<const IdentifierPatternNode*>(element);
+				const IdentifierPatternNode* identifierPattern = node_cast<IdentifierPatternNode>(element);
 				if (identifierPattern) {
 					// Access from the end: arr[arr.size() - arrayElementCount + i]
 					code += "auto " + identifierPattern->name + " = " + sourceVar + "[" + sourceVar + ".size() - " +
@@ -0,0 +1,40 @@
+#include "frontend/CodeSink.h"
+
+#include <utility>
+
+ArgonLang::CodeSink::CodeSink(std::ostream& stream) : stream(&stream) {}
+
+ArgonLang::CodeSink::~CodeSink() {
+	flush();
+}
+
+void ArgonLang::CodeSink::write(std::string_view text) {
+	written += text.size();
+	if (stream == nullptr) {
+		buffer.append(text);
+		return;
+	}
+	// Large pieces bypass the buffer instead of being copied through it
+	if (buffer.size() + text.size() > FLUSH_SIZE) {
+		flush();
+		if (text.size() >= FLUSH_SIZE) {
+			stream->write(text.data(), static_cast<std::streamsize>(text.size()));
+			return;
+		}
+	}
+	buffer.append(text);
+}
+
+void ArgonLang::CodeSink::flush() {
+	if (stream == nullptr || buffer.empty()) {
+		return;
+	}
+	stream->write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+	buffer.clear();
+}
+
+std::string ArgonLang::CodeSink::take() {
+	std::string code = std::move(buffer);
+	buffer.clear();
+	return code;
+}
@@ -1,16 +1,25 @@
 #include "backend/Parser.h"
-#include "backend/Tokenizer.h"
+#include "backend/SourceBuffer.h"
+#include "backend/TokenStream.h"
 #include "frontend/AnalysisVisitor.h"
 #include "frontend/CodeGenerationVisitor.h"
+#include "Stats/CompilerStats.h"
 
+#include <cstdio>
 #include <fstream>
 #include <iostream>
+#include <optional>
 
 int main(int argc, char** argv) {
 	std::string filename;
 	std::string output_filename = "out.cpp";
 	std::string dot_filename;
+	std::string stats_json_filename;
+	std::string cache_filename;
 	bool verbose = false;
+	bool time_passes = false;
+	bool show_stats = false;
+	bool parallel_codegen = false;
 
 	for (int i = 1; i < argc; ++i) {
 		if (std::string arg = argv[i]; arg == "-o") {
@@ -27,6 +36,24 @@ int main(int argc, char** argv) {
 			dot_filename = argv[++i];
 		} else if (arg == "-v" || arg == "--verbose") {
 			verbose = true;
+		} else if (arg == "--time-passes") {
+			time_passes = true;
+		} else if (arg == "--stats") {
+			show_stats = true;
+		} else if (arg == "-j" || arg == "--parallel-codegen") {
+			parallel_codegen = true;
+		} else if (arg == "--cache") {
+			if (i + 1 >= argc) {
+				std::cerr << "Missing cache filename after " << arg << "\n";
+				return 1;
+			}
+			cache_filename = argv[++i];
+		} else if (arg == "--stats-json") {
+			if (i + 1 >= argc) {
+				std::cerr << "Missing JSON filename after " << arg << "\n";
+				return 1;
+			}
+			stats_json_filename = argv[++i];
 		} else {
 			if (!filename.empty()) {
 				std::cerr << "Unexpected argument: " << arg << "\n";
@@ -36,20 +63,38 @@ int main(int argc, char** argv) {
 		}
 	}
 
-	std::ifstream file(filename);
+	ArgonLang::CompilerStats stats;
 
-	std::string str((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	// Node counting needs every AST node to register itself, so it is only switched on when asked for
+	std::optional<ArgonLang::ASTNodeTracker> nodeTracker;
+	if (show_stats || !stats_json_filename.empty()) {
+		nodeTracker.emplace();
+		nodeTracker->install();
+	}
 
-	auto tokenizeResult = ArgonLang::tokenize(str);
-	if (tokenizeResult.has_error()) {
-		std::cerr << "Tokenization failed: " << tokenizeResult.error_msg << "\n";
-		std::cerr << "At: " << tokenizeResult.error_position.line << ":" << tokenizeResult.error_position.column
-		          << "\n";
+	ArgonLang::Result<ArgonLang::SourceBuffer> source =
+	        stats.time("read", [&] { return ArgonLang::SourceBuffer::open(filename); });
+	if (!source.has_value()) {
+		std::cerr << source.error().message << "\n";
+		return 1;
+	}
+	std::string_view str = source.value().view();
+	stats.set_source_bytes(str.size());
+
+	// Tokens are streamed into the parser, so tokenizing is timed as part of the parse pass
+	ArgonLang::TokenStream tokens(str);
+	ArgonLang::Parser parser(tokens);
+	ArgonLang::Result<std::unique_ptr<ArgonLang::ProgramNode>> program =
+	        stats.time("parse", [&] { return parser.parse(); });
+
+	// A tokenizer error ends the token stream early, so it takes precedence over the parse error that follows
+	if (tokens.has_error()) {
+		std::cerr << "Tokenization failed: " << tokens.get_error_message() << "\n";
+		std::cerr << "At: " << tokens.get_error_position().line << ":" << tokens.get_error_position().column << "\n";
 		return 1;
 	}
 
-	ArgonLang::Parser parser(tokenizeResult.tokens);
-	ArgonLang::Result<std::unique_ptr<ArgonLang::ProgramNode>> program = parser.parse();
+	stats.set_token_count(tokens.get_token_count());
 
 	if (!program.has_value()) {
 		std::cerr << "Parsing error occurred:\n\t" << program.error().message << "\n";
@@ -79,20 +124,56 @@ int main(int argc, char** argv) {
 		return 1;
 	}
 
+	if (nodeTracker) {
+		stats.set_ast_nodes(nodeTracker->created(), nodeTracker->count_by_type());
+		nodeTracker->uninstall();
+	}
+
 	ArgonLang::AnalysisVisitor analysis;
 	ArgonLang::CodeGenerationVisitor codeGenerator;
-	analysis.visit(*program.value());
-	ArgonLang::Result<std::string> codeResult = codeGenerator.visit(*program.value());
+	stats.time("analysis", [&] { analysis.visit(*program.value()); });
+
+	// Declarations whose tokens are unchanged since the last compilation with this cache reuse their code
+	std::optional<ArgonLang::CodeGenerationCache> cache;
+	if (!cache_filename.empty()) {
+		cache = ArgonLang::CodeGenerationCache::load(cache_filename);
+		codeGenerator.cache = &*cache;
+	}
+
+	// Code is written to the output as each top-level declaration is generated, so the pass includes the write
+	std::ofstream codeFile(output_filename);
+	ArgonLang::CodeSink code(codeFile);
+	ArgonLang::Result<void> codeResult =
+	        stats.time("codegen", [&] { return codeGenerator.generate(*program.value(), code, parallel_codegen); });
+	code.flush();
+	codeFile.close();
 
 	if (!codeResult.has_value()) {
 		std::cerr << codeResult.error().message << "\n";
+		std::remove(output_filename.c_str());
 		return 1;
 	}
 
-	std::string code = codeResult.value();
+	stats.set_generated_bytes(code.bytes_written());
 
-	std::ofstream codeFile(output_filename);
-	codeFile << code;
+	if (cache) {
+		if (verbose) {
+			std::cerr << "Reused " << cache->hits() << " of " << cache->hits() + cache->misses()
+			          << " declarations from " << cache_filename << "\n";
+		}
+		if (!cache->save(cache_filename)) {
+			std::cerr << "Could not write cache " << cache_filename << "\n";
+		}
+	}
+
+	if (time_passes || show_stats) {
+		stats.print(std::cerr, show_stats);
+	}
+
+	if (!stats_json_filename.empty()) {
+		std::ofstream statsFile(stats_json_filename);
+		stats.print_json(statsFile);
+	}
 
 	if (!dot_filename.empty()) {
 		std::ofstream dotFile(argv[2]);
@@ -0,0 +1,22 @@
+#include "runtime/ArgonParallel.h"
+
+#include <atomic>
+
+namespace ArgonLang {
+namespace Runtime {
+
+namespace {
+// Below this many elements the chunking overhead outweighs the speedup on typical element-wise work
+std::atomic<std::size_t> threshold{std::size_t{1} << 15};
+} // namespace
+
+std::size_t parallel_threshold() noexcept {
+	return threshold.load(std::memory_order_relaxed);
+}
+
+void set_parallel_threshold(std::size_t value) noexcept {
+	threshold.store(value, std::memory_order_relaxed);
+}
+
+} // namespace Runtime
+} // namespace ArgonLang
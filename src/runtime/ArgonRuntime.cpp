@@ -11,218 +11,259 @@
 
 namespace ArgonLang {
 namespace Runtime {
-// ===== i128 CLASS IMPLEMENTATIONS =====
+// ===== i128/u128 SHARED HELPERS =====
+
+namespace {
 
-I128::I128(const std::string& str) : high(0), low(0) {
-    bool negative = false;
-    size_t start = 0;
-    if (!str.empty() && str[0] == '-') {
-        negative = true;
-        start = 1;
+// Largest power of ten that fits in 64 bits; decimal text is converted in chunks of this many digits
+constexpr int DECIMAL_CHUNK_DIGITS = 19;
+constexpr U64 DECIMAL_CHUNK = 10000000000000000000ULL;
+
+constexpr std::array<U64, DECIMAL_CHUNK_DIGITS + 1> POWERS_OF_TEN = [] {
+    std::array<U64, DECIMAL_CHUNK_DIGITS + 1> powers{};
+    powers[0] = 1;
+    for (int i = 1; i <= DECIMAL_CHUNK_DIGITS; ++i) {
+        powers[i] = powers[i - 1] * 10;
     }
-    
+    return powers;
+}();
+
+// Parses the decimal digits of str (other characters are skipped), 19 digits per multiply-add
+U128 parse_decimal(const std::string& str, size_t start) {
+    U128 value;
+    U64 chunk = 0;
+    int digits = 0;
     for (size_t i = start; i < str.length(); ++i) {
-        if (str[i] >= '0' && str[i] <= '9') {
-            *this = *this * I128(10) + I128(static_cast<I64>(str[i] - '0'));
+        if (str[i] < '0' || str[i] > '9') {
+            continue;
+        }
+        chunk = chunk * 10 + static_cast<U64>(str[i] - '0');
+        if (++digits == DECIMAL_CHUNK_DIGITS) {
+            value = value * U128(DECIMAL_CHUNK) + U128(chunk);
+            chunk = 0;
+            digits = 0;
         }
     }
-    
-    if (negative) {
-        *this = -*this;
+    if (digits > 0) {
+        value = value * U128(POWERS_OF_TEN[digits]) + U128(chunk);
     }
+    return value;
 }
 
-I128::operator int64_t() const {
-    return static_cast<int64_t>(low);
-}
+// Formats value in base 10^19: at most three divisions by a precomputed reciprocal, then 19 digits per chunk
+std::string format_decimal(const U128& value, bool negative) {
+    static const U64Divisor chunk_divisor(DECIMAL_CHUNK);
 
-I128::operator double() const {
-    double result = static_cast<double>(low);
-    result += static_cast<double>(high) * 18446744073709551616.0; // 2^64
-    return result;
-}
+    char buffer[41];
+    char* end = buffer + sizeof(buffer);
+    char* out = end;
 
-I128 I128::operator+(const I128& other) const {
-    U64 new_low = low + other.low;
-    I64 new_high = high + other.high;
-    if (new_low < low) { // Overflow in low part
-        new_high++;
+    U128 rest = value;
+    for (;;) {
+        U64 chunk;
+        rest = chunk_divisor.divide(rest, chunk);
+        if (rest.is_zero()) {
+            do {
+                *--out = static_cast<char>('0' + chunk % 10);
+                chunk /= 10;
+            } while (chunk != 0);
+            break;
+        }
+        for (int i = 0; i < DECIMAL_CHUNK_DIGITS; ++i) {
+            *--out = static_cast<char>('0' + chunk % 10);
+            chunk /= 10;
+        }
     }
-    return I128(new_high, new_low);
-}
 
-I128 I128::operator-(const I128& other) const {
-    U64 new_low = low - other.low;
-    I64 new_high = high - other.high;
-    if (new_low > low) { // Underflow in low part
-        new_high--;
+    if (negative) {
+        *--out = '-';
     }
-    return I128(new_high, new_low);
+    return std::string(out, end);
 }
 
-I128 I128::operator*(const I128& other) const {
-    // Convert to unsigned for multiplication, then handle sign
-    bool neg_result = (is_negative() != other.is_negative());
-    
-    // Get absolute values as u128
-    U128 a_abs, b_abs;
-    if (is_negative()) {
-        I128 abs_this = -*this;
-        a_abs = U128(static_cast<U64>(abs_this.high), abs_this.low);
-    } else {
-        a_abs = U128(static_cast<U64>(high), low);
-    }
-    
-    if (other.is_negative()) {
-        I128 abs_other = -other;
-        b_abs = U128(static_cast<U64>(abs_other.high), abs_other.low);
-    } else {
-        b_abs = U128(static_cast<U64>(other.high), other.low);
+} // namespace
+
+namespace detail {
+
+U64 divide_2by1(U64 high, U64 low, U64 divisor, U64& remainder) {
+#if ARGON_HAS_INT128
+    unsigned __int128 dividend = (static_cast<unsigned __int128>(high) << 64) | low;
+    remainder = static_cast<U64>(dividend % divisor);
+    return static_cast<U64>(dividend / divisor);
+#else
+    // Knuth's algorithm D on 32-bit digits (Hacker's Delight, divlu)
+    constexpr U64 base = U64{1} << 32;
+    int shift = count_leading_zeros(divisor);
+    divisor <<= shift;
+    U64 divisor_high = divisor >> 32;
+    U64 divisor_low = divisor & 0xFFFFFFFFULL;
+
+    U64 numerator_high = shift ? (high << shift) | (low >> (64 - shift)) : high;
+    U64 numerator_low = low << shift;
+    U64 digit1 = numerator_low >> 32;
+    U64 digit0 = numerator_low & 0xFFFFFFFFULL;
+
+    U64 quotient1 = numerator_high / divisor_high;
+    U64 partial = numerator_high - quotient1 * divisor_high;
+    while (quotient1 >= base || quotient1 * divisor_low > base * partial + digit1) {
+        --quotient1;
+        partial += divisor_high;
+        if (partial >= base) break;
     }
-    
-    U128 result = a_abs * b_abs;
-    
-    if (neg_result) {
-        // Negate result
-        U128 neg_result_u = U128(~result.high, ~result.low) + U128(1ULL);
-        return I128(-static_cast<I64>(neg_result_u.high), neg_result_u.low);
-    } else {
-        return I128(static_cast<I64>(result.high), result.low);
+
+    U64 middle = numerator_high * base + digit1 - quotient1 * divisor;
+    U64 quotient0 = middle / divisor_high;
+    partial = middle - quotient0 * divisor_high;
+    while (quotient0 >= base || quotient0 * divisor_low > base * partial + digit0) {
+        --quotient0;
+        partial += divisor_high;
+        if (partial >= base) break;
     }
+
+    remainder = (middle * base + digit0 - quotient0 * divisor) >> shift;
+    return quotient1 * base + quotient0;
+#endif
 }
 
-I128 I128::operator/(const I128& other) const {
-    if (other.is_zero()) {
+} // namespace detail
+
+// ===== U64Divisor IMPLEMENTATION =====
+
+U64Divisor::U64Divisor(U64 divisor) {
+    if (divisor == 0) {
         throw std::runtime_error("Division by zero");
     }
-    
-    // Handle simple cases
-    if (other.high == 0 && other.low == 1) {
-        return *this;
-    }
-    if (*this == other) {
-        return I128(1);
-    }
-    if (is_zero()) {
-        return I128(0);
-    }
-    
-    // Get absolute values
-    bool neg_result = (is_negative() != other.is_negative());
-    U128 dividend_abs, divisor_abs;
-    
-    if (is_negative()) {
-        I128 abs_this = -*this;
-        dividend_abs = U128(static_cast<U64>(abs_this.high), abs_this.low);
-    } else {
-        dividend_abs = U128(static_cast<U64>(high), low);
-    }
-    
-    if (other.is_negative()) {
-        I128 abs_other = -other;
-        divisor_abs = U128(static_cast<U64>(abs_other.high), abs_other.low);
-    } else {
-        divisor_abs = U128(static_cast<U64>(other.high), other.low);
-    }
-    
-    U128 quotient = dividend_abs / divisor_abs;
-    
-    if (neg_result) {
-        // Negate quotient
-        U128 neg_quotient = U128(~quotient.high, ~quotient.low) + U128(1ULL);
-        return I128(-static_cast<I64>(neg_quotient.high), neg_quotient.low);
-    } else {
-        return I128(static_cast<I64>(quotient.high), quotient.low);
-    }
+    shift_ = detail::count_leading_zeros(divisor);
+    normalized_ = divisor << shift_;
+    // floor((2^128 - 1) / d) - 2^64, which fits in 64 bits because d has its top bit set
+    U64 unused;
+    reciprocal_ = detail::divide_2by1(~normalized_, ~U64{0}, normalized_, unused);
 }
 
-I128 I128::operator%(const I128& other) const {
-    if (other.is_zero()) {
-        throw std::runtime_error("Modulo by zero");
-    }
-    
-    // Get absolute values
-    bool neg_result = is_negative();
-    U128 dividend_abs, divisor_abs;
-    
-    if (is_negative()) {
-        I128 abs_this = -*this;
-        dividend_abs = U128(static_cast<U64>(abs_this.high), abs_this.low);
-    } else {
-        dividend_abs = U128(static_cast<U64>(high), low);
-    }
-    
-    if (other.is_negative()) {
-        I128 abs_other = -other;
-        divisor_abs = U128(static_cast<U64>(abs_other.high), abs_other.low);
-    } else {
-        divisor_abs = U128(static_cast<U64>(other.high), other.low);
-    }
-    
-    U128 remainder = dividend_abs % divisor_abs;
-    
-    if (neg_result && !remainder.is_zero()) {
-        // Negate remainder
-        U128 neg_remainder = U128(~remainder.high, ~remainder.low) + U128(1ULL);
-        return I128(-static_cast<I64>(neg_remainder.high), neg_remainder.low);
-    } else {
-        return I128(static_cast<I64>(remainder.high), remainder.low);
-    }
+// ===== i128 CLASS IMPLEMENTATIONS =====
+
+I128::I128(const std::string& str) : I128() {
+    bool negative = !str.empty() && str[0] == '-';
+    U128 magnitude = parse_decimal(str, negative ? 1 : 0);
+    *this = from_bits(negative ? U128(0u) - magnitude : magnitude);
 }
 
-I128 I128::operator-() const {
-    if (is_zero()) {
-        return I128(0);
-    }
-    I128 result(~high, ~low);
-    return result + I128(1);
+std::string I128::to_string() const {
+    U128 bits = to_bits();
+    return format_decimal(is_negative() ? U128(0u) - bits : bits, is_negative());
 }
 
-I128& I128::operator+=(const I128& other) {
-    *this = *this + other;
-    return *this;
+std::ostream& operator<<(std::ostream& os, const I128& val) {
+    return os << val.to_string();
+}
+
+std::istream& operator>>(std::istream& is, I128& val) {
+    std::string str;
+    is >> str;
+    val = I128(str);
+    return is;
+}
+
+// ===== u128 CLASS IMPLEMENTATIONS =====
+
+U128::U128(const std::string& str) : U128(parse_decimal(str, 0)) {}
+
+std::string U128::to_string() const {
+    return format_decimal(*this, false);
+}
+
+std::ostream& operator<<(std::ostream& os, const U128& val) {
+    return os << val.to_string();
+}
+
+std::istream& operator>>(std::istream& is, U128& val) {
+    std::string str;
+    is >> str;
+    val = U128(str);
+    return is;
 }
 
-I128& I128::operator-=(const I128& other) {
-    *this = *this - other;
-    return *this;
+#if !ARGON_HAS_INT128
+// ===== TWO-WORD FALLBACK FOR TARGETS WITHOUT __int128 =====
+
+namespace {
+
+// Unsigned 128-by-128 division, stores the remainder
+U128 divide_unsigned(const U128& dividend, const U128& divisor, U128& remainder) {
+    if (divisor.high_word() == 0) {
+        U64 divisor_low = divisor.low_word();
+        U64 quotient_high = dividend.high_word() / divisor_low;
+        U64 rest = dividend.high_word() % divisor_low;
+        U64 quotient_low = detail::divide_2by1(rest, dividend.low_word(), divisor_low, rest);
+        remainder = U128(rest);
+        return U128(quotient_high, quotient_low);
+    }
+
+    // Divisor has at least 65 significant bits, so the quotient fits in 64 bits (Hacker's Delight, divlu128)
+    int shift = detail::count_leading_zeros(divisor.high_word());
+    U64 divisor_top = (divisor << shift).high_word();
+    U128 halved = dividend >> 1;
+    U64 unused;
+    U64 estimate = detail::divide_2by1(halved.high_word(), halved.low_word(), divisor_top, unused);
+    U128 quotient = (U128(estimate) << shift) >> 63;
+    if (!quotient.is_zero()) {
+        --quotient;
+    }
+    remainder = dividend - quotient * divisor;
+    if (remainder >= divisor) {
+        ++quotient;
+        remainder -= divisor;
+    }
+    return quotient;
 }
 
-I128& I128::operator*=(const I128& other) {
-    *this = *this * other;
-    return *this;
+} // namespace
+
+I128::operator double() const {
+    if (is_negative()) {
+        return -static_cast<double>(U128(0u) - to_bits());
+    }
+    return static_cast<double>(to_bits());
 }
 
-I128& I128::operator/=(const I128& other) {
-    *this = *this / other;
-    return *this;
+// Addition, subtraction and multiplication are sign-agnostic on the two's complement bit pattern
+I128 I128::operator+(const I128& other) const {
+    return from_bits(to_bits() + other.to_bits());
 }
 
-I128& I128::operator%=(const I128& other) {
-    *this = *this % other;
-    return *this;
+I128 I128::operator-(const I128& other) const {
+    return from_bits(to_bits() - other.to_bits());
 }
 
-I128& I128::operator++() {
-    *this = *this + I128(1);
-    return *this;
+I128 I128::operator*(const I128& other) const {
+    return from_bits(to_bits() * other.to_bits());
 }
 
-I128 I128::operator++(int) {
-    I128 temp(*this);
-    ++(*this);
-    return temp;
+I128 I128::operator-() const {
+    return from_bits(U128(0u) - to_bits());
 }
 
-I128& I128::operator--() {
-    *this = *this - I128(1);
-    return *this;
+I128 I128::operator/(const I128& other) const {
+    if (other.is_zero()) {
+        throw std::runtime_error("Division by zero");
+    }
+    U128 dividend = is_negative() ? U128(0u) - to_bits() : to_bits();
+    U128 divisor = other.is_negative() ? U128(0u) - other.to_bits() : other.to_bits();
+    U128 remainder;
+    U128 quotient = divide_unsigned(dividend, divisor, remainder);
+    return from_bits(is_negative() != other.is_negative() ? U128(0u) - quotient : quotient);
 }
 
-I128 I128::operator--(int) {
-    I128 temp(*this);
-    --(*this);
-    return temp;
+I128 I128::operator%(const I128& other) const {
+    if (other.is_zero()) {
+        throw std::runtime_error("Modulo by zero");
+    }
+    U128 dividend = is_negative() ? U128(0u) - to_bits() : to_bits();
+    U128 divisor = other.is_negative() ? U128(0u) - other.to_bits() : other.to_bits();
+    U128 remainder;
+    divide_unsigned(dividend, divisor, remainder);
+    // The remainder takes the sign of the dividend
+    return from_bits(is_negative() ? U128(0u) - remainder : remainder);
 }
 
 I128 I128::operator&(const I128& other) const {
@@ -244,67 +285,23 @@ I128 I128::operator~() const {
 I128 I128::operator<<(int shift) const {
     if (shift <= 0) return *this;
     if (shift >= 128) return I128(0);
-    
-    if (shift < 64) {
-        U64 new_low = low << shift;
-        I64 new_high = (high << shift) | static_cast<I64>(low >> (64 - shift));
-        return I128(new_high, new_low);
-    } else {
-        I64 new_high = static_cast<I64>(low << (shift - 64));
-        return I128(new_high, 0);
-    }
+    return from_bits(to_bits() << shift);
 }
 
 I128 I128::operator>>(int shift) const {
     if (shift <= 0) return *this;
-    if (shift >= 128) return is_negative() ? I128(-1, 0xFFFFFFFFFFFFFFFFULL) : I128(0);
-    
-    if (shift < 64) {
-        U64 new_low = (low >> shift) | (static_cast<U64>(high) << (64 - shift));
-        I64 new_high = high >> shift;
-        return I128(new_high, new_low);
-    } else {
-        U64 new_low = static_cast<U64>(high >> (shift - 64));
-        if (is_negative()) {
-            new_low |= 0xFFFFFFFFFFFFFFFFULL << (128 - shift);
-        }
-        return I128(is_negative() ? -1 : 0, new_low);
+    if (shift >= 128) return I128(is_negative() ? -1 : 0);
+    if (shift >= 64) {
+        return I128(high < 0 ? -1 : 0, static_cast<U64>(high >> (shift - 64)));
     }
-}
-
-I128& I128::operator&=(const I128& other) {
-    *this = *this & other;
-    return *this;
-}
-
-I128& I128::operator|=(const I128& other) {
-    *this = *this | other;
-    return *this;
-}
-
-I128& I128::operator^=(const I128& other) {
-    *this = *this ^ other;
-    return *this;
-}
-
-I128& I128::operator<<=(int shift) {
-    *this = *this << shift;
-    return *this;
-}
-
-I128& I128::operator>>=(int shift) {
-    *this = *this >> shift;
-    return *this;
+    U64 new_low = (low >> shift) | (static_cast<U64>(high) << (64 - shift));
+    return I128(high >> shift, new_low);
 }
 
 bool I128::operator==(const I128& other) const {
     return high == other.high && low == other.low;
 }
 
-bool I128::operator!=(const I128& other) const {
-    return !(*this == other);
-}
-
 bool I128::operator<(const I128& other) const {
     if (high != other.high) {
         return high < other.high;
@@ -312,57 +309,12 @@ bool I128::operator<(const I128& other) const {
     return low < other.low;
 }
 
-bool I128::operator>(const I128& other) const {
-    return other < *this;
+U128 I128::to_bits() const {
+    return U128(static_cast<U64>(high), low);
 }
 
-bool I128::operator<=(const I128& other) const {
-    return !(*this > other);
-}
-
-bool I128::operator>=(const I128& other) const {
-    return !(*this < other);
-}
-
-std::string I128::to_string() const {
-    if (is_zero()) return "0";
-    
-    I128 temp = is_negative() ? -*this : *this;
-    std::string result;
-    
-    while (!temp.is_zero()) {
-        I128 remainder = temp % I128(10);
-        result = char('0' + static_cast<int>(remainder.low)) + result;
-        temp = temp / I128(10);
-    }
-    
-    if (is_negative()) result = "-" + result;
-    return result;
-}
-
-std::ostream& operator<<(std::ostream& os, const I128& val) {
-    return os << val.to_string();
-}
-
-std::istream& operator>>(std::istream& is, I128& val) {
-    std::string str;
-    is >> str;
-    val = I128(str);
-    return is;
-}
-
-// ===== u128 CLASS IMPLEMENTATIONS =====
-
-U128::U128(const std::string& str) : high(0), low(0) {
-    for (char c : str) {
-        if (c >= '0' && c <= '9') {
-            *this = *this * U128(10ULL) + U128(static_cast<U64>(c - '0'));
-        }
-    }
-}
-
-U128::operator uint64_t() const {
-    return low;
+I128 I128::from_bits(const U128& bits) {
+    return I128(static_cast<I64>(bits.high), bits.low);
 }
 
 U128::operator double() const {
@@ -390,47 +342,11 @@ U128 U128::operator-(const U128& other) const {
 }
 
 U128 U128::operator*(const U128& other) const {
-    // Use 64x64 -> 128 bit multiplication
-    // (a.high * 2^64 + a.low) * (b.high * 2^64 + b.low)
-    // = a.high * b.high * 2^128 + (a.high * b.low + a.low * b.high) * 2^64 + a.low * b.low
-    
-    // We can ignore a.high * b.high * 2^128 as it overflows 128 bits
-    
-    // Multiply low parts: a.low * b.low -> 128 bits
-    U64 a_low_low = low & 0xFFFFFFFFULL;
-    U64 a_low_high = low >> 32;
-    U64 b_low_low = other.low & 0xFFFFFFFFULL;
-    U64 b_low_high = other.low >> 32;
-    
-    U64 p0 = a_low_low * b_low_low;
-    U64 p1 = a_low_low * b_low_high + a_low_high * b_low_low;
-    U64 p2 = a_low_high * b_low_high;
-    
-    U64 carry = p1 >> 32;
-    U64 new_low = p0 + (p1 << 32);
-    if (new_low < p0) carry++;
-    
-    U64 mid = p2 + carry;
-    carry = mid >> 32;
-    new_low += (mid << 32);
-    if (new_low < (mid << 32)) carry++;
-    
-    // Add cross terms: a.high * b.low + a.low * b.high
-    U64 cross1 = high * other.low;
-    U64 cross2 = low * other.high;
-    
-    U64 new_high = cross1 + cross2 + carry;
-    if (new_high < cross1) {
-        // Overflow in high part - this means result > 2^128, but we'll cap it
-    }
-    
-    // Add low part of cross terms to new_low
-    U64 cross_low = (cross1 & 0xFFFFFFFFULL) + (cross2 & 0xFFFFFFFFULL);
-    new_low += cross_low;
-    if (new_low < cross_low) {
-        new_high++;
-    }
-    
+    // (a.high * 2^64 + a.low) * (b.high * 2^64 + b.low) mod 2^128
+    // = full(a.low * b.low) + ((a.high * b.low + a.low * b.high) mod 2^64) * 2^64
+    U64 new_high;
+    U64 new_low = detail::multiply_64x64(low, other.low, new_high);
+    new_high += high * other.low + low * other.high;
     return U128(new_high, new_low);
 }
 
@@ -438,119 +354,19 @@ U128 U128::operator/(const U128& other) const {
     if (other.is_zero()) {
         throw std::runtime_error("Division by zero");
     }
-    
-    if (other.high == 0 && other.low == 1) {
-        return *this;
-    }
-    if (*this == other) {
-        return U128(1ULL);
-    }
-    if (is_zero()) {
-        return U128(0ULL);
-    }
-    
-    if (*this < other) {
-        return U128(0ULL);
-    }
-    
-    // Binary long division
-    U128 quotient(0ULL);
-    U128 remainder(0ULL);
-    
-    for (int i = 127; i >= 0; --i) {
-        remainder = remainder << 1;
-        U128 shifted = *this >> i;
-        if (shifted.low & 1) {
-            remainder.low |= 1;
-        }
-        
-        if (remainder >= other) {
-            remainder = remainder - other;
-            if (i >= 64) {
-                quotient.high |= 1ULL << (i - 64);
-            } else {
-                quotient.low |= 1ULL << i;
-            }
-        }
-    }
-    
-    return quotient;
+    U128 remainder;
+    return divide_unsigned(*this, other, remainder);
 }
 
 U128 U128::operator%(const U128& other) const {
     if (other.is_zero()) {
         throw std::runtime_error("Modulo by zero");
     }
-    
-    if (*this < other) {
-        return *this;
-    }
-    
-    // Binary long division to get remainder
-    U128 remainder(0ULL);
-    
-    for (int i = 127; i >= 0; --i) {
-        remainder = remainder << 1;
-        U128 shifted = *this >> i;
-        if (shifted.low & 1) {
-            remainder.low |= 1;
-        }
-        
-        if (remainder >= other) {
-            remainder = remainder - other;
-        }
-    }
-    
+    U128 remainder;
+    divide_unsigned(*this, other, remainder);
     return remainder;
 }
 
-U128& U128::operator+=(const U128& other) {
-    *this = *this + other;
-    return *this;
-}
-
-U128& U128::operator-=(const U128& other) {
-    *this = *this - other;
-    return *this;
-}
-
-U128& U128::operator*=(const U128& other) {
-    *this = *this * other;
-    return *this;
-}
-
-U128& U128::operator/=(const U128& other) {
-    *this = *this / other;
-    return *this;
-}
-
-U128& U128::operator%=(const U128& other) {
-    *this = *this % other;
-    return *this;
-}
-
-U128& U128::operator++() {
-    *this = *this + U128(1ULL);
-    return *this;
-}
-
-U128 U128::operator++(int) {
-    U128 temp(*this);
-    ++(*this);
-    return temp;
-}
-
-U128& U128::operator--() {
-    *this = *this - U128(1ULL);
-    return *this;
-}
-
-U128 U128::operator--(int) {
-    U128 temp(*this);
-    --(*this);
-    return temp;
-}
-
 U128 U128::operator&(const U128& other) const {
     return U128(high & other.high, low & other.low);
 }
@@ -569,142 +385,36 @@ U128 U128::operator~() const {
 
 U128 U128::operator<<(int shift) const {
     if (shift <= 0) return *this;
-    if (shift >= 128) return U128(0ULL);
-    
-    if (shift < 64) {
-        U64 new_low = low << shift;
-        U64 new_high = (high << shift) | (low >> (64 - shift));
-        return U128(new_high, new_low);
-    } else {
-        U64 new_high = low << (shift - 64);
-        return U128(new_high, 0);
+    if (shift >= 128) return U128(0u);
+    if (shift >= 64) {
+        return U128(low << (shift - 64), 0);
     }
+    return U128((high << shift) | (low >> (64 - shift)), low << shift);
 }
 
 U128 U128::operator>>(int shift) const {
     if (shift <= 0) return *this;
-    if (shift >= 128) return U128(0ULL);
-    
-    if (shift < 64) {
-        U64 new_low = (low >> shift) | (high << (64 - shift));
-        U64 new_high = high >> shift;
-        return U128(new_high, new_low);
-    } else {
-        U64 new_low = high >> (shift - 64);
-        return U128(0, new_low);
+    if (shift >= 128) return U128(0u);
+    if (shift >= 64) {
+        return U128(0, high >> (shift - 64));
     }
-}
-
-U128& U128::operator&=(const U128& other) {
-    *this = *this & other;
-    return *this;
-}
-
-U128& U128::operator|=(const U128& other) {
-    *this = *this | other;
-    return *this;
-}
-
-U128& U128::operator^=(const U128& other) {
-    *this = *this ^ other;
-    return *this;
-}
-
-U128& U128::operator<<=(int shift) {
-    *this = *this << shift;
-    return *this;
-}
-
-U128& U128::operator>>=(int shift) {
-    *this = *this >> shift;
-    return *this;
+    return U128(high >> shift, (low >> shift) | (high << (64 - shift)));
 }
 
 bool U128::operator==(const U128& other) const {
     return high == other.high && low == other.low;
 }
 
-bool U128::operator!=(const U128& other) const {
-    return !(*this == other);
-}
-
 bool U128::operator<(const U128& other) const {
     if (high != other.high) {
         return high < other.high;
     }
     return low < other.low;
 }
-
-bool U128::operator>(const U128& other) const {
-    return other < *this;
-}
-
-bool U128::operator<=(const U128& other) const {
-    return !(*this > other);
-}
-
-bool U128::operator>=(const U128& other) const {
-    return !(*this < other);
-}
-
-std::string U128::to_string() const {
-    if (is_zero()) return "0";
-    
-    U128 temp = *this;
-    std::string result;
-    
-    while (!temp.is_zero()) {
-        U128 remainder = temp % U128(10ULL);
-        result = char('0' + static_cast<int>(remainder.low)) + result;
-        temp = temp / U128(10ULL);
-    }
-    
-    return result;
-}
-
-std::ostream& operator<<(std::ostream& os, const U128& val) {
-    return os << val.to_string();
-}
-
-std::istream& operator>>(std::istream& is, U128& val) {
-    std::string str;
-    is >> str;
-    val = U128(str);
-    return is;
-}
-
-// Thread-local scope manager stack definition
-thread_local std::vector<std::shared_ptr<ScopeManager>> scope_stack;
+#endif
 
 // ===== TEMPLATE FUNCTION IMPLEMENTATIONS =====
 
-// Functional programming utilities
-template<typename Container, typename Predicate>
-std::decay_t<Container> filter(Container&& container, Predicate&& predicate) {
-	auto result = std::decay_t<Container>{};
-	std::copy_if(container.begin(), container.end(), std::back_inserter(result), std::forward<Predicate>(predicate));
-	return result;
-}
-
-template<typename Container, typename Transform>
-std::decay_t<Container> map(Container&& container, Transform&& transform) {
-	auto result = std::decay_t<Container>{};
-	std::transform(container.begin(), container.end(), std::back_inserter(result), std::forward<Transform>(transform));
-	return result;
-}
-
-template<typename Container, typename Reducer>
-typename std::decay_t<Container>::value_type reduce(Container&& container, Reducer&& reducer) {
-	using ValueType = typename std::decay_t<Container>::value_type;
-	return std::accumulate(container.begin(), container.end(), ValueType{}, std::forward<Reducer>(reducer));
-}
-
-template<typename Container, typename Transform>
-Container& map_pipe(Container& container, Transform&& transform) {
-	std::transform(container.begin(), container.end(), container.begin(), std::forward<Transform>(transform));
-	return container;
-}
-
 // Pattern matching utilities
 template<typename T, typename... Cases>
 auto match(T&& value, Cases&&... cases) {
@@ -794,24 +504,6 @@ bool match_range_double(double value, double start, double end, bool inclusive)
 
 // ===== EXPLICIT TEMPLATE INSTANTIATIONS FOR COMMON TYPES =====
 
-// Functional operators for std::vector<int>
-template std::vector<int> filter(std::vector<int>&& container, std::function<bool(int)>&& predicate);
-template std::vector<int> filter(const std::vector<int>& container, std::function<bool(int)>&& predicate);
-template std::vector<int> map(std::vector<int>&& container, std::function<int(int)>&& transform);
-template std::vector<int> map(const std::vector<int>& container, std::function<int(int)>&& transform);
-template int reduce(std::vector<int>&& container, std::function<int(int, int)>&& reducer);
-template int reduce(const std::vector<int>& container, std::function<int(int, int)>&& reducer);
-template std::vector<int>& map_pipe(std::vector<int>& container, std::function<int(int)>&& transform);
-
-// Functional operators for std::vector<float>
-template std::vector<float> filter(std::vector<float>&& container, std::function<bool(float)>&& predicate);
-template std::vector<float> filter(const std::vector<float>& container, std::function<bool(float)>&& predicate);
-template std::vector<float> map(std::vector<float>&& container, std::function<float(float)>&& transform);
-template std::vector<float> map(const std::vector<float>& container, std::function<float(float)>&& transform);
-template float reduce(std::vector<float>&& container, std::function<float(float, float)>&& reducer);
-template float reduce(const std::vector<float>& container, std::function<float(float, float)>&& reducer);
-template std::vector<float>& map_pipe(std::vector<float>& container, std::function<float(float)>&& transform);
-
 // Destructuring for std::vector<int>
 template int destructure_array_element(std::vector<int>&& container, size_t index);
 template int destructure_array_element(const std::vector<int>& container, size_t index);
@@ -0,0 +1,306 @@
+#include "runtime/ArgonScheduler.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace ArgonLang {
+namespace Runtime {
+
+namespace {
+// Identifies the worker running on the current thread
+thread_local const Scheduler* current_scheduler = nullptr;
+thread_local int current_worker = -1;
+
+// Cheap per-thread generator used to pick steal victims
+thread_local std::uint32_t steal_seed = 0x9E3779B9u;
+
+std::uint32_t next_victim_seed() {
+	steal_seed ^= steal_seed << 13;
+	steal_seed ^= steal_seed >> 17;
+	steal_seed ^= steal_seed << 5;
+	return steal_seed;
+}
+
+constexpr int SPINS_BEFORE_SLEEP = 64;
+} // namespace
+
+// ===== WorkStealingDeque =====
+
+WorkStealingDeque::Buffer::Buffer(std::int64_t capacity)
+    : capacity(capacity), mask(capacity - 1), slots(new std::atomic<Task*>[capacity]) {}
+
+Task* WorkStealingDeque::Buffer::get(std::int64_t index) const noexcept {
+	return slots[index & mask].load(std::memory_order_relaxed);
+}
+
+void WorkStealingDeque::Buffer::put(std::int64_t index, Task* task) noexcept {
+	slots[index & mask].store(task, std::memory_order_relaxed);
+}
+
+WorkStealingDeque::WorkStealingDeque(std::size_t capacity) {
+	std::size_t rounded = 1;
+	while (rounded < capacity) {
+		rounded <<= 1;
+	}
+	buffer_.store(new Buffer(static_cast<std::int64_t>(rounded)), std::memory_order_relaxed);
+}
+
+WorkStealingDeque::~WorkStealingDeque() {
+	delete buffer_.load(std::memory_order_relaxed);
+}
+
+void WorkStealingDeque::push(Task* task) {
+	std::int64_t bottom = bottom_.load(std::memory_order_relaxed);
+	std::int64_t top = top_.load(std::memory_order_acquire);
+	Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+
+	if (bottom - top > buffer->capacity - 1) {
+		auto grown = std::make_unique<Buffer>(buffer->capacity * 2);
+		for (std::int64_t i = top; i < bottom; ++i) {
+			grown->put(i, buffer->get(i));
+		}
+		retired_.emplace_back(buffer);
+		buffer = grown.release();
+		buffer_.store(buffer, std::memory_order_release);
+	}
+
+	buffer->put(bottom, task);
+	bottom_.store(bottom + 1, std::memory_order_release);
+}
+
+Task* WorkStealingDeque::pop() {
+	std::int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+	Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+	bottom_.store(bottom, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	std::int64_t top = top_.load(std::memory_order_relaxed);
+
+	if (top > bottom) {
+		// Deque was already empty
+		bottom_.store(bottom + 1, std::memory_order_relaxed);
+		return nullptr;
+	}
+
+	Task* task = buffer->get(bottom);
+	if (top == bottom) {
+		// Last element: race against thieves for it
+		if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+			task = nullptr;
+		}
+		bottom_.store(bottom + 1, std::memory_order_relaxed);
+	}
+	return task;
+}
+
+Task* WorkStealingDeque::steal() {
+	while (true) {
+		std::int64_t top = top_.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		std::int64_t bottom = bottom_.load(std::memory_order_acquire);
+
+		if (top >= bottom) {
+			return nullptr;
+		}
+
+		Buffer* buffer = buffer_.load(std::memory_order_acquire);
+		Task* task = buffer->get(top);
+		if (top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+			return task;
+		}
+		// Lost the race against another thief or the owner; retry
+	}
+}
+
+bool WorkStealingDeque::empty() const noexcept {
+	std::int64_t bottom = bottom_.load(std::memory_order_acquire);
+	std::int64_t top = top_.load(std::memory_order_acquire);
+	return top >= bottom;
+}
+
+// ===== Scheduler =====
+
+Scheduler::Scheduler(std::size_t worker_count) {
+	worker_count = std::max<std::size_t>(worker_count, 1);
+	workers_.reserve(worker_count);
+	for (std::size_t i = 0; i < worker_count; ++i) {
+		workers_.push_back(std::make_unique<Worker>());
+	}
+	for (std::size_t i = 0; i < worker_count; ++i) {
+		workers_[i]->thread = std::thread([this, i]() { worker_loop(i); });
+	}
+}
+
+Scheduler::~Scheduler() {
+	{
+		std::lock_guard<std::mutex> lock(sleep_mutex_);
+		stopping_.store(true, std::memory_order_seq_cst);
+	}
+	sleep_cv_.notify_all();
+
+	for (auto& worker : workers_) {
+		if (worker->thread.joinable()) {
+			worker->thread.join();
+		}
+	}
+
+	// Drop anything that never ran
+	for (auto& worker : workers_) {
+		while (Task* task = worker->deque.pop()) {
+			task->release();
+		}
+	}
+	for (Task* task : injection_queue_) {
+		task->release();
+	}
+}
+
+Scheduler& Scheduler::instance() {
+	static Scheduler scheduler(std::thread::hardware_concurrency());
+	return scheduler;
+}
+
+int Scheduler::current_worker_index() const noexcept {
+	return current_scheduler == this ? current_worker : -1;
+}
+
+void Scheduler::submit(Task* task) {
+	int index = current_worker_index();
+	if (index >= 0) {
+		workers_[index]->deque.push(task);
+	} else {
+		std::lock_guard<std::mutex> lock(injection_mutex_);
+		injection_queue_.push_back(task);
+		injected_count_.fetch_add(1, std::memory_order_release);
+	}
+	notify_workers();
+}
+
+void Scheduler::notify_workers() {
+	epoch_.fetch_add(1, std::memory_order_seq_cst);
+	if (sleepers_.load(std::memory_order_seq_cst) > 0) {
+		std::lock_guard<std::mutex> lock(sleep_mutex_);
+		sleep_cv_.notify_one();
+	}
+}
+
+Task* Scheduler::pop_injected() {
+	if (injected_count_.load(std::memory_order_acquire) == 0) {
+		return nullptr;
+	}
+	std::lock_guard<std::mutex> lock(injection_mutex_);
+	if (injection_queue_.empty()) {
+		return nullptr;
+	}
+	Task* task = injection_queue_.front();
+	injection_queue_.pop_front();
+	injected_count_.fetch_sub(1, std::memory_order_relaxed);
+	return task;
+}
+
+Task* Scheduler::steal_from_others(int index) {
+	std::size_t count = workers_.size();
+	std::size_t start = next_victim_seed() % count;
+	for (std::size_t i = 0; i < count; ++i) {
+		std::size_t victim = (start + i) % count;
+		if (static_cast<int>(victim) == index) {
+			continue;
+		}
+		if (Task* task = workers_[victim]->deque.steal()) {
+			return task;
+		}
+	}
+	return nullptr;
+}
+
+Task* Scheduler::find_work(int index) {
+	if (index >= 0) {
+		if (Task* task = workers_[index]->deque.pop()) {
+			return task;
+		}
+	}
+	if (Task* task = pop_injected()) {
+		return task;
+	}
+	return steal_from_others(index);
+}
+
+void Scheduler::execute(Task* task) {
+	// A task never joins the scope of whichever task this thread happens to be helping
+	Scope* outer = std::exchange(Scope::current_, nullptr);
+	task->run();
+	Scope::current_ = outer;
+	task->release();
+}
+
+bool Scheduler::run_one() {
+	Task* task = find_work(current_worker_index());
+	if (!task) {
+		return false;
+	}
+	execute(task);
+	return true;
+}
+
+void Scheduler::help_until_done(const Task& task) {
+	int idle_rounds = 0;
+	while (!task.is_done()) {
+		if (run_one()) {
+			idle_rounds = 0;
+			continue;
+		}
+		if (++idle_rounds < SPINS_BEFORE_SLEEP) {
+			std::this_thread::yield();
+			continue;
+		}
+		// Every queue was observed empty, so the task is running elsewhere: block on it
+		task.wait_done();
+	}
+}
+
+void Scheduler::worker_loop(std::size_t index) {
+	current_scheduler = this;
+	current_worker = static_cast<int>(index);
+	steal_seed ^= static_cast<std::uint32_t>(index + 1) * 0x85EBCA6Bu;
+
+	int idle_rounds = 0;
+	while (!stopping_.load(std::memory_order_acquire)) {
+		std::uint64_t observed_epoch = epoch_.load(std::memory_order_seq_cst);
+
+		if (Task* task = find_work(static_cast<int>(index))) {
+			execute(task);
+			idle_rounds = 0;
+			continue;
+		}
+
+		if (++idle_rounds < SPINS_BEFORE_SLEEP) {
+			std::this_thread::yield();
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(sleep_mutex_);
+		sleepers_.fetch_add(1, std::memory_order_seq_cst);
+		sleep_cv_.wait(lock, [&]() {
+			return stopping_.load(std::memory_order_acquire) ||
+			       epoch_.load(std::memory_order_seq_cst) != observed_epoch;
+		});
+		sleepers_.fetch_sub(1, std::memory_order_seq_cst);
+		idle_rounds = 0;
+	}
+
+	current_scheduler = nullptr;
+	current_worker = -1;
+}
+
+// ===== Scope =====
+
+void Scope::wait_all() noexcept {
+	while (Task* task = head_) {
+		head_ = task->scope_next_;
+		task->scope_next_ = nullptr;
+		Scheduler::instance().help_until_done(*task);
+		task->release();
+	}
+}
+
+} // namespace Runtime
+} // namespace ArgonLang
@@ -216,3 +216,28 @@ TEST(ASTTests, CreateComplexNestedExpression) {
 	EXPECT_NE(mulExpr.right, nullptr);
 	EXPECT_EQ(mulExpr.op.type, Token::Multiply);
 }
+
+TEST(ASTTests, NodesAreAllocatedInActiveArena) {
+	Token::Position pos(1, 1);
+	ASTArena arena;
+	{
+		ASTArena::Scope scope(&arena);
+		EXPECT_EQ(ASTArena::active(), &arena);
+		auto first = std::make_unique<IdentifierNode>(pos, "count");
+		auto second = std::make_unique<IdentifierNode>(pos, "count");
+		auto type = std::make_unique<IdentifierTypeNode>(pos, "i32");
+		EXPECT_EQ(&first->identifier.str(), &second->identifier.str());
+		EXPECT_EQ(second->identifier, "count");
+	}
+	EXPECT_EQ(ASTArena::active(), nullptr);
+	EXPECT_EQ(arena.block_count(), 1u);
+	EXPECT_EQ(arena.interned_count(), 2u);
+	EXPECT_GT(arena.bytes_allocated(), 0u);
+}
+
+TEST(ASTTests, PackedPositionSaturates) {
+	static_assert(sizeof(Token::Position) == 4);
+	Token::Position pos(5'000'000, 70'000);
+	EXPECT_EQ(pos.line, Token::Position::MAX_LINE);
+	EXPECT_EQ(pos.column, Token::Position::MAX_COLUMN);
+}
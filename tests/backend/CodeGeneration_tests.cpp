@@ -5,6 +5,16 @@
 #include "Error/Error.h"
 #include "Error/Result.h"
 
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#if !defined(_WIN32)
+#include <sys/wait.h>
+#endif
+
 class CodeGenerationTest : public ::testing::Test {
 protected:
     void SetUp() override {}
@@ -33,6 +43,31 @@ protected:
         
         return codeResult.value();
     }
+
+    // Builds the generated code together with a C++ driver that calls into it, using the compiler command the build
+    // system passes in, and returns the exit status of the program (-1 when it does not build or does not exit)
+    int compileAndRun(const std::string& generated, const std::string& driver) {
+#if defined(ARGON_TEST_COMPILE_COMMAND) && defined(ARGON_TEST_LINK_LIBRARIES)
+        const std::string name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        const std::filesystem::path binary = std::filesystem::temp_directory_path() / ("argon_" + name);
+        const std::string source = binary.string() + ".cpp";
+        std::ofstream(source) << generated << "\n" << driver;
+
+        const std::string command = std::string(ARGON_TEST_COMPILE_COMMAND) + " " + source + " -o " +
+                                    binary.string() + " " + ARGON_TEST_LINK_LIBRARIES;
+        if (std::system(command.c_str()) != 0) {
+            return -1;
+        }
+        int status = std::system(binary.string().c_str());
+#if defined(_WIN32)
+        return status;
+#else
+        return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+#endif
+#else
+        return -1;
+#endif
+    }
 };
 
 // Basic Code Generation Tests
@@ -42,7 +77,8 @@ TEST_F(CodeGenerationTest, GenerateSimpleFunction) {
     
     EXPECT_TRUE(code.find("I32 add(I32 a,I32 b)") != std::string::npos);
     EXPECT_TRUE(code.find("return a + b;") != std::string::npos);
-    EXPECT_TRUE(code.find("ARGON_SCOPE_BEGIN()") != std::string::npos);
+    // No par in the body, so no structured-concurrency scope
+    EXPECT_TRUE(code.find("ARGON_SCOPE_BEGIN()") == std::string::npos);
 }
 
 TEST_F(CodeGenerationTest, GenerateVariableDeclaration) {
@@ -308,3 +344,416 @@ TEST_F(CodeGenerationTest, GenerateComprehensiveProgram) {
     EXPECT_TRUE(code.find("safeDivide(20, 4)") != std::string::npos);
     EXPECT_TRUE(code.find("I32 main()") != std::string::npos);
 }
+
+// Function-typed parameters
+TEST_F(CodeGenerationTest, CalledOnlyFunctionParameterIsBorrowed) {
+    std::string input = "func apply(f: func(i32) i32, x: i32) i32 { return f(x); }";
+    std::string code = generateCode(input);
+
+    EXPECT_TRUE(code.find("ArgonLang::Runtime::FunctionRef<I32(I32)> f") != std::string::npos) << code;
+    EXPECT_TRUE(code.find("std::function") == std::string::npos) << code;
+}
+
+TEST_F(CodeGenerationTest, EscapingFunctionParameterKeepsStdFunction) {
+    std::string input = "func keep(f: func(i32) i32) func(i32) i32 { return f; }";
+    std::string code = generateCode(input);
+
+    EXPECT_TRUE(code.find("std::function<I32(I32)> keep(std::function<I32(I32)> f)") != std::string::npos) << code;
+    EXPECT_TRUE(code.find("FunctionRef") == std::string::npos) << code;
+}
+
+TEST_F(CodeGenerationTest, PrototypedFunctionKeepsStdFunction) {
+    std::string input = R"(
+        func apply(f: func(i32) i32, x: i32) i32;
+        func apply(f: func(i32) i32, x: i32) i32 { return f(x); }
+    )";
+    std::string code = generateCode(input);
+
+    EXPECT_TRUE(code.find("FunctionRef") == std::string::npos) << code;
+}
+
+TEST_F(CodeGenerationTest, StreamedProgramMatchesReturnedCode) {
+    // Enough declarations that the sink flushes to the stream several times
+    std::string input;
+    for (int i = 0; i < 2000; ++i) {
+        std::string n = std::to_string(i);
+        input += "func step" + n + "(a: i32) i32 { def s: i32 = 0; for (i: i32 -> 0 to a) { if (i > " + n +
+                 ") { s = s + i; } else { while (s > 0) { s = s - 1; } } } return s; }\n";
+    }
+    input += "func main() i32 { return step0(1); }\n";
+
+    auto program = parseCode(input);
+    ASSERT_TRUE(program.has_value()) << program.error().message;
+
+    ArgonLang::CodeGenerationVisitor returning;
+    auto code = returning.visit(*program.value());
+    ASSERT_TRUE(code.has_value());
+
+    std::ostringstream stream;
+    ArgonLang::CodeGenerationVisitor streaming;
+    ArgonLang::CodeSink sink(stream);
+    ASSERT_TRUE(streaming.generate(*program.value(), sink).has_value());
+    sink.flush();
+
+    EXPECT_GT(code.value().size(), ArgonLang::CodeSink::FLUSH_SIZE);
+    EXPECT_EQ(sink.bytes_written(), code.value().size());
+    EXPECT_EQ(stream.str(), code.value());
+}
+
+TEST_F(CodeGenerationTest, ParallelGenerationMatchesSequential) {
+    std::string input;
+    for (int i = 0; i < 500; ++i) {
+        std::string n = std::to_string(i);
+        input += "func step" + n + "(a: i32, f: func(i32) i32) i32 { def s: i32 = f(a); def t = par f(" + n +
+                 "); return s; }\n";
+    }
+    input += "func step0(a: i32, f: func(i32) i32) i32;\n";
+    input += "func main() i32 { return step0(1, (x: i32) -> x); }\n";
+
+    auto program = parseCode(input);
+    ASSERT_TRUE(program.has_value()) << program.error().message;
+
+    ArgonLang::CodeGenerationVisitor sequential;
+    ArgonLang::CodeSink sequentialCode;
+    ASSERT_TRUE(sequential.generate(*program.value(), sequentialCode).has_value());
+
+    ArgonLang::CodeGenerationVisitor parallel;
+    ArgonLang::CodeSink parallelCode;
+    ASSERT_TRUE(parallel.generate(*program.value(), parallelCode, true).has_value());
+
+    EXPECT_EQ(parallelCode.take(), sequentialCode.take());
+}
+
+TEST_F(CodeGenerationTest, CachedDeclarationsAreReusedUntilTheirTokensChange) {
+    auto generateWith = [this](const std::string& input, ArgonLang::CodeGenerationCache& cache) {
+        auto program = parseCode(input);
+        EXPECT_TRUE(program.has_value());
+        ArgonLang::CodeGenerationVisitor visitor;
+        visitor.cache = &cache;
+        ArgonLang::CodeSink code;
+        EXPECT_TRUE(visitor.generate(*program.value(), code).has_value());
+        return code.take();
+    };
+
+    std::string input = "func step1(a: i32) i32 { return a + 1; }\n"
+                        "func step2(a: i32) i32 { return a * 2; }\n"
+                        "func main() i32 { return step2(step1(1)); }\n";
+    ArgonLang::CodeGenerationCache first;
+    std::string code = generateWith(input, first);
+    EXPECT_EQ(first.hits(), 0);
+    EXPECT_EQ(first.misses(), 3);
+
+    // Copies of the cache stand in for later compilations; their counters carry on from the first one's.
+    // Whitespace is not part of the token hash
+    std::string reformatted = "func step1(a: i32) i32 {\n    return a + 1;\n}\n"
+                              "func step2(a: i32) i32 { return a * 2; }\n"
+                              "func main() i32 { return step2(step1(1)); }\n";
+    ArgonLang::CodeGenerationCache second = first;
+    EXPECT_EQ(generateWith(reformatted, second), code);
+    EXPECT_EQ(second.hits(), 3);
+
+    std::string edited = "func step1(a: i32) i32 { return a + 3; }\n"
+                         "func step2(a: i32) i32 { return a * 2; }\n"
+                         "func main() i32 { return step2(step1(1)); }\n";
+    ArgonLang::CodeGenerationCache third = first;
+    EXPECT_EQ(generateWith(edited, third), generateCode(edited));
+    EXPECT_EQ(third.hits(), 2);
+    EXPECT_EQ(third.misses() - first.misses(), 1);
+
+    // A prototype changes how the function's own definition is generated
+    std::string prototyped = input + "func step2(a: i32) i32;\n";
+    ArgonLang::CodeGenerationCache fourth = first;
+    EXPECT_EQ(generateWith(prototyped, fourth), generateCode(prototyped));
+    EXPECT_EQ(fourth.misses() - first.misses(), 2);
+}
+
+TEST_F(CodeGenerationTest, TemporariesStayUniquePastTheLastPackedColumn) {
+    // Columns past 4095 all pack to the same position, which must not name two temporaries alike
+    std::string code = generateCode("func main() i32 {" + std::string(4100, ' ') +
+                                    "def [a, b] = [1, 2]; def [c, d] = [3, 4]; return a + d; }");
+
+    EXPECT_NE(code.find("auto __destructure_temp_0 = "), std::string::npos) << code;
+    EXPECT_NE(code.find("auto __destructure_temp_1 = "), std::string::npos) << code;
+    EXPECT_EQ(code.find("4095"), std::string::npos) << code;
+}
+
+TEST_F(CodeGenerationTest, MovedCachedDeclarationKeepsUniqueNames) {
+    auto generateWith = [this](const std::string& input, ArgonLang::CodeGenerationCache& cache) {
+        auto program = parseCode(input);
+        EXPECT_TRUE(program.has_value());
+        ArgonLang::CodeGenerationVisitor visitor;
+        visitor.cache = &cache;
+        ArgonLang::CodeSink code;
+        EXPECT_TRUE(visitor.generate(*program.value(), code).has_value());
+        return code.take();
+    };
+
+    std::string input = "def [a, b] = [1, 2];\n"
+                        "func main() i32 { return 0; }\n";
+    ArgonLang::CodeGenerationCache cache;
+    generateWith(input, cache);
+
+    // The cached destructuring moves down a line and gets a neighbour that declares a temporary too
+    std::string moved = "def [c, d] = [3, 4];\n" + input;
+    std::string code = generateWith(moved, cache);
+    EXPECT_EQ(cache.hits(), 2);
+    EXPECT_EQ(code, generateCode(moved));
+
+    std::size_t first = code.find("auto __destructure_temp_");
+    ASSERT_NE(first, std::string::npos) << code;
+    std::size_t second = code.find("auto __destructure_temp_", first + 1);
+    ASSERT_NE(second, std::string::npos) << code;
+    EXPECT_NE(code.substr(first, code.find('=', first) - first), code.substr(second, code.find('=', second) - second))
+        << code;
+}
+
+TEST_F(CodeGenerationTest, CacheRoundTripsThroughFile) {
+    std::string input = "func step1(a: i32) i32 { return a + 1; }\n"
+                        "func main() i32 { def s: string = \"two\\nlines\"; return step1(1); }\n";
+    auto program = parseCode(input);
+    ASSERT_TRUE(program.has_value()) << program.error().message;
+
+    std::string path = ::testing::TempDir() + "argon_codegen_cache_test";
+    ArgonLang::CodeGenerationCache cache;
+    ArgonLang::CodeGenerationVisitor first;
+    first.cache = &cache;
+    ArgonLang::CodeSink firstCode;
+    ASSERT_TRUE(first.generate(*program.value(), firstCode).has_value());
+    ASSERT_TRUE(cache.save(path));
+
+    ArgonLang::CodeGenerationCache loaded = ArgonLang::CodeGenerationCache::load(path);
+    ArgonLang::CodeGenerationVisitor second;
+    second.cache = &loaded;
+    ArgonLang::CodeSink secondCode;
+    ASSERT_TRUE(second.generate(*program.value(), secondCode, true).has_value());
+    std::remove(path.c_str());
+
+    EXPECT_EQ(loaded.hits(), 2);
+    EXPECT_EQ(loaded.misses(), 0);
+    EXPECT_EQ(secondCode.take(), firstCode.take());
+
+    EXPECT_EQ(ArgonLang::CodeGenerationCache::load(path + ".missing").hits(), 0);
+}
+
+TEST_F(CodeGenerationTest, ConstantMatchLowersToSwitch) {
+    std::string code = generateCode("func f(x: i32) i32 { return x => { 1 -> 10, 0 to 4 -> 20, 3 -> 30, "
+                                    "100 to= 1000 -> 40, n -> 50 }; }");
+
+    EXPECT_NE(code.find("if constexpr (ArgonLang::Runtime::is_switchable_v<decltype(__match_val)>) {"
+                        "switch(__match_val) {"),
+              std::string::npos)
+        << code;
+    EXPECT_NE(code.find("})(x)"), std::string::npos) << code;
+    // 1 belongs to the first arm, and 3 to the range before its own arm, so the switch never reaches that arm
+    EXPECT_NE(code.find("case (I8)1:return (I8)10;case 0:case 2:case 3:return (I8)20;"), std::string::npos) << code;
+    EXPECT_EQ(code.substr(0, code.find("} else {")).find("return (I8)30;"), std::string::npos) << code;
+    // Too wide for case labels, so compared before the catch-all
+    EXPECT_NE(code.find("default: {if(ArgonLang::Runtime::match_constant_range<100, 1000>(__match_val)) "
+                        "{return (I8)40;}auto n = __match_val;return (I8)50;}"),
+              std::string::npos)
+        << code;
+    EXPECT_EQ(code.find("match_value"), std::string::npos) << code;
+}
+
+TEST_F(CodeGenerationTest, EnumMatchLowersToSwitch) {
+    std::string code = generateCode("enum Color { Red, Green, Blue }\n"
+                                    "func f(c: Color) i32 {\n"
+                                    "    return c => { Color::Red -> 1, Color::Blue -> 2, _ -> 3 };\n"
+                                    "}");
+
+    EXPECT_NE(code.find("case Color::Red:return (I8)1;case Color::Blue:return (I8)2;default: {return (I8)3;}"),
+              std::string::npos)
+        << code;
+}
+
+TEST_F(CodeGenerationTest, NonIntegerConstantMatchCompiles) {
+#if !defined(ARGON_TEST_COMPILE_COMMAND) || !defined(ARGON_TEST_LINK_LIBRARIES)
+    GTEST_SKIP() << "The build does not provide a command to compile generated code";
+#endif
+    std::string code = generateCode("func f(x: f64) i32 { return x => { 1 -> 10, 2 to= 5 -> 20, _ -> 0 }; }\n"
+                                    "func g(x: i128) i32 { return x => { 1 -> 10, 100 to= 1000 -> 40, n -> 50 }; }");
+    ASSERT_EQ(code.find("ERROR"), std::string::npos) << code;
+
+    // A switch cannot take either scrutinee, so both arms fall back to the comparisons
+    EXPECT_EQ(compileAndRun(code, "int main() {\n"
+                                  "    return f(2.0) + f(7.5) + g(I128(500)) + g(I128(1)) + g(I128(-3));\n"
+                                  "}\n"),
+              120)
+        << code;
+}
+
+TEST_F(CodeGenerationTest, GuardedMatchKeepsIfChain) {
+    std::string code = generateCode("func f(x: i32) i32 { return x => { 1 -> 10, n && n > 5 -> 20, _ -> 0 }; }");
+
+    EXPECT_EQ(code.find("switch("), std::string::npos) << code;
+    EXPECT_NE(code.find("if(auto n = __match_val; (n > (I8)5))"), std::string::npos) << code;
+}
+
+TEST_F(CodeGenerationTest, RangeMatchComparesAgainstBounds) {
+    std::string code = generateCode("func f(x: i32, top: i32) i32 { return x => { 1 to 10 -> 1, 0 to= top + 1 -> 2, "
+                                    "_ -> 0 }; }\n"
+                                    "func g(s: str) i32 { return s => { \"to=\" -> 1, _ -> 0 }; }");
+
+    // Constant bounds fold into the runtime's single comparison, others are compared inline
+    EXPECT_NE(code.find("if(ArgonLang::Runtime::match_constant_range<1, 9>(__match_val)) {return (I8)1;}"),
+              std::string::npos)
+        << code;
+    EXPECT_NE(code.find("if((__match_val >= (I8)0 && __match_val <= (top + (I8)1))) {return (I8)2;}"),
+              std::string::npos)
+        << code;
+    // A literal spelled with "to=" is a value, not a range
+    EXPECT_NE(code.find("match_value(__match_val, \"to=\")"), std::string::npos) << code;
+    EXPECT_EQ(code.find("match_range("), std::string::npos) << code;
+}
+
+TEST_F(CodeGenerationTest, ArrayMatchTestsEachLengthOnce) {
+    std::string code = generateCode("func f(a: vec<i32>) i32 {\n"
+                                    "    return a => { [] -> 0, [1, b] -> b, [x, y] -> x + y, [7, ...] -> 7, "
+                                    "[x, ...rest] -> x, _ -> -1 };\n"
+                                    "}");
+
+    // One dispatch on the length; the arms of two elements then share one switch on the first
+    EXPECT_NE(code.find("switch(__match_val.size()) {case 0: {{return (I8)0;}} break;case 2: {switch(__match_val[0])"),
+              std::string::npos)
+        << code;
+    EXPECT_EQ(code.find("__match_val.size()", code.find("__match_val.size()") + 1),
+              code.find("__match_val.size() >= 1"))
+        << code;
+    EXPECT_NE(code.find("auto rest = std::vector(__match_val.begin() + 1, __match_val.end());"), std::string::npos)
+        << code;
+    EXPECT_EQ(code.find("match_value"), std::string::npos) << code;
+}
+
+TEST_F(CodeGenerationTest, StructMatchTestsFieldsInPlace) {
+    std::string code = generateCode("class Point { pub x: i32; pub y: i32; }\n"
+                                    "func f(p: Point) i32 {\n"
+                                    "    return p => { {x = 0, y = 0} -> 0, {x = 0, y} -> y, {x, y} && x > y -> 1, "
+                                    "q -> 2 };\n"
+                                    "}");
+
+    EXPECT_NE(code.find("switch(__match_val.x) {case (I8)0:{switch(__match_val.y) {case (I8)0:{{return (I8)0;}} "
+                        "break;default: {{auto y = __match_val.y;return y;}}}} break;"),
+              std::string::npos)
+        << code;
+    // A failed guard falls through to the next arm
+    EXPECT_NE(code.find("if((x > y)) {return (I8)1;}}{auto q = __match_val;return (I8)2;}"), std::string::npos)
+        << code;
+}
+
+TEST_F(CodeGenerationTest, PayloadEnumIsTaggedUnion) {
+    std::string code = generateCode("enum Shape { Circle{ radius: f64 }, Rectangle{ width: f64, height: f64 }, "
+                                    "Empty }");
+
+    EXPECT_NE(code.find("enum class Tag : uint8_t { Circle, Rectangle, Empty };"), std::string::npos) << code;
+    EXPECT_NE(code.find("static Shape Rectangle(F64 width, F64 height) { return Shape(RectangleFields{"
+                        "std::move(width), std::move(height)}); }"),
+              std::string::npos)
+        << code;
+    EXPECT_NE(code.find("union Payload {"), std::string::npos) << code;
+    EXPECT_NE(code.find("case Tag::Rectangle: return std::forward<Visitor>(visitor)(payload.Rectangle);"),
+              std::string::npos)
+        << code;
+    EXPECT_NE(code.find("inline const Shape Shape::Empty = Shape(Shape::EmptyFields{});"), std::string::npos) << code;
+    EXPECT_EQ(code.find("std::variant"), std::string::npos) << code;
+}
+
+TEST_F(CodeGenerationTest, PayloadEnumMatchSwitchesOnTag) {
+    std::string code = generateCode("enum Shape { Circle{ radius: f64 }, Rectangle{ width: f64, height: f64 }, "
+                                    "Empty }\n"
+                                    "func area(s: Shape) f64 {\n"
+                                    "    return s => { Shape::Circle{ r } -> r * r, Shape::Rectangle{ w, h } -> w * h, "
+                                    "_ -> 0.0 };\n"
+                                    "}");
+
+    // One switch on the tag; the fields of a variant are read in place
+    EXPECT_NE(code.find("switch(__match_val.tag()) {case Shape::Tag::Circle: {{auto r = __match_val.as_Circle().radius;"
+                        "return (r * r);}} break;case Shape::Tag::Rectangle: {{auto w = "
+                        "__match_val.as_Rectangle().width;auto h = __match_val.as_Rectangle().height;"),
+              std::string::npos)
+        << code;
+    EXPECT_NE(code.find("default: {{return 0.0;}}"), std::string::npos) << code;
+    EXPECT_EQ(code.find("match_value"), std::string::npos) << code;
+}
+
+TEST_F(CodeGenerationTest, RefAllocatesValueWithCounts) {
+    std::string code = generateCode("func main() i32 {\n"
+                                    "    def shared: ref<i64> = ref(0);\n"
+                                    "    def observer: weak<i64> = shared;\n"
+                                    "    return 0;\n"
+                                    "}");
+
+    EXPECT_NE(code.find("ArgonLang::Runtime::Ref<I64> shared = ArgonLang::Runtime::make_ref<I64>((I8)0);"),
+              std::string::npos)
+        << code;
+    EXPECT_NE(code.find("ArgonLang::Runtime::Weak<I64> observer = shared;"), std::string::npos) << code;
+    EXPECT_EQ(code.find("shared_ptr"), std::string::npos) << code;
+}
+
+TEST_F(CodeGenerationTest, RefsNeverCopiedKeepLocalCounts) {
+    std::string code = generateCode("func bump(r: ref<i32>) i32 { return 1; }\n"
+                                    "func main() i32 {\n"
+                                    "    def counter: ref<i32> = ref(0);\n"
+                                    "    def passed: ref<i32> = ref(1);\n"
+                                    "    def captured = ref(2);\n"
+                                    "    def holder: ref<i32> = ref(3);\n"
+                                    "    def f = (x: i32) -> x + bump(captured) + *holder;\n"
+                                    "    def later: ref<i32> = ref(4);\n"
+                                    "    holder = later;\n"
+                                    "    par bump(passed);\n"
+                                    "    return *counter + f(1);\n"
+                                    "}");
+
+    // Only counter is named nowhere but through *; every other ref is copied, so its counts stay atomic
+    EXPECT_NE(code.find("counter = ArgonLang::Runtime::make_local_ref<I32>((I8)0);"), std::string::npos) << code;
+    EXPECT_NE(code.find("passed = ArgonLang::Runtime::make_ref<I32>((I8)1);"), std::string::npos) << code;
+    EXPECT_NE(code.find("captured = ArgonLang::Runtime::make_ref((I8)2);"), std::string::npos) << code;
+    EXPECT_NE(code.find("holder = ArgonLang::Runtime::make_ref<I32>((I8)3);"), std::string::npos) << code;
+    EXPECT_NE(code.find("later = ArgonLang::Runtime::make_ref<I32>((I8)4);"), std::string::npos) << code;
+    EXPECT_EQ(code.find("share("), std::string::npos) << code;
+}
+
+TEST_F(CodeGenerationTest, UntypedPipelineBindingsAreMaterialized) {
+    std::string code = generateCode("func evens(v: vec<i32>) {\n"
+                                    "    return v | (x: i32) -> x % 2 == 0;\n"
+                                    "}\n"
+                                    "func count(v: vec<i32>) i32 {\n"
+                                    "    def lazy = v | (x: i32) -> x > 3;\n"
+                                    "    def typed: vec<i32> = v | (x: i32) -> x > 3;\n"
+                                    "    return lazy.size() + typed.size();\n"
+                                    "}");
+
+    // A pipeline only refers to its source, so it becomes a vector before it outlives the expression
+    EXPECT_NE(code.find("auto evens(std::vector<I32> v){return (ArgonLang::Runtime::lazy_filter("), std::string::npos)
+        << code;
+    EXPECT_NE(code.find("== (I8)0);})).to_vector();}"), std::string::npos) << code;
+    EXPECT_NE(code.find("auto lazy = (ArgonLang::Runtime::lazy_filter("), std::string::npos) << code;
+    EXPECT_NE(code.find("std::vector<I32> typed = ArgonLang::Runtime::lazy_filter("), std::string::npos) << code;
+}
+
+TEST_F(CodeGenerationTest, EscapingPipelinesRunCorrectly) {
+#if !defined(ARGON_TEST_COMPILE_COMMAND) || !defined(ARGON_TEST_LINK_LIBRARIES)
+    GTEST_SKIP() << "The build does not provide a command to compile generated code";
+#endif
+    std::string code = generateCode("func evens(v: vec<i32>) {\n"
+                                    "    return v | (x: i32) -> x % 2 == 0;\n"
+                                    "}\n"
+                                    "func large(v: vec<i32>) i32 {\n"
+                                    "    def r = v | (x: i32) -> x > 3;\n"
+                                    "    v[0] = 100;\n"
+                                    "    return r.size() + r[0];\n"
+                                    "}\n"
+                                    "func doubled(v: vec<i32>) i32 {\n"
+                                    "    def d = (v | (x: i32) -> x > 4) ||> (x: i32) -> x * 2;\n"
+                                    "    return d[0];\n"
+                                    "}");
+    ASSERT_EQ(code.find("ERROR"), std::string::npos) << code;
+
+    // 2 + 4 + 6 from the returned pipeline, 3 + 4 from the binding taken before the write, 5 * 2 from the map
+    EXPECT_EQ(compileAndRun(code, "int main() {\n"
+                                  "    int total = 0;\n"
+                                  "    for (I32 x : evens({1, 2, 3, 4, 5, 6})) total += x;\n"
+                                  "    return total + large({1, 2, 3, 4, 5, 6}) + doubled({1, 2, 3, 4, 5, 6});\n"
+                                  "}\n"),
+              29)
+        << code;
+}
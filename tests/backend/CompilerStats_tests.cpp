@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+#include "Stats/CompilerStats.h"
+#include "backend/Parser.h"
+#include "backend/Tokenizer.h"
+
+#include <sstream>
+
+TEST(CompilerStatsTests, TrackerCountsNodesByType) {
+	ArgonLang::ASTNodeTracker tracker;
+	tracker.install();
+
+	auto tokenizeResult = ArgonLang::tokenize("def x = a + b;");
+	ASSERT_FALSE(tokenizeResult.has_error());
+	ArgonLang::Parser parser(tokenizeResult.tokens);
+	auto result = parser.parse();
+	ASSERT_TRUE(result.has_value()) << result.error().message;
+
+	auto counts = tracker.count_by_type();
+	EXPECT_EQ(counts[ArgonLang::ASTNodeType::Program], 1);
+	EXPECT_EQ(counts[ArgonLang::ASTNodeType::VariableDeclaration], 1);
+	EXPECT_EQ(counts[ArgonLang::ASTNodeType::BinaryExpression], 1);
+	EXPECT_EQ(counts[ArgonLang::ASTNodeType::Identifier], 2);
+	EXPECT_GE(tracker.created(), 5u);
+
+	result.value().reset();
+	EXPECT_TRUE(tracker.count_by_type().empty());
+	tracker.uninstall();
+	EXPECT_EQ(ArgonLang::ASTNodeTracker::active(), nullptr);
+}
+
+TEST(CompilerStatsTests, RecordsPassesAndReportsJson) {
+	ArgonLang::CompilerStats stats;
+	int value = stats.time("phase", [] { return 42; });
+	EXPECT_EQ(value, 42);
+	stats.time("allocating", [] {
+		// Called directly so the allocation cannot be elided like a new-expression
+		::operator delete(::operator new(64));
+	});
+	stats.set_token_count(7);
+	stats.set_ast_nodes(3, {{ArgonLang::ASTNodeType::Identifier, 2}});
+
+	ASSERT_EQ(stats.get_passes().size(), 2u);
+	EXPECT_EQ(stats.get_passes()[0].name, "phase");
+	EXPECT_GE(stats.get_passes()[1].allocations, 1u);
+
+	std::ostringstream json;
+	stats.print_json(json);
+	EXPECT_NE(json.str().find("\"name\": \"phase\""), std::string::npos);
+	EXPECT_NE(json.str().find("\"tokens\": 7"), std::string::npos);
+	EXPECT_NE(json.str().find("\"Identifier\": 2"), std::string::npos);
+}
@@ -144,6 +144,14 @@ TEST_F(ExpressionsTest, GenerateLambdaWithBlock) {
     EXPECT_FALSE(code.find("ERROR") != std::string::npos);
 }
 
+TEST_F(ExpressionsTest, GenerateLambdaWithFunctionParameter) {
+    std::string input = "func main() i32 { def apply = (f: func(i32) i32, x: i32) -> f((x)); return 0; }";
+    std::string code = generateCode(input);
+
+    EXPECT_FALSE(code.find("ERROR") != std::string::npos);
+    EXPECT_TRUE(code.find("apply") != std::string::npos);
+}
+
 TEST_F(ExpressionsTest, GenerateLambdaCapture) {
     std::string input = R"(
         func main() i32 {
@@ -273,6 +281,13 @@ TEST_F(ExpressionsTest, GenerateNestedStructLiteral) {
     EXPECT_FALSE(code.find("ERROR") != std::string::npos);
 }
 
+TEST_F(ExpressionsTest, StructLiteralRejectsLambdaAsTypeName) {
+    auto result = parseCode("func main() void { def point = struct x -> y { x = 1 }; }");
+
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error().message, "Expected a type name after struct");
+}
+
 // Increment/Decrement Tests
 TEST_F(ExpressionsTest, GeneratePreIncrement) {
     std::string input = "func main() i32 { def x: i32 = 5; return ++x; }";
@@ -349,6 +364,32 @@ TEST_F(ExpressionsTest, GenerateMixedExpressionWithAllOperators) {
     EXPECT_FALSE(code.find("ERROR") != std::string::npos);
 }
 
+TEST_F(ExpressionsTest, GenerateOperatorPrecedence) {
+    std::string input = R"(
+        func main() i32 {
+            def a: i32 = 1;
+            def b: i32 = 2;
+            def c: i32 = 3;
+            def x: i32 = a + b * c - a % b;
+            def y: bool = a < b || b < c && a == c;
+            def z: i32 = a > b ?? a - b : b - a;
+            return x;
+        }
+    )";
+    std::string code = generateCode(input);
+
+    EXPECT_TRUE(code.find("((a + (b * c)) - (a % b))") != std::string::npos);
+    EXPECT_TRUE(code.find("((a < b) || ((b < c) && (a == c)))") != std::string::npos);
+    EXPECT_TRUE(code.find("(a > b) ? (a - b) : (b - a)") != std::string::npos);
+}
+
+TEST_F(ExpressionsTest, ParseErrorSecondMatchOnMatchExpression) {
+    std::string input = "func main() i32 { def x = 1 => { _ -> 2 } => { _ -> 3 }; return x; }";
+    auto result = parseCode(input);
+
+    EXPECT_FALSE(result.has_value());
+}
+
 // Bitwise Operations Tests
 TEST_F(ExpressionsTest, GenerateBitwiseAnd) {
     std::string input = "func main() i32 { return 15 *& 7; }";
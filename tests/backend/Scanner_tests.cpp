@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+#include "backend/Scanner.h"
+#include "backend/Tokenizer.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace ArgonLang;
+
+namespace {
+std::vector<Scanner::InstructionSet> supported_instruction_sets() {
+	std::vector<Scanner::InstructionSet> sets;
+	for (auto set : {Scanner::InstructionSet::Scalar, Scanner::InstructionSet::SSE2, Scanner::InstructionSet::AVX2}) {
+		if (static_cast<int>(set) <= static_cast<int>(Scanner::best_instruction_set())) {
+			sets.push_back(set);
+		}
+	}
+	return sets;
+}
+
+// Random text over an alphabet that hits every class boundary the kernels test for
+std::string random_text(std::mt19937& random, std::size_t length) {
+	static const std::string alphabet = "azAZ09_ \t\"'\\*\n/@`{[\x80\xff";
+	std::string text(length, ' ');
+	for (char& c : text) {
+		c = alphabet[random() % alphabet.size()];
+	}
+	return text;
+}
+
+class ScannerTest : public ::testing::Test {
+protected:
+	void TearDown() override { Scanner::set_instruction_set(Scanner::best_instruction_set()); }
+};
+} // namespace
+
+TEST_F(ScannerTest, KernelsAgreeWithReference) {
+	std::mt19937 random(10);
+	for (auto set : supported_instruction_sets()) {
+		Scanner::set_instruction_set(set);
+		ASSERT_EQ(Scanner::active_instruction_set(), set);
+		for (int round = 0; round < 500; ++round) {
+			// Long runs of one class so that matches land in every lane and in the scalar tail
+			std::string text = random_text(random, random() % 100);
+			std::size_t from = text.empty() ? 0 : random() % text.size();
+			std::size_t run = random() % 70;
+			char fill = "a \t"[round % 3];
+			text.insert(from, run, fill);
+
+			std::size_t identifierEnd = from;
+			while (identifierEnd < text.size() && (std::isalnum(static_cast<unsigned char>(text[identifierEnd])) ||
+			                                       text[identifierEnd] == '_')) {
+				identifierEnd++;
+			}
+			EXPECT_EQ(Scanner::find_identifier_end(text, from), identifierEnd);
+
+			std::size_t blankEnd = from;
+			std::size_t expectedTabs = 0;
+			while (blankEnd < text.size() && (text[blankEnd] == ' ' || text[blankEnd] == '\t')) {
+				expectedTabs += text[blankEnd++] == '\t';
+			}
+			std::size_t tabs = 0;
+			EXPECT_EQ(Scanner::skip_blanks(text, from, tabs), blankEnd);
+			EXPECT_EQ(tabs, expectedTabs);
+
+			std::size_t special = text.find_first_of("\"\\", from);
+			EXPECT_EQ(Scanner::find_either(text, from, '"', '\\'), special == std::string::npos ? text.size() : special);
+		}
+	}
+}
+
+TEST_F(ScannerTest, StopsAtTheEndOfTheView) {
+	// The byte after the view must never be looked at, as it may lie past the end of a mapping
+	std::string text(100, 'a');
+	text[64] = '"';
+	for (auto set : supported_instruction_sets()) {
+		Scanner::set_instruction_set(set);
+		std::string_view view(text.data(), 64);
+		EXPECT_EQ(Scanner::find_identifier_end(view, 0), 64u);
+		EXPECT_EQ(Scanner::find_either(view, 3, '"', '"'), 64u);
+	}
+}
+
+TEST_F(ScannerTest, TokensMatchAcrossInstructionSets) {
+	std::string source = "func f(a: i32) i32 {\n\t\t// comment \"text\"\n    /* block\n comment */ "
+	                     "def very_long_identifier_name_that_spans_several_vectors = \"a string literal that is "
+	                     "longer than thirty-two bytes\";\n\tdef e = \"esc\\\"aped\\n and a long tail after it\";\n"
+	                     "\treturn a;\n}\n";
+	std::vector<Token> reference;
+	for (auto set : supported_instruction_sets()) {
+		Scanner::set_instruction_set(set);
+		auto result = tokenize(source);
+		ASSERT_FALSE(result.has_error()) << result.error_msg;
+		if (reference.empty()) {
+			reference = result.tokens;
+			continue;
+		}
+		ASSERT_EQ(result.tokens.size(), reference.size());
+		for (std::size_t i = 0; i < reference.size(); ++i) {
+			EXPECT_EQ(result.tokens[i].type, reference[i].type);
+			EXPECT_EQ(result.tokens[i].value, reference[i].value);
+			EXPECT_EQ(result.tokens[i].position.line, reference[i].position.line);
+			EXPECT_EQ(result.tokens[i].position.column, reference[i].position.column);
+		}
+	}
+}
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include "backend/Parser.h"
+#include "backend/TokenStream.h"
+#include "backend/Tokenizer.h"
+
+#include <string>
+
+namespace {
+std::string repeated_functions(int count) {
+	std::string source;
+	for (int i = 0; i < count; ++i) {
+		std::string name = "function_" + std::to_string(i);
+		source += "func " + name + "(a: i32, b: i32) i32 {\n\tdef c = (x) -> x + a;\n\tdef s = \"esc\\\"aped\";\n"
+		          "\tif (a < b) { return c(b); }\n\treturn a + b;\n}\n";
+	}
+	return source + "func main() {\n\tdef x = function_0(1, 2);\n}\n";
+}
+} // namespace
+
+TEST(TokenStreamTests, YieldsTheTokensOfTokenize) {
+	std::string source = repeated_functions(20);
+	auto tokenizeResult = ArgonLang::tokenize(source);
+	ASSERT_FALSE(tokenizeResult.has_error());
+
+	ArgonLang::TokenStream stream(source);
+	for (size_t i = 0; i < tokenizeResult.tokens.size(); ++i) {
+		ASSERT_TRUE(stream.has(i));
+		const ArgonLang::Token& token = stream.at(i);
+		EXPECT_EQ(token.type, tokenizeResult.tokens[i].type);
+		EXPECT_EQ(token.value, tokenizeResult.tokens[i].value);
+		EXPECT_EQ(token.position.line, tokenizeResult.tokens[i].position.line);
+		EXPECT_EQ(token.position.column, tokenizeResult.tokens[i].position.column);
+	}
+	EXPECT_FALSE(stream.has(tokenizeResult.tokens.size()));
+	EXPECT_EQ(stream.at(tokenizeResult.tokens.size() + 5).type, ArgonLang::Token::End);
+	EXPECT_EQ(stream.get_token_count(), tokenizeResult.tokens.size());
+}
+
+TEST(TokenStreamTests, ParserKeepsOnlyItsLookahead) {
+	std::string source = repeated_functions(500);
+	ArgonLang::TokenStream stream(source);
+	ArgonLang::Parser parser(stream);
+	auto program = parser.parse();
+	ASSERT_TRUE(program.has_value()) << program.error().message;
+	EXPECT_FALSE(stream.has_error());
+	EXPECT_EQ(program.value()->nodes.size(), 501u);
+
+	// Each function is released once parsed, so the window stays around one function plus a batch
+	EXPECT_GT(stream.get_token_count(), 20000u);
+	EXPECT_LT(stream.get_peak_window(), 200u);
+}
+
+TEST(TokenStreamTests, TokenizerErrorEndsTheStream) {
+	ArgonLang::TokenStream stream("func main() {\n\tdef x = 1 @ 2;\n}\n");
+	ArgonLang::Parser parser(stream);
+	auto program = parser.parse();
+	EXPECT_FALSE(program.has_value());
+	ASSERT_TRUE(stream.has_error());
+	EXPECT_EQ(stream.get_error_position().line, 2u);
+}
+
+TEST(TokenStreamTests, MatchesParentheses) {
+	std::string source = "func main() {\n\tdef f = (x: func(i32) i32, y: i32) -> x((y));\n\tdef g = (1 + (2\n}\n";
+	auto tokenizeResult = ArgonLang::tokenize(source);
+	ASSERT_FALSE(tokenizeResult.has_error());
+	const std::vector<ArgonLang::Token>& tokens = tokenizeResult.tokens;
+
+	// Expected pairs by a plain depth count from each '('
+	std::vector<size_t> expected(tokens.size(), 0);
+	for (size_t open = 0; open < tokens.size(); ++open) {
+		if (tokens[open].type != ArgonLang::Token::LeftParen) {
+			continue;
+		}
+		size_t depth = 0;
+		size_t close = open;
+		for (; tokens[close].type != ArgonLang::Token::End; ++close) {
+			depth += tokens[close].type == ArgonLang::Token::LeftParen;
+			depth -= tokens[close].type == ArgonLang::Token::RightParen;
+			if (depth == 0) {
+				break;
+			}
+		}
+		expected[open] = close;
+	}
+
+	ArgonLang::TokenStream streamed(source);
+	ArgonLang::TokenStream viewed(tokens);
+	for (size_t open = 0; open < tokens.size(); ++open) {
+		if (tokens[open].type == ArgonLang::Token::LeftParen) {
+			EXPECT_EQ(streamed.matching_paren(open), expected[open]) << "at " << open;
+			EXPECT_EQ(viewed.matching_paren(open), expected[open]) << "at " << open;
+		}
+	}
+	EXPECT_THROW(viewed.matching_paren(0), std::logic_error);
+}
@@ -1,6 +1,10 @@
 #include <gtest/gtest.h>
+#include "backend/SourceBuffer.h"
 #include "backend/Tokenizer.h"
 
+#include <cstdio>
+#include <fstream>
+
 // Basic Keyword Tests
 TEST(TokenizerTests, KeywordTokenization) {
 	std::string input = "def x: i32;";
@@ -235,3 +239,71 @@ TEST(TokenizerTests, UnterminatedString) {
 
 	EXPECT_TRUE(tokenizeResult.has_error());
 }
+
+// Zero-copy tokens
+TEST(TokenizerTests, TokensViewIntoInput) {
+	std::string input = R"(def name = "plain" + "esc\tape" + 1`000;)";
+	auto tokenizeResult = ArgonLang::tokenize(input);
+
+	ASSERT_FALSE(tokenizeResult.has_error());
+	auto& tokens = tokenizeResult.tokens;
+	auto inInput = [&](std::string_view value) {
+		return value.data() >= input.data() && value.data() + value.size() <= input.data() + input.size();
+	};
+
+	EXPECT_EQ(tokens[1].value, "name");
+	EXPECT_TRUE(inInput(tokens[1].value));
+	EXPECT_EQ(tokens[3].value, "plain");
+	EXPECT_TRUE(inInput(tokens[3].value));
+
+	// Escapes and digit separators are rewritten into storage owned by the result
+	EXPECT_EQ(tokens[5].value, "esc\tape");
+	EXPECT_FALSE(inInput(tokens[5].value));
+	EXPECT_EQ(tokens[7].value, "1000");
+	EXPECT_FALSE(inInput(tokens[7].value));
+	EXPECT_EQ(tokenizeResult.owned_values.size(), 2);
+}
+
+TEST(TokenizerTests, DoesNotReadPastEndOfInput) {
+	// Only "x =" is visible; the '=' after it must not turn the last token into '=='
+	std::string input = "x ==";
+	auto tokenizeResult = ArgonLang::tokenize(std::string_view(input).substr(0, 3));
+
+	ASSERT_FALSE(tokenizeResult.has_error());
+	ASSERT_EQ(tokenizeResult.tokens.size(), 3);
+	EXPECT_EQ(tokenizeResult.tokens[1].type, ArgonLang::Token::Assign);
+}
+
+TEST(TokenizerTests, SourceBufferMapsFiles) {
+	std::string filename = ::testing::TempDir() + "source_buffer_test.arg";
+	{
+		std::ofstream file(filename, std::ios::binary);
+		file << "func main() {}";
+	}
+
+	auto source = ArgonLang::SourceBuffer::open(filename);
+	ASSERT_TRUE(source.has_value()) << source.error().message;
+	EXPECT_EQ(source.value().view(), "func main() {}");
+
+	auto tokenizeResult = ArgonLang::tokenize(source.value().view());
+	ASSERT_FALSE(tokenizeResult.has_error());
+	EXPECT_EQ(tokenizeResult.tokens[1].value, "main");
+	std::remove(filename.c_str());
+
+	auto missing = ArgonLang::SourceBuffer::open(filename);
+	ASSERT_FALSE(missing.has_value());
+	EXPECT_EQ(missing.error().type, ArgonLang::ErrorType::SourceNotReadable);
+}
+
+TEST(TokenizerTests, RecognisesKeywordsOnly) {
+	EXPECT_EQ(ArgonLang::keyword_type("while"), ArgonLang::Token::KeywordWhile);
+	EXPECT_EQ(ArgonLang::keyword_type("dowhile"), ArgonLang::Token::KeywordWhile);
+	EXPECT_EQ(ArgonLang::keyword_type("constructor"), ArgonLang::Token::KeywordConstructor);
+	EXPECT_EQ(ArgonLang::keyword_type("u128"), ArgonLang::Token::PrimitiveType);
+	EXPECT_EQ(ArgonLang::keyword_type("chr"), ArgonLang::Token::PrimitiveType);
+	EXPECT_EQ(ArgonLang::keyword_type("false"), ArgonLang::Token::BooleanLiteral);
+
+	for (std::string_view identifier : {"whil", "whiles", "i9", "u256", "Def", "_", "constructors", "x"}) {
+		EXPECT_EQ(ArgonLang::keyword_type(identifier), ArgonLang::Token::Identifier) << identifier;
+	}
+}
@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+#include "runtime/ArgonRuntime.h"
+
+#include <string>
+
+using namespace ArgonLang::Runtime;
+
+namespace {
+int twice(int x) {
+	return 2 * x;
+}
+
+int apply(FunctionRef<int(int)> f, int x) {
+	return f(x);
+}
+} // namespace
+
+TEST(FunctionRefTests, CallsLambdas) {
+	int offset = 10;
+	EXPECT_EQ(apply([&](int x) { return x + offset; }, 5), 15);
+}
+
+TEST(FunctionRefTests, CallsFunctionsAndFunctionPointers) {
+	EXPECT_EQ(apply(twice, 4), 8);
+
+	int (*pointer)(int) = &twice;
+	FunctionRef<int(int)> ref = pointer;
+	pointer = nullptr;
+	EXPECT_EQ(ref(21), 42);
+}
+
+TEST(FunctionRefTests, ReferencesMutableState) {
+	int calls = 0;
+	auto counter = [&calls](int x) mutable {
+		++calls;
+		return x;
+	};
+	FunctionRef<int(int)> ref = counter;
+	ref(1);
+	ref(2);
+	EXPECT_EQ(calls, 2);
+}
+
+TEST(FunctionRefTests, ConvertsReturnType) {
+	FunctionRef<std::string(const char*)> ref = [](const char* text) { return text; };
+	EXPECT_EQ(ref("argon"), "argon");
+}
+
+TEST(FunctionRefTests, WorksWithFunctionalOperators) {
+	std::vector<int> values{1, 2, 3, 4};
+	auto is_odd = [](int x) { return x % 2 == 1; };
+	FunctionRef<bool(int)> predicate = is_odd;
+
+	EXPECT_EQ(filter(values, predicate), (std::vector<int>{1, 3}));
+	EXPECT_EQ(map(values, [](int x) { return x * 10; }), (std::vector<int>{10, 20, 30, 40}));
+	EXPECT_EQ(reduce(values, [](int a, int b) { return a + b; }), 10);
+	EXPECT_EQ(map_pipe(values, twice), (std::vector<int>{2, 4, 6, 8}));
+}
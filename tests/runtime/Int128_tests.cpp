@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include "runtime/ArgonRuntime.h"
+
+#include <random>
+#include <stdexcept>
+#include <string>
+
+using namespace ArgonLang::Runtime;
+
+namespace {
+const std::string U128_MAX = "340282366920938463463374607431768211455";
+const std::string I128_MAX = "170141183460469231731687303715884105727";
+const std::string I128_MIN = "-170141183460469231731687303715884105728";
+} // namespace
+
+TEST(Int128Tests, ConstructsFromBuiltinIntegers) {
+	EXPECT_EQ(U128(1ULL).to_string(), "1");
+	EXPECT_EQ(U128(42u).to_string(), "42");
+	EXPECT_EQ(I128(-5).to_string(), "-5");
+	EXPECT_EQ(I128(static_cast<I64>(-1)).high_word(), -1);
+	EXPECT_EQ(U128(~U64{0}, ~U64{0}).to_string(), U128_MAX);
+}
+
+TEST(Int128Tests, ArithmeticCarriesAcrossWords) {
+	U128 low_max(0, ~U64{0});
+	EXPECT_EQ(low_max + U128(1u), U128(1, 0));
+	EXPECT_EQ(U128(1, 0) - U128(1u), low_max);
+	EXPECT_EQ(low_max * low_max, U128(~U64{0} - 1, 1));
+	EXPECT_EQ(U128(0u) - U128(1u), U128(~U64{0}, ~U64{0}));
+
+	EXPECT_EQ(I128(-3) * I128(7), I128(-21));
+	EXPECT_EQ(I128(I128_MAX) + I128(1), I128(I128_MIN));
+	EXPECT_EQ(-I128(I128_MIN), I128(I128_MIN));
+}
+
+TEST(Int128Tests, DivisionTruncatesTowardZero) {
+	EXPECT_EQ(I128(-7) / I128(2), I128(-3));
+	EXPECT_EQ(I128(-7) % I128(2), I128(-1));
+	EXPECT_EQ(I128(7) % I128(-2), I128(1));
+	EXPECT_EQ(I128(I128_MIN) / I128(-1), I128(I128_MIN));
+	EXPECT_EQ(I128(I128_MIN) % I128(-1), I128(0));
+
+	U128 big(U128_MAX);
+	EXPECT_EQ(big / U128(1, 0), U128(~U64{0}));
+	EXPECT_EQ(big % U128(1, 0), U128(~U64{0}));
+	EXPECT_EQ(big / big, U128(1u));
+
+	EXPECT_THROW(U128(1u) / U128(0u), std::runtime_error);
+	EXPECT_THROW(I128(1) % I128(0), std::runtime_error);
+}
+
+TEST(Int128Tests, DivisionMatchesMultiplication) {
+	std::mt19937_64 random(128);
+	for (int i = 0; i < 1000; ++i) {
+		U128 dividend(random(), random());
+		U128 divisor(i % 2 ? random() >> (i % 64) : 0, random() | 1);
+		U128 quotient = dividend / divisor;
+		U128 remainder = dividend % divisor;
+		EXPECT_LT(remainder, divisor);
+		EXPECT_EQ(quotient * divisor + remainder, dividend);
+	}
+}
+
+TEST(Int128Tests, ShiftsHandleWordBoundaries) {
+	EXPECT_EQ(U128(1u) << 64, U128(1, 0));
+	EXPECT_EQ(U128(1, 0) >> 1, U128(0, U64{1} << 63));
+	EXPECT_EQ(U128(1u) << 128, U128(0u));
+	EXPECT_EQ(I128(-8) >> 2, I128(-2));
+	EXPECT_EQ(I128(-1) >> 200, I128(-1));
+}
+
+TEST(Int128Tests, StringRoundTrips) {
+	for (const std::string& text : {std::string("0"), std::string("9999999999999999999"),
+	                                std::string("10000000000000000000"), std::string("100000000000000000000000000000000000000"),
+	                                U128_MAX}) {
+		EXPECT_EQ(U128(text).to_string(), text);
+	}
+	for (const std::string& text : {std::string("-1"), std::string("-10000000000000000000"), I128_MAX, I128_MIN}) {
+		EXPECT_EQ(I128(text).to_string(), text);
+	}
+	EXPECT_EQ(U128("1_000_000").to_string(), "1000000");
+}
+
+TEST(Int128Tests, InvariantDivisorMatchesDivision) {
+	std::mt19937_64 random(64);
+	for (U64 value : {U64{1}, U64{3}, U64{10}, U64{10000000000000000000ULL}, ~U64{0}}) {
+		U64Divisor divisor(value);
+		EXPECT_EQ(divisor.divisor(), value);
+		for (int i = 0; i < 200; ++i) {
+			U128 dividend(random(), random());
+			U64 remainder;
+			U128 quotient = divisor.divide(dividend, remainder);
+			EXPECT_EQ(quotient, dividend / U128(value));
+			EXPECT_EQ(U128(remainder), dividend % U128(value));
+		}
+	}
+	EXPECT_THROW(U64Divisor(0), std::runtime_error);
+}
@@ -0,0 +1,40 @@
+#include <gtest/gtest.h>
+#include "runtime/ArgonRuntime.h"
+
+using namespace ArgonLang::Runtime;
+
+TEST(MatchTests, ConstantRangeIncludesBothBounds) {
+	EXPECT_FALSE((match_constant_range<1, 9>(0)));
+	EXPECT_TRUE((match_constant_range<1, 9>(1)));
+	EXPECT_TRUE((match_constant_range<1, 9>(9)));
+	EXPECT_FALSE((match_constant_range<1, 9>(10)));
+	EXPECT_FALSE((match_constant_range<1, 9>(-1)));
+	static_assert(match_constant_range<'a', 'z'>('q'));
+}
+
+TEST(MatchTests, ConstantRangeWrapsAcrossSignAndWidth) {
+	EXPECT_TRUE((match_constant_range<-5, 5>(static_cast<I8>(-5))));
+	EXPECT_TRUE((match_constant_range<-5, 5>(static_cast<I16>(0))));
+	EXPECT_FALSE((match_constant_range<-5, 5>(static_cast<I64>(-6))));
+	EXPECT_FALSE((match_constant_range<-5, 5>(std::numeric_limits<I32>::min())));
+	EXPECT_TRUE((match_constant_range<200, 255>(static_cast<U8>(250))));
+	EXPECT_FALSE((match_constant_range<0, 100>(std::numeric_limits<U64>::max())));
+	EXPECT_TRUE((match_constant_range<std::numeric_limits<I64>::min(), -1>(std::numeric_limits<I64>::min())));
+}
+
+TEST(MatchTests, ConstantRangeComparesFloatingPointValues) {
+	EXPECT_TRUE((match_constant_range<0, 1>(0.5)));
+	EXPECT_FALSE((match_constant_range<0, 1>(1.5f)));
+}
+
+TEST(MatchTests, ConstantRangeKeepsAll128Bits) {
+	EXPECT_FALSE((match_constant_range<1, 10>(I128(1, 3))));
+	EXPECT_TRUE((match_constant_range<1, 10>(I128(0, 3))));
+	EXPECT_FALSE((match_constant_range<1, 10>(U128(1, 3))));
+#if defined(__SIZEOF_INT128__)
+	// __int128 is an integral type in the GNU modes, which take the subtraction path
+	EXPECT_FALSE((match_constant_range<1, 10>((static_cast<__int128>(1) << 64) + 3)));
+	EXPECT_TRUE((match_constant_range<-10, 10>(static_cast<__int128>(-3))));
+	EXPECT_FALSE((match_constant_range<0, 5>(static_cast<unsigned __int128>(1) << 100)));
+#endif
+}
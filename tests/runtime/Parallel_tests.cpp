@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include "runtime/ArgonRuntime.h"
+
+#include <list>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace ArgonLang::Runtime;
+
+namespace {
+std::vector<long long> iota_vector(std::size_t count) {
+	std::vector<long long> values(count);
+	std::iota(values.begin(), values.end(), 0);
+	return values;
+}
+} // namespace
+
+TEST(ParallelTests, FilterPreservesOrder) {
+	auto values = iota_vector(200000);
+	auto evens = filter(ExecutionPolicy::Parallel, values, [](long long x) { return x % 2 == 0; });
+
+	ASSERT_EQ(evens.size(), values.size() / 2);
+	for (std::size_t i = 0; i < evens.size(); ++i) {
+		ASSERT_EQ(evens[i], static_cast<long long>(2 * i));
+	}
+}
+
+TEST(ParallelTests, FilterMovesFromTemporaries) {
+	std::vector<std::string> words(5000, "argon");
+	words[4999] = "last";
+	auto kept = filter(ExecutionPolicy::Parallel, std::move(words), [](const std::string& w) { return !w.empty(); });
+
+	ASSERT_EQ(kept.size(), 5000u);
+	EXPECT_EQ(kept.front(), "argon");
+	EXPECT_EQ(kept.back(), "last");
+}
+
+TEST(ParallelTests, MapMatchesSequential) {
+	auto values = iota_vector(100000);
+	auto square = [](long long x) { return x * x; };
+
+	EXPECT_EQ(map(ExecutionPolicy::Parallel, values, square), map(ExecutionPolicy::Sequential, values, square));
+}
+
+TEST(ParallelTests, ReduceMatchesSequential) {
+	auto values = iota_vector(1000003);
+	auto sum = [](long long a, long long b) { return a + b; };
+
+	long long expected = 1000003LL * 1000002LL / 2;
+	EXPECT_EQ(reduce(ExecutionPolicy::Parallel, values, sum), expected);
+	EXPECT_EQ(reduce(ExecutionPolicy::Sequential, values, sum), expected);
+	EXPECT_EQ(reduce(ExecutionPolicy::Parallel, values, 0LL, sum, sum), expected);
+}
+
+TEST(ParallelTests, ReduceFoldsInOrderWithoutCombine) {
+	// Not associative: the accumulator and the element play different parts
+	std::vector<long> values(100000, 3);
+	auto squares = [](long accumulator, long x) { return accumulator + x * x; };
+
+	long expected = 100000L * 9;
+	EXPECT_EQ(reduce(ExecutionPolicy::Sequential, values, squares), expected);
+	EXPECT_EQ(reduce(ExecutionPolicy::Parallel, values, squares), expected);
+	EXPECT_EQ(reduce(ExecutionPolicy::Auto, values, squares), expected);
+	auto plus = [](long a, long b) { return a + b; };
+	EXPECT_EQ(reduce(ExecutionPolicy::Parallel, values, 0L, squares, plus), expected);
+}
+
+TEST(ParallelTests, ReduceKeepsOperandOrder) {
+	// String concatenation is associative but not commutative
+	std::vector<std::string> letters;
+	std::string expected;
+	for (int i = 0; i < 10000; ++i) {
+		letters.push_back(std::string(1, static_cast<char>('a' + i % 26)));
+		expected += letters.back();
+	}
+
+	auto concat = [](std::string a, const std::string& b) { return a + b; };
+	EXPECT_EQ(reduce(ExecutionPolicy::Parallel, letters, std::string(), concat, concat), expected);
+}
+
+TEST(ParallelTests, MapPipeTransformsInPlace) {
+	auto values = iota_vector(50000);
+	auto& result = map_pipe(ExecutionPolicy::Parallel, values, [](long long x) { return x + 1; });
+
+	EXPECT_EQ(&result, &values);
+	EXPECT_EQ(values.front(), 1);
+	EXPECT_EQ(values.back(), 50000);
+}
+
+TEST(ParallelTests, AutoUsesThreshold) {
+	std::size_t previous = parallel_threshold();
+	set_parallel_threshold(10);
+	EXPECT_EQ(parallel_threshold(), 10u);
+
+	auto values = iota_vector(5000);
+	auto doubled = map(ExecutionPolicy::Auto, values, [](long long x) { return 2 * x; });
+	EXPECT_EQ(doubled[4999], 9998);
+
+	set_parallel_threshold(previous);
+}
+
+TEST(ParallelTests, NonRandomAccessFallsBackToSequential) {
+	std::list<int> values{1, 2, 3, 4, 5, 6};
+	auto odd = filter(ExecutionPolicy::Parallel, values, [](int x) { return x % 2 == 1; });
+
+	EXPECT_EQ(odd, (std::list<int>{1, 3, 5}));
+}
+
+TEST(ParallelTests, ExceptionsPropagateAfterAllChunks) {
+	auto values = iota_vector(100000);
+	auto throwing = [](long long x) -> long long {
+		if (x == 77777) {
+			throw std::runtime_error("bad element");
+		}
+		return x;
+	};
+
+	EXPECT_THROW(map(ExecutionPolicy::Parallel, values, throwing), std::runtime_error);
+}
+
+TEST(ParallelTests, NestedInsidePar) {
+	auto values = iota_vector(100000);
+	auto future = par([&]() {
+		auto sum = [](long long a, long long b) { return a + b; };
+		return reduce(ExecutionPolicy::Parallel, values, 0LL, sum, sum);
+	});
+
+	EXPECT_EQ(future.get(), 100000LL * 99999LL / 2);
+}
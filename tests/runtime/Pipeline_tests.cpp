@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include "runtime/ArgonRuntime.h"
+
+#include <numeric>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace ArgonLang::Runtime;
+
+namespace {
+auto is_even = [](int x) { return x % 2 == 0; };
+auto square = [](int x) { return x * x; };
+} // namespace
+
+TEST(PipelineTests, StagesAreLazy) {
+	std::vector<int> values{1, 2, 3, 4};
+	int calls = 0;
+	auto counted = lazy_map(ExecutionPolicy::Sequential, values, [&](int x) {
+		++calls;
+		return x;
+	});
+
+	EXPECT_EQ(calls, 0);
+	std::vector<int> result = counted;
+	EXPECT_EQ(calls, 4);
+	EXPECT_EQ(result, values);
+}
+
+TEST(PipelineTests, FusesFilterAndMapChains) {
+	auto source = std::ranges::iota_view(1, 1000);
+	auto processed = lazy_filter(ExecutionPolicy::Sequential,
+	                             lazy_map(ExecutionPolicy::Sequential,
+	                                      lazy_filter(ExecutionPolicy::Sequential, source,
+	                                                  [](int x) { return x % 3 == 0; }),
+	                                      square),
+	                             [](int x) { return x > 100; });
+
+	std::vector<int> expected;
+	for (int x = 1; x < 1000; ++x) {
+		if (x % 3 == 0 && x * x > 100) {
+			expected.push_back(x * x);
+		}
+	}
+
+	EXPECT_EQ(processed.to_vector(), expected);
+	EXPECT_EQ(processed[5], expected[5]);
+}
+
+TEST(PipelineTests, IndexingStopsEarly) {
+	std::vector<int> values(1000);
+	std::iota(values.begin(), values.end(), 0);
+	int calls = 0;
+	auto doubled = lazy_map(ExecutionPolicy::Sequential, values, [&](int x) {
+		++calls;
+		return 2 * x;
+	});
+
+	EXPECT_EQ(doubled[3], 6);
+	EXPECT_EQ(calls, 4);
+	EXPECT_THROW(doubled[1000], std::out_of_range);
+}
+
+TEST(PipelineTests, TakeMaterialisesPrefix) {
+	auto evens = lazy_filter(ExecutionPolicy::Sequential, std::ranges::iota_view(0, 1000000), is_even);
+
+	EXPECT_EQ(evens.take(3), (std::vector<int>{0, 2, 4}));
+	EXPECT_TRUE(evens.take(0).empty());
+}
+
+TEST(PipelineTests, ReduceFoldsWithoutMaterialising) {
+	std::vector<int> values(10000);
+	std::iota(values.begin(), values.end(), 1);
+	auto evens = lazy_filter(ExecutionPolicy::Sequential, values, is_even);
+	auto sum = [](long long a, long long b) { return a + b; };
+
+	int sequential = reduce(ExecutionPolicy::Sequential, evens, [](int a, int b) { return a + b; });
+	EXPECT_EQ(sequential, 5000 * 5001);
+
+	auto widened = lazy_map(ExecutionPolicy::Sequential, evens, [](int x) { return static_cast<long long>(x); });
+	EXPECT_EQ(reduce(ExecutionPolicy::Parallel, widened, sum), 5000LL * 5001LL);
+	EXPECT_EQ(reduce(ExecutionPolicy::Parallel, widened, 0LL, sum, sum), 5000LL * 5001LL);
+}
+
+TEST(PipelineTests, ReduceFoldsInOrderWithoutCombine) {
+	std::vector<long> values(100000, 1);
+	auto doubled = [](long accumulator, long x) { return accumulator + x * 2; };
+	auto same = lazy_map(ExecutionPolicy::Auto, values, [](long x) { return x; });
+
+	EXPECT_EQ(reduce(ExecutionPolicy::Auto, same, doubled), 200000L);
+	EXPECT_EQ(reduce(ExecutionPolicy::Parallel, same, doubled), reduce(ExecutionPolicy::Sequential, same, doubled));
+}
+
+TEST(PipelineTests, ParallelMaterialisationPreservesOrder) {
+	std::vector<int> values(300000);
+	std::iota(values.begin(), values.end(), 0);
+	auto pipeline = lazy_map(ExecutionPolicy::Parallel, lazy_filter(ExecutionPolicy::Parallel, values, is_even),
+	                         [](int x) { return x / 2; });
+
+	std::vector<int> result = pipeline;
+	ASSERT_EQ(result.size(), 150000u);
+	for (std::size_t i = 0; i < result.size(); ++i) {
+		ASSERT_EQ(result[i], static_cast<int>(i));
+	}
+}
+
+TEST(PipelineTests, ParallelReduceHandlesEmptyChunks) {
+	std::vector<int> values(100000, 1);
+	values[99999] = 7;
+	auto sevens = lazy_filter(ExecutionPolicy::Parallel, values, [](int x) { return x == 7; });
+
+	auto sum = [](int a, int b) { return a + b; };
+	EXPECT_EQ(reduce(ExecutionPolicy::Parallel, sevens, 0, sum, sum), 7);
+}
+
+TEST(PipelineTests, IteratesInRangeFor) {
+	std::vector<std::string> words{"a", "bb", "ccc", "dddd"};
+	auto lengths = lazy_map(ExecutionPolicy::Sequential,
+	                        lazy_filter(ExecutionPolicy::Sequential, words,
+	                                    [](const std::string& w) { return w.size() != 2; }),
+	                        [](const std::string& w) { return w.size(); });
+
+	std::vector<std::size_t> seen;
+	for (auto length : lengths) {
+		seen.push_back(length);
+	}
+	EXPECT_EQ(seen, (std::vector<std::size_t>{1, 3, 4}));
+}
+
+TEST(PipelineTests, OwnsTemporarySources) {
+	auto make = []() { return lazy_map(ExecutionPolicy::Sequential, std::vector<int>{1, 2, 3}, square); };
+	auto squares = make();
+
+	EXPECT_EQ(squares.to_vector(), (std::vector<int>{1, 4, 9}));
+}
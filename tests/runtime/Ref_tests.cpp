@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include "runtime/ArgonRuntime.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ArgonLang::Runtime;
+
+namespace {
+struct Counted {
+	int* destroyed;
+	int value;
+
+	Counted(int* destroyed, int value) : destroyed(destroyed), value(value) {}
+	~Counted() { ++*destroyed; }
+};
+} // namespace
+
+TEST(RefTests, IsOnePointerWide) {
+	static_assert(sizeof(Ref<std::string>) == sizeof(void*));
+	static_assert(sizeof(Weak<std::string>) == sizeof(void*));
+	Ref<int> empty;
+	EXPECT_FALSE(empty);
+	EXPECT_EQ(empty.use_count(), 0u);
+}
+
+TEST(RefTests, DestroysValueWithLastReference) {
+	int destroyed = 0;
+	{
+		Ref<Counted> first = make_ref<Counted>(&destroyed, 7);
+		{
+			Ref<Counted> second = first;
+			EXPECT_EQ(first.use_count(), 2u);
+			EXPECT_EQ(second->value, 7);
+			EXPECT_TRUE(first == second);
+		}
+		EXPECT_EQ(first.use_count(), 1u);
+		Ref<Counted> moved = std::move(first);
+		EXPECT_FALSE(first);
+		EXPECT_EQ(moved.use_count(), 1u);
+		EXPECT_EQ(destroyed, 0);
+	}
+	EXPECT_EQ(destroyed, 1);
+}
+
+TEST(RefTests, WeakOutlivesValue) {
+	int destroyed = 0;
+	Weak<Counted> weak;
+	{
+		Ref<Counted> ref = make_ref<Counted>(&destroyed, 3);
+		weak = ref;
+		EXPECT_FALSE(weak.expired());
+		EXPECT_EQ(weak.lock()->value, 3);
+		EXPECT_EQ(ref.use_count(), 1u);
+	}
+	EXPECT_EQ(destroyed, 1);
+	EXPECT_TRUE(weak.expired());
+	EXPECT_FALSE(weak.lock());
+}
+
+TEST(RefTests, MakeRefDeducesTypeOfSingleArgument) {
+	auto number = make_ref(41);
+	static_assert(std::is_same_v<decltype(number), Ref<int>>);
+	*number += 1;
+	EXPECT_EQ(*number, 42);
+	EXPECT_EQ(make_ref<std::string>(3, 'x')->size(), 3u);
+}
+
+TEST(RefTests, LocalCountsAreAskedFor) {
+	int destroyed = 0;
+	{
+		Ref<Counted> local = make_local_ref<Counted>(&destroyed, 5);
+		EXPECT_TRUE(local.is_local());
+		EXPECT_FALSE(make_ref(1).is_local());
+		Weak<Counted> weak = local;
+		Ref<Counted> copy = weak.lock();
+		EXPECT_EQ(local.use_count(), 2u);
+		EXPECT_EQ(copy->value, 5);
+		static_assert(std::is_same_v<decltype(make_local_ref(1)), Ref<int>>);
+	}
+	EXPECT_EQ(destroyed, 1);
+}
+
+TEST(RefTests, CountsSurviveConcurrentCopies) {
+	int destroyed = 0;
+	Ref<Counted> ref = make_ref<Counted>(&destroyed, 0);
+	Weak<Counted> weak = ref;
+	std::vector<std::thread> threads;
+	for (int thread = 0; thread < 4; ++thread) {
+		threads.emplace_back([&] {
+			for (int i = 0; i < 10000; ++i) {
+				Ref<Counted> copy = ref;
+				Ref<Counted> locked = weak.lock();
+			}
+		});
+	}
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+	EXPECT_EQ(ref.use_count(), 1u);
+	ref = Ref<Counted>();
+	EXPECT_EQ(destroyed, 1);
+	EXPECT_TRUE(weak.expired());
+}
+
+TEST(RefTests, RefsHeldInsideRefsCountAtomically) {
+	// Nothing names the inner ref where the threads are started, which must not make its counts plain
+	Ref<std::vector<Ref<int>>> outer = make_ref<std::vector<Ref<int>>>(1, make_ref(7));
+	std::vector<std::thread> threads;
+	for (int thread = 0; thread < 4; ++thread) {
+		threads.emplace_back([outer] {
+			for (int i = 0; i < 10000; ++i) {
+				Ref<int> copy = (*outer)[0];
+			}
+		});
+	}
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+	EXPECT_EQ((*outer)[0].use_count(), 1u);
+	EXPECT_EQ(outer.use_count(), 1u);
+}
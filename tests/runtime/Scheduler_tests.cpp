@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+#include "runtime/ArgonRuntime.h"
+
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+using namespace ArgonLang::Runtime;
+
+TEST(SchedulerTests, DequePushPopIsLifo) {
+	struct NoopTask : Task {
+		void execute() noexcept override {}
+	};
+
+	WorkStealingDeque deque(2);
+	std::vector<Task*> tasks;
+	for (int i = 0; i < 10; ++i) {
+		tasks.push_back(new NoopTask());
+		deque.push(tasks.back());
+	}
+
+	// Growth past the initial capacity keeps every task
+	for (int i = 9; i >= 0; --i) {
+		EXPECT_EQ(deque.pop(), tasks[i]);
+	}
+	EXPECT_EQ(deque.pop(), nullptr);
+	EXPECT_TRUE(deque.empty());
+
+	for (Task* task : tasks) {
+		task->release();
+	}
+}
+
+TEST(SchedulerTests, DequeStealIsFifo) {
+	struct NoopTask : Task {
+		void execute() noexcept override {}
+	};
+
+	WorkStealingDeque deque;
+	Task* first = new NoopTask();
+	Task* second = new NoopTask();
+	deque.push(first);
+	deque.push(second);
+
+	EXPECT_EQ(deque.steal(), first);
+	EXPECT_EQ(deque.pop(), second);
+	EXPECT_EQ(deque.steal(), nullptr);
+
+	first->release();
+	second->release();
+}
+
+TEST(SchedulerTests, ParReturnsValue) {
+	auto future = par([]() { return 42; });
+	EXPECT_EQ(await(std::move(future)), 42);
+}
+
+TEST(SchedulerTests, ParSupportsVoidTasks) {
+	std::atomic<int> counter{0};
+	auto future = par([&]() { counter.fetch_add(1); });
+	future.get();
+	EXPECT_EQ(counter.load(), 1);
+}
+
+TEST(SchedulerTests, ParPropagatesExceptions) {
+	auto future = par([]() -> int { throw std::runtime_error("boom"); });
+	EXPECT_THROW(future.get(), std::runtime_error);
+}
+
+TEST(SchedulerTests, ManySmallTasks) {
+	constexpr int count = 10000;
+	std::vector<ArgonFuture<int>> futures;
+	futures.reserve(count);
+	for (int i = 0; i < count; ++i) {
+		futures.push_back(par([i]() { return i; }));
+	}
+
+	long long sum = 0;
+	for (auto& future : futures) {
+		sum += future.get();
+	}
+	EXPECT_EQ(sum, static_cast<long long>(count) * (count - 1) / 2);
+}
+
+TEST(SchedulerTests, NestedAwaitInsideTasks) {
+	// Recursive fork/join; awaiting inside a worker must help rather than deadlock
+	struct Fib {
+		static int run(int n) {
+			if (n < 2) {
+				return n;
+			}
+			auto left = par([n]() { return run(n - 1); });
+			int right = run(n - 2);
+			return left.get() + right;
+		}
+	};
+
+	EXPECT_EQ(Fib::run(20), 6765);
+}
+
+TEST(SchedulerTests, ScopeWaitsForPendingTasks) {
+	std::atomic<int> completed{0};
+	{
+		ARGON_SCOPE_BEGIN();
+		for (int i = 0; i < 100; ++i) {
+			par([&]() { completed.fetch_add(1); });
+		}
+	}
+	EXPECT_EQ(completed.load(), 100);
+}
+
+TEST(SchedulerTests, NestedScopesWaitIndependently) {
+	std::atomic<int> inner_done{0};
+	std::atomic<int> outer_done{0};
+	{
+		ARGON_SCOPE_BEGIN();
+		par([&]() { outer_done.fetch_add(1); });
+		{
+			Scope inner;
+			EXPECT_EQ(Scope::current(), &inner);
+			for (int i = 0; i < 10; ++i) {
+				par([&]() { inner_done.fetch_add(1); });
+			}
+		}
+		EXPECT_EQ(inner_done.load(), 10);
+	}
+	EXPECT_EQ(outer_done.load(), 1);
+	EXPECT_EQ(Scope::current(), nullptr);
+}
+
+TEST(SchedulerTests, TasksDoNotJoinHelperScope) {
+	// A task run while its submitter helps must not attach its own pars to the helper's scope
+	std::atomic<int> completed{0};
+	{
+		ARGON_SCOPE_BEGIN();
+		auto future = par([&]() {
+			EXPECT_EQ(Scope::current(), nullptr);
+			completed.fetch_add(1);
+			return 0;
+		});
+		future.get();
+	}
+	EXPECT_EQ(completed.load(), 1);
+}